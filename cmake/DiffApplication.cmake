@@ -0,0 +1,181 @@
+#
+# Topology driven selection of component libraries.
+#
+# diff_component_library(<target> COMPONENTS <type>=<header> ...)
+#
+#   Declare component types provided by the library <target>, each with the header defining it (as included by the generated source). Component
+#   libraries shall not register factories of their components (with FactoryRegisterer or DIFF_REGISTER_FACTORY) - registration is generated for
+#   each application, for the components it uses only.
+#
+# diff_add_application(<target> TOPOLOGY <file.json> MODULES <library>... [SOURCES <source>...])
+#
+#   Add executable <target> built of the given sources. Parse the topology at configure time and link only the component libraries (MODULES,
+#   declared with diff_component_library) providing component types used by the topology. Generate the source registering factories of just those
+#   component types (with DIFF_REGISTER_FACTORY). Files included by the topology are parsed as well. The project is reconfigured whenever any of
+#   the topology files changes.
+#
+# diff_add_inspect(<target> TOPOLOGY <file.json> MODULES <library>...)
+#
+#   Add diff-inspect executable <target> (@see diff/Inspect.h) with the factories of the component types used by the given topology, as selected by
+#   diff_add_application. Run as <target> <topology.json>... [--budget <bytes>] to report the estimated memory footprint of a topology - for
+#   instance in a test gating the footprint of a product topology.
+#
+
+function(diff_component_library target)
+    cmake_parse_arguments(PARSE_ARGV 1 ARG "" "" "COMPONENTS")
+
+    if(NOT TARGET ${target})
+        message(FATAL_ERROR "diff_component_library: ${target} is not a target.")
+    endif()
+
+    foreach(component IN LISTS ARG_COMPONENTS)
+        if(NOT component MATCHES "^([^=]+)=(.+)$")
+            message(FATAL_ERROR "diff_component_library: ${target} - Component \"${component}\" shall be of form <type>=<header>.")
+        endif()
+        set_property(TARGET ${target} APPEND PROPERTY DIFF_COMPONENT_TYPES "${CMAKE_MATCH_1}")
+        set_property(TARGET ${target} APPEND PROPERTY DIFF_COMPONENT_HEADERS "${CMAKE_MATCH_2}")
+    endforeach()
+endfunction()
+
+function(diff_topology_types topology out)
+    # Files on the current include path are in DIFF_TOPOLOGY_INCLUDES - inherited from the including call, if any.
+    if(topology IN_LIST DIFF_TOPOLOGY_INCLUDES)
+        message(FATAL_ERROR "diff_add_application: ${topology} - Topology file shall not include itself, directly or indirectly.")
+    endif()
+    list(APPEND DIFF_TOPOLOGY_INCLUDES ${topology})
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${topology})
+    get_filename_component(directory ${topology} DIRECTORY)
+
+    file(READ ${topology} json)
+
+    string(JSON type ERROR_VARIABLE error TYPE "${json}")
+    if(error OR NOT type STREQUAL "ARRAY")
+        message(FATAL_ERROR "diff_add_application: ${topology} - Topology json shall be an array.")
+    endif()
+
+    set(types "")
+    string(JSON length LENGTH "${json}")
+    if(length GREATER 0)
+        math(EXPR last "${length} - 1")
+        foreach(index RANGE ${last})
+            # Variables and instances of templates add no types of their own, templates add types of their components.
+            string(JSON variables ERROR_VARIABLE error GET "${json}" ${index} variables)
+            if(NOT error)
+                continue()
+            endif()
+            string(JSON instance ERROR_VARIABLE error GET "${json}" ${index} instantiate)
+            if(NOT error)
+                continue()
+            endif()
+            # Included files add types of their components, overlays add the type they override the original one with (if any).
+            string(JSON include ERROR_VARIABLE error GET "${json}" ${index} include)
+            if(NOT error)
+                get_filename_component(include ${include} ABSOLUTE BASE_DIR ${directory})
+                diff_topology_types(${include} includeTypes)
+                list(APPEND types ${includeTypes})
+                continue()
+            endif()
+            string(JSON overlay ERROR_VARIABLE error GET "${json}" ${index} overlay)
+            if(NOT error)
+                string(JSON componentType ERROR_VARIABLE error GET "${json}" ${index} type)
+                if(NOT error)
+                    list(APPEND types "${componentType}")
+                endif()
+                continue()
+            endif()
+            string(JSON templateLength ERROR_VARIABLE error LENGTH "${json}" ${index} components)
+            if(NOT error)
+                if(templateLength GREATER 0)
+                    math(EXPR templateLast "${templateLength} - 1")
+                    foreach(templateIndex RANGE ${templateLast})
+                        string(JSON componentType ERROR_VARIABLE error GET "${json}" ${index} components ${templateIndex} type)
+                        if(error)
+                            message(FATAL_ERROR "diff_add_application: ${topology} - Component{#${index}} - Component type shall be specified.")
+                        endif()
+                        list(APPEND types "${componentType}")
+                    endforeach()
+                endif()
+                continue()
+            endif()
+
+            string(JSON componentType ERROR_VARIABLE error GET "${json}" ${index} type)
+            if(error)
+                message(FATAL_ERROR "diff_add_application: ${topology} - Component{#${index}} - Component type shall be specified.")
+            endif()
+            list(APPEND types "${componentType}")
+        endforeach()
+    endif()
+    list(REMOVE_DUPLICATES types)
+
+    set(${out} "${types}" PARENT_SCOPE)
+endfunction()
+
+function(diff_add_application target)
+    cmake_parse_arguments(PARSE_ARGV 1 ARG "" "TOPOLOGY" "MODULES;SOURCES")
+
+    if(NOT ARG_TOPOLOGY)
+        message(FATAL_ERROR "diff_add_application: ${target} - TOPOLOGY shall be specified.")
+    endif()
+    get_filename_component(topology ${ARG_TOPOLOGY} ABSOLUTE)
+
+    diff_topology_types(${topology} types)
+
+    set(headers "")
+    set(registered "")
+    set(libraries "")
+    set(unresolved ${types})
+    foreach(module IN LISTS ARG_MODULES)
+        get_target_property(moduleTypes ${module} DIFF_COMPONENT_TYPES)
+        get_target_property(moduleHeaders ${module} DIFF_COMPONENT_HEADERS)
+        if(NOT moduleTypes)
+            message(FATAL_ERROR "diff_add_application: ${target} - Module ${module} declares no components (see diff_component_library).")
+        endif()
+
+        foreach(type header IN ZIP_LISTS moduleTypes moduleHeaders)
+            if(type IN_LIST unresolved)
+                list(REMOVE_ITEM unresolved ${type})
+                list(APPEND registered ${type})
+                list(APPEND headers ${header})
+                list(APPEND libraries ${module})
+            endif()
+        endforeach()
+    endforeach()
+
+    if(unresolved)
+        list(JOIN unresolved ", " unresolved)
+        message(FATAL_ERROR "diff_add_application: ${target} - Component types not provided by any module: ${unresolved}.")
+    endif()
+
+    list(REMOVE_DUPLICATES headers)
+    list(REMOVE_DUPLICATES libraries)
+
+    set(content "// Generated by diff_add_application from ${topology} - do not edit.\n\n#include <diff/FactoryDescriptor.h>\n")
+    foreach(header IN LISTS headers)
+        string(APPEND content "#include <${header}>\n")
+    endforeach()
+    string(APPEND content "\n")
+    foreach(type IN LISTS registered)
+        string(APPEND content "DIFF_REGISTER_FACTORY(${type});\n")
+    endforeach()
+
+    set(source ${CMAKE_CURRENT_BINARY_DIR}/${target}_factories.cpp)
+    file(CONFIGURE OUTPUT ${source} CONTENT "${content}" @ONLY)
+
+    add_executable(${target} ${ARG_SOURCES} ${source})
+    target_link_libraries(${target} PRIVATE diff::diff ${libraries})
+endfunction()
+
+function(diff_add_inspect target)
+    cmake_parse_arguments(PARSE_ARGV 1 ARG "" "TOPOLOGY" "MODULES")
+
+    set(content "// Generated by diff_add_inspect - do not edit.\n\n#include <diff/Inspect.h>\n\n")
+    string(APPEND content "int main(int argc, char **argv) {\n    return diff::Inspect::main(argc, argv);\n}\n")
+
+    set(source ${CMAKE_CURRENT_BINARY_DIR}/${target}_main.cpp)
+    file(CONFIGURE OUTPUT ${source} CONTENT "${content}" @ONLY)
+
+    diff_add_application(${target} TOPOLOGY ${ARG_TOPOLOGY} MODULES ${ARG_MODULES} SOURCES ${source})
+    if(TARGET nlohmann_json::nlohmann_json)
+        target_link_libraries(${target} PRIVATE nlohmann_json::nlohmann_json)
+    endif()
+endfunction()
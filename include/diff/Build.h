@@ -9,37 +9,219 @@
  * @copyright Copyright (c) 2025 Slawomir Niespodziany
  */
 
+#include <diff/DependencyIdTable.h>
+#include <diff/Error.h>
+#include <diff/Exception.h>
 #include <diff/Factory.h>
 #include <diff/FactoryRegistry.h>
+#include <diff/Instances.h>
+#include <diff/ScopeTopology.h>
+#include <diff/StaticMemory.h>
 #include <diff/Topology.h>
+#include <diff/TopologyValidator.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
 #include <iostream>
-#include <stack>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace diff {
 
+class Module;
+
+/**
+ * @brief Shared ownership of loaded component modules (@see ModuleLoader).
+ */
+using Modules = std::vector<std::shared_ptr<const Module>>;
+
+/**
+ * @brief Duration of the warm-up of a component instance (@see Build::warmup).
+ */
+struct WarmupTiming {
+    std::reference_wrapper<const std::string> type;
+    std::reference_wrapper<const std::string> id;
+    std::chrono::nanoseconds duration;
+};
+
+/**
+ * @brief Usage of the memory resource of a component instance (@see MemoryResource, Build::memory).
+ */
+struct MemoryUsage {
+    std::reference_wrapper<const std::string> type;
+    std::reference_wrapper<const std::string> id;
+    std::size_t used;
+    std::size_t peak;
+    std::size_t limit;
+    std::size_t violations;
+};
+
 /**
  * @brief Build object instantiates and owns a set of components as defined by the injected Topology object. Its constructor instantiates components
- * and performs dependency injection. The resulting dependencies are available for external use.
+ * and performs dependency injection. The resulting dependencies are available for external use. In static memory mode, the construction, reset and
+ * warm-up allocate from StaticMemory (@see StaticMemory).
  */
 class Build final {
 public:
     /**
-     * @brief Construct a Build object. Instantiate components as defined by the Topology object.
+     * @brief Construct a Build object. Instantiate components as defined by the Topology object. Consecutive entries of the same component type are
+     * constructed together and stored contiguously (@see Factory::buildMany). Dependency ids are assigned slots first (@see DependencyIdTable), so
+     * dependencies are injected without string lookups. Ids and configs are moved out of the Topology object.
      * @exception FactoryNotFound If factory of a requested component type is not registered within FactoryRegistry.
      *
      * @param topology Topology object defining components to be instantiated.
+     * @param modules Modules providing component types of the topology (@see ModuleLoader). Kept loaded until all the components are destructed.
      */
-    Build(Topology& topology) {
-        for (TopologyEntry& topologyEntry : topology) {
-            Factory<>& factory = FactoryRegistry::getInstance().get(topologyEntry.type);
-            std::unique_ptr<Component<>> pComponent = factory.build(topologyEntry.id,              //
-                                                                    topologyEntry.dependencyIds,   //
-                                                                    topologyEntry.config,          //
-                                                                    dependencyRegistry_);
-            componentStack_.stack.emplace(std::move(pComponent));
+    Build(Topology& topology, Modules modules = {}) : Build{topology, std::move(modules), Scope{}} {}
+
+    /**
+     * @brief Construct a scoped Build object. Instantiate components as defined by the ScopeTopology object. Dependencies which are not provided by
+     * the scope itsself are resolved from the parent Build (and its ancestors), so shared components are not instantiated again. The parent Build is
+     * never modified and shall outlive the scoped one.
+     *
+     * @param parent Parent Build object.
+     * @param scopeTopology Pre-compiled topology of the scope. It is not modified, so it can be used to construct any number of scopes.
+     */
+    Build(const Build& parent, const ScopeTopology& scopeTopology) : Build{parent, scopeTopology, Scope{}} {}
+
+    Build(const Build&) = delete;
+    Build(Build&&) = delete;
+    ~Build() = default;
+
+    /**
+     * @brief Construct a Build object (@see Build). Report failure with the returned object instead of raising an error. Factories of all the
+     * component types are looked up before any component is instantiated, so unavailable component types are reported without side effects.
+     * Failures of the instantiation itself (e.g. unresolved dependency, invalid config) are reported as well. In exception-free mode they can not be
+     * caught, so the topology is type checked up front instead and the first failure found is reported (@see TopologyValidator) - failures beyond
+     * the reach of type checking are still raised to the ErrorHandler. In static memory mode the topology is checked against the static capacities
+     * up front as well (@see StaticCapacity), and built in StaticMemory.
+     *
+     * @param topology Topology object defining components to be instantiated.
+     * @param modules Modules providing component types of the topology (@see ModuleLoader).
+     * @return Build object or failure description.
+     */
+    static Result<std::unique_ptr<Build>> create(Topology& topology, Modules modules = {}) {
+        const FactoryRegistry& factoryRegistry = FactoryRegistry::getInstance();
+        for (const TopologyEntry& topologyEntry : topology) {
+            if (!factoryRegistry.has(topologyEntry.type)) {
+                return Error{ErrorCode::FACTORY_NOT_FOUND, topologyEntry.type};
+            }
         }
+
+#if defined(DIFF_NO_EXCEPTIONS)
+        const std::vector<Error> errors = TopologyValidator::validate(topology);
+        if (!errors.empty()) {
+            return errors.front();
+        }
+#endif
+
+#if defined(DIFF_STATIC_MEMORY)
+        const Result<> capacity = StaticCapacity{}.check(topology);
+        if (!capacity) {
+            return capacity.error();
+        }
+        const Scope scope{};   // Build object itsself allocated from StaticMemory as well.
+#endif
+
+#if defined(DIFF_NO_EXCEPTIONS)
+        return std::make_unique<Build>(topology, std::move(modules));
+#else
+        try {
+            return std::make_unique<Build>(topology, std::move(modules));
+        } catch (const Exception& e) {
+            return e.error();
+        }
+#endif
+    }
+
+    Build& operator=(const Build&) = delete;
+    Build& operator=(Build&&) = delete;
+
+    /**
+     * @brief Restore the initial state of all the component instances declared as resettable (in order of construction). Other component instances
+     * are left intact.
+     */
+    void reset() {
+        const Scope scope{};
+        for (const std::unique_ptr<Instances<>>& pInstances : componentStack_.stack) {
+            for (std::size_t i = 0u; i < pInstances->size(); ++i) {
+                (*pInstances)[i].resetComponent();
+            }
+        }
+    }
+
+    /**
+     * @brief Warm up all the component instances declared as warmable (@see warmable), e.g. before the application starts serving real-time traffic.
+     * Instances are warmed up in levels of the dependency graph - an instance after all the instances it depends on, while the independent ones in
+     * parallel. Dependencies on ids other than component ids (e.g. side dependencies) are assumed to be on any of the preceding instances.
+     * @exception Exception thrown by a warm-up function, once the warm-up of its level is complete. Further levels are not warmed up.
+     *
+     * @param threads Maximum number of threads warming up instances of a level in parallel, in addition to the calling one.
+     * @return Warm-up durations of the warmable instances, in order of construction.
+     */
+    std::vector<WarmupTiming> warmup(std::size_t threads = std::thread::hardware_concurrency()) {
+        const Scope scope{};
+        std::vector<Component<>*> instances;
+        instances.reserve(warmupLevels_.size());
+        for (const std::unique_ptr<Instances<>>& pInstances : componentStack_.stack) {
+            for (std::size_t i = 0u; i < pInstances->size(); ++i) {
+                instances.emplace_back(&(*pInstances)[i]);
+            }
+        }
+
+        std::vector<std::chrono::nanoseconds> durations(instances.size());
+        std::vector<char> warmed(instances.size(), 0);
+        const auto warmup = [&instances, &durations, &warmed](std::size_t i) {
+            const auto start = std::chrono::steady_clock::now();
+            warmed[i] = instances[i]->warmupComponent() ? 1 : 0;
+            durations[i] = std::chrono::steady_clock::now() - start;
+        };
+
+        const std::size_t levels = warmupLevels_.empty() ? 0u : (1u + *std::max_element(warmupLevels_.cbegin(), warmupLevels_.cend()));
+        for (std::size_t level = 0u; level < levels; ++level) {
+            std::vector<std::size_t> indices;
+            for (std::size_t i = 0u; i < warmupLevels_.size(); ++i) {
+                if (level == warmupLevels_[i]) {
+                    indices.emplace_back(i);
+                }
+            }
+            parallel(indices, std::min(threads, indices.size() - 1u), warmup);
+        }
+
+        std::vector<WarmupTiming> result;
+        for (std::size_t i = 0u; i < instances.size(); ++i) {
+            if (0 != warmed[i]) {
+                result.emplace_back(WarmupTiming{std::cref(instances[i]->type()), std::cref(instances[i]->id()), durations[i]});
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Return usage of the memory resources of the component instances configured with their own one (@see MemoryResource).
+     *
+     * @return Usage of each memory resource, in order of construction.
+     */
+    std::vector<MemoryUsage> memory() const {
+        std::vector<MemoryUsage> result;
+        for (const std::unique_ptr<Instances<>>& pInstances : componentStack_.stack) {
+            for (std::size_t i = 0u; i < pInstances->size(); ++i) {
+                const Component<>& component = (*pInstances)[i];
+                const MemoryResource& memoryResource = component.memoryResource();
+                if (&MemoryResource::global() != &memoryResource) {
+                    result.emplace_back(MemoryUsage{std::cref(component.type()), std::cref(component.id()), memoryResource.used(), memoryResource.peak(),
+                                                    memoryResource.limit(), memoryResource.violations()});
+                }
+            }
+        }
+        return result;
     }
-    ~Build() = default;
 
     /**
      * @brief Return information (component type name and instance id) about all available dependencies.
@@ -74,6 +256,21 @@ public:
         return dependencyRegistry_.get<T>();
     }
 
+    /**
+     * @brief Return references to all available dependencies of the given type, selected by the given identifier or identifier pattern (@see
+     * DependencyIdPattern).
+     * @exception DependencyRegisterNotFound If a plain identifier is given and no dependencies of the requested type are available.
+     * @exception DependencyNotFound If a plain identifier is given and no dependency of the requested type and id is available.
+     *
+     * @tparam T Dependencies type. Dependency type is its abstract interface, not the underlying implementing type.
+     * @param pattern Dependency identifier or identifier pattern.
+     * @return Vector of references.
+     */
+    template <typename T>
+    Dependencies<T> match(const std::string& pattern) const {
+        return dependencyRegistry_.match<T>(pattern);
+    }
+
     /**
      * @brief Return reference to the dependency of a given type and id.
      *
@@ -90,17 +287,151 @@ public:
     }
 
 private:
+#if defined(DIFF_STATIC_MEMORY)
+    using Scope = StaticMemory::Scope;   // Open throughout the operations allocating on behalf of the build.
+#else
+    struct Scope {
+        Scope() noexcept {}
+    };
+#endif
+
+    Build(Topology& topology, Modules modules, const Scope&)
+        : modules_{std::move(modules)}, dependencyIdTable_{topology}, dependencyRegistry_{nullptr, &dependencyIdTable_} {
+        dependencyIdTable_.resolve(topology);
+        warmupLevels_ = warmupLevels(topology, dependencyIdTable_);
+
+        FactoryCache factoryCache;
+        std::size_t first = 0u;
+        while (first < topology.size()) {
+            const std::string& type = topology[first].type;
+
+            std::size_t size = 1u;
+            while (((first + size) < topology.size()) && (topology[first + size].type == type)) {
+                ++size;
+            }
+
+            Factory<>& factory = factoryCache.get(type);
+            componentStack_.stack.emplace_back(factory.buildMany(&topology[first], size, dependencyRegistry_));
+            first += size;
+        }
+    }
+
+    Build(const Build& parent, const ScopeTopology& scopeTopology, const Scope&)
+        : dependencyRegistry_{&parent.dependencyRegistry_, &scopeTopology.dependencyIdTable()} {
+        const Topology& topology = scopeTopology.topology();
+        warmupLevels_ = warmupLevels(topology, scopeTopology.dependencyIdTable());
+
+        componentStack_.stack.reserve(std::distance(scopeTopology.begin(), scopeTopology.end()));
+        for (const ScopeTopology::Run& run : scopeTopology) {
+            componentStack_.stack.emplace_back(run.factory.get().buildMany(&topology[run.first], run.size, dependencyRegistry_));
+        }
+    }
+
+    /**
+     * @brief Factories resolved so far, by hash of the type name - each distinct type of the topology is looked up in FactoryRegistry only once.
+     */
+    class FactoryCache final {
+    public:
+        Factory<>& get(const std::string& type) {
+            const std::size_t hash = FactoryRegistry::hash(type);
+
+            const auto it = factories_.find(hash);
+            if ((factories_.cend() != it) && (it->second->type() == type)) {
+                return *it->second;
+            }
+
+            Factory<>& factory = FactoryRegistry::getInstance().get(hash, type);
+            factories_.emplace(hash, &factory);
+            return factory;
+        }
+
+    private:
+        std::unordered_map<std::size_t, Factory<>*> factories_;
+    };
+
+    /**
+     * @brief Return warm-up level of each topology entry - one above the highest level of the entries it depends on (@see warmup). Dependency slots
+     * are mapped to entries by the dependency id table (@see DependencyIdTable::entry) - a component id shared by many entries stands for all of them.
+     */
+    static std::vector<std::size_t> warmupLevels(const Topology& topology, const DependencyIdTable& dependencyIdTable) {
+        std::vector<std::size_t> result(topology.size(), 0u);
+        std::vector<std::size_t> slotLevels(dependencyIdTable.size(), 0u);   // Highest level of the preceding entries of the component id.
+        std::size_t maximum = 0u;                                            // Of the preceding entries.
+        for (std::size_t i = 0u; i < topology.size(); ++i) {
+            for (const DependencySlot dependencySlot : topology[i].dependencySlots) {
+                const std::size_t entry = dependencyIdTable.entry(dependencySlot);
+                result[i] = std::max(result[i], 1u + ((entry < i) ? slotLevels[dependencySlot] : maximum));
+            }
+            const DependencySlot slot = dependencyIdTable.find(topology[i].id);
+            slotLevels[slot] = std::max(slotLevels[slot], result[i]);
+            maximum = std::max(maximum, result[i]);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Call the function for each of the indices, on the calling thread and the given number of additional ones. Exception thrown by any of the
+     * calls is rethrown once all of them are complete.
+     */
+    template <typename F>
+    static void parallel(const std::vector<std::size_t>& indices, std::size_t threads, const F& function) {
+        std::atomic<std::size_t> next{0u};
+#if defined(DIFF_NO_EXCEPTIONS)
+        const auto work = [&indices, &next, &function]() {
+            const Scope scope{};   // Opened by each of the threads.
+            for (std::size_t i = next++; i < indices.size(); i = next++) {
+                function(indices[i]);
+            }
+        };
+#else
+        std::exception_ptr pException;
+        std::mutex mutex;
+        const auto work = [&indices, &next, &function, &pException, &mutex]() {
+            const Scope scope{};   // Opened by each of the threads.
+            for (std::size_t i = next++; i < indices.size(); i = next++) {
+                try {
+                    function(indices[i]);
+                } catch (...) {
+                    const std::lock_guard<std::mutex> lock{mutex};
+                    if (nullptr == pException) {
+                        pException = std::current_exception();
+                    }
+                }
+            }
+        };
+#endif
+
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (std::size_t i = 0u; i < threads; ++i) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+#if !defined(DIFF_NO_EXCEPTIONS)
+        if (nullptr != pException) {
+            std::rethrow_exception(pException);
+        }
+#endif
+    }
+
     struct ComponentStack final {
         ~ComponentStack() {
             while (!stack.empty()) {
-                stack.pop();
+                stack.pop_back();
             }
         }
-        std::stack<std::unique_ptr<Component<>>> stack;
+        std::vector<std::unique_ptr<Instances<>>> stack;
     };
 
+    const Modules modules_;
+    DependencyIdTable dependencyIdTable_;
     DependencyRegistry dependencyRegistry_;
     ComponentStack componentStack_;
+    std::vector<std::size_t> warmupLevels_;   // Of the component instances, in order of construction.
 };
 
 }   // namespace diff
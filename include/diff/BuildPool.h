@@ -0,0 +1,175 @@
+#pragma once
+
+/**
+ * @file BuildPool.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines BuildPool class used to recycle scoped Build objects instead of constructing them repeatedly.
+ * @version 0.1
+ * @date 2025-03-12
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <diff/Build.h>
+#include <diff/ScopeTopology.h>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+namespace diff {
+
+/**
+ * @brief Keeps a fixed number of fully constructed scoped Build objects (all of the same ScopeTopology) ready for use. Acquired Build objects are
+ * returned to the pool on release, after being reset (@see Build::reset, resettable). Acquire and release may be called concurrently from multiple
+ * threads - both are lock-free unless the pool is empty on acquire.
+ *
+ * If the pool is empty on acquire, a new Build object is constructed (and the miss is counted). Misses are constructed one at a time, as component
+ * construction passes id and config through per-type static storage (@see Component). If the pool is full on release, or the reset throws, the
+ * Build object is destructed.
+ */
+class BuildPool final {
+public:
+    /**
+     * @brief Returns released Build object to the pool it was acquired from.
+     */
+    class Releaser final {
+    public:
+        Releaser(BuildPool *pBuildPool = nullptr) noexcept : pBuildPool_{pBuildPool} {}
+
+        void operator()(Build *pBuild) const noexcept { pBuildPool_->release(pBuild); }
+
+    private:
+        BuildPool *pBuildPool_;
+    };
+
+    /**
+     * @brief Owning handle of an acquired Build object. Releases the object back to the pool when destructed.
+     */
+    using Handle = std::unique_ptr<Build, Releaser>;
+
+    BuildPool() = delete;
+    BuildPool(const BuildPool &) = delete;
+    BuildPool(BuildPool &&) = delete;
+
+    /**
+     * @brief Construct BuildPool object. Pre-construct the given number of scoped Build objects.
+     *
+     * @param parent Parent Build object of all the pooled scopes. Shall outlive the pool.
+     * @param scopeTopology Pre-compiled topology of the pooled scopes. Shall outlive the pool.
+     * @param capacity Maximal number of idle Build objects kept by the pool.
+     */
+    BuildPool(const Build &parent, const ScopeTopology &scopeTopology, std::size_t capacity)
+        : parent_{parent}, scopeTopology_{scopeTopology}, capacity_{capacity}, slots_{std::make_unique<std::atomic<Build *>[]>(capacity)} {
+#if defined(DIFF_NO_EXCEPTIONS)
+        fill();
+#else
+        try {
+            fill();
+        } catch (...) {
+            clear();
+            throw;
+        }
+#endif
+    }
+
+    /**
+     * @brief Destruct all the idle Build objects. All the acquired handles shall be released beforehand.
+     */
+    ~BuildPool() { clear(); }
+
+    BuildPool &operator=(const BuildPool &) = delete;
+    BuildPool &operator=(BuildPool &&) = delete;
+
+    /**
+     * @brief Take an idle Build object out of the pool. Construct a new one if the pool is empty - serialized with other misses.
+     *
+     * @return Handle of the acquired Build object.
+     */
+    Handle acquire() {
+        for (std::size_t i = 0u; i < capacity_; ++i) {
+            Build *const pBuild = slots_[i].exchange(nullptr, std::memory_order_acquire);
+            if (nullptr != pBuild) {
+                return Handle{pBuild, Releaser{this}};
+            }
+        }
+
+        misses_.fetch_add(1u, std::memory_order_relaxed);
+        const std::lock_guard<std::mutex> lock{mutex_};
+        return Handle{new Build{parent_, scopeTopology_}, Releaser{this}};
+    }
+
+    /**
+     * @brief Return maximal number of idle Build objects kept by the pool.
+     *
+     * @return Pool capacity.
+     */
+    std::size_t capacity() const noexcept { return capacity_; }
+
+    /**
+     * @brief Return number of idle Build objects currently kept by the pool. The value is only a snapshot if the pool is used concurrently.
+     *
+     * @return Number of idle Build objects.
+     */
+    std::size_t available() const noexcept {
+        std::size_t result = 0u;
+        for (std::size_t i = 0u; i < capacity_; ++i) {
+            if (nullptr != slots_[i].load(std::memory_order_relaxed)) {
+                ++result;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Return number of acquisitions which found the pool empty and had to construct a new Build object.
+     *
+     * @return Number of misses.
+     */
+    std::size_t misses() const noexcept { return misses_.load(std::memory_order_relaxed); }
+
+private:
+    void fill() {
+        for (std::size_t i = 0u; i < capacity_; ++i) {
+            slots_[i].store(new Build{parent_, scopeTopology_}, std::memory_order_release);
+        }
+    }
+
+    void clear() noexcept {
+        for (std::size_t i = 0u; i < capacity_; ++i) {
+            delete slots_[i].exchange(nullptr, std::memory_order_acquire);
+        }
+    }
+
+    // Called by the handle deleter - shall not throw. Build object which failed to reset is not reused.
+    void release(Build *pBuild) noexcept {
+#if defined(DIFF_NO_EXCEPTIONS)
+        pBuild->reset();
+#else
+        try {
+            pBuild->reset();
+        } catch (...) {
+            delete pBuild;
+            return;
+        }
+#endif
+
+        for (std::size_t i = 0u; i < capacity_; ++i) {
+            Build *pExpected = nullptr;
+            if (slots_[i].compare_exchange_strong(pExpected, pBuild, std::memory_order_release, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+
+        delete pBuild;
+    }
+
+    const Build &parent_;
+    const ScopeTopology &scopeTopology_;
+
+    const std::size_t capacity_;
+    const std::unique_ptr<std::atomic<Build *>[]> slots_;
+    std::atomic<std::size_t> misses_{0u};
+    std::mutex mutex_;   // Serializes construction of Build objects on misses.
+};
+
+}   // namespace diff
@@ -9,10 +9,14 @@
  * @copyright Copyright (c) 2024 Slawomir Niespodziany
  */
 
+#include <diff/ComponentMetadata.h>
 #include <diff/Config.h>
+#include <diff/ConfigLayout.h>
 #include <diff/Demangler.h>
 #include <diff/DependencyRegistry.h>
 #include <diff/Exception.h>
+#include <diff/MemoryResource.h>
+#include <diff/Span.h>
 #include <functional>
 #include <map>
 #include <memory>
@@ -23,6 +27,8 @@
 
 namespace diff {
 
+class Build;
+
 /**
  * @brief Generic Component<...> template. The intended use of this template is via its specialized templates only - this generic template shall not
  * be used.
@@ -59,7 +65,22 @@ public:
     const std::string& id() const { return id_; }
 
 protected:
-    Component(const std::string& type, std::string&& id, Config&& config) : type_{type}, id_{std::move(id)}, config_{std::move(config)} {}
+    friend class Build;
+
+    Component(const std::string& type, std::string&& id, Config&& config)
+        : type_{type}, id_{std::move(id)}, config_{std::move(config)}, pMemoryResource_{MemoryResource::create(type_, id_, config_)} {}
+
+    /**
+     * @brief For the framework use only. Restore the initial state of the component (as declared by resettable). Does nothing by default.
+     */
+    virtual void resetComponent() {}
+
+    /**
+     * @brief For the framework use only. Prepare the component for its first use (as declared by warmable). Does nothing by default.
+     *
+     * @return True if the component is warmable, false otherwise.
+     */
+    virtual bool warmupComponent() { return false; }
 
     /**
      * @brief Return config parameter of the given type and key.
@@ -73,19 +94,85 @@ protected:
      */
     template <typename T>
     const T& config(const std::string& key) const {
-        const auto it = config_.find(key);
-        if (config_.cend() == it) {
-            throw ConfigEntryNotFound(type_, id_, key);
+        const Result<const T&> result = tryConfig<T>(key);
+        if (!result) {
+            ErrorHandler::raise(result.error());
+        }
+        return result.value();
+    }
+
+    /**
+     * @brief @see config. Report failure with the returned object instead of raising an error, e.g. to fall back to a default value.
+     *
+     * @tparam T Config parameter type.
+     * @param key Config parameter key.
+     * @return Parameter reference or description of ConfigEntryNotFound/ConfigEntryCastError failure.
+     */
+    template <typename T>
+    Result<const T&> tryConfig(const std::string& key) const {
+        const ConfigValue<>* const pConfigValue = config_.find(key);
+        if (nullptr == pConfigValue) {
+            return Error{ErrorCode::CONFIG_ENTRY_NOT_FOUND, type_, id_, key};
+        }
+
+        return pConfigValue->tryValue<T>(key);
+    }
+
+    /**
+     * @brief @see config. Resolve the key to a slot once per config shape (@see ConfigKey) - repeated reads of instances sharing a shape skip the
+     * key lookup.
+     *
+     * @tparam T Config parameter type.
+     * @param key Config key, typically a static one of the component type.
+     * @return Parameter reference.
+     */
+    template <typename T>
+    const T& config(const ConfigKey& key) const {
+        const Result<const T&> result = tryConfig<T>(key);
+        if (!result) {
+            ErrorHandler::raise(result.error());
         }
+        return result.value();
+    }
 
-        return (*it)->value<T>();
+    /**
+     * @brief @see tryConfig, @see config(const ConfigKey&).
+     *
+     * @tparam T Config parameter type.
+     * @param key Config key, typically a static one of the component type.
+     * @return Parameter reference or description of ConfigEntryNotFound/ConfigEntryCastError failure.
+     */
+    template <typename T>
+    Result<const T&> tryConfig(const ConfigKey& key) const {
+        const ConfigValue<>* const pConfigValue = config_.find(key);
+        if (nullptr == pConfigValue) {
+            return Error{ErrorCode::CONFIG_ENTRY_NOT_FOUND, type_, id_, key.key()};
+        }
+
+        return pConfigValue->tryValue<T>(key.key());
     }
 
+    /**
+     * @brief Return shape of the config of the component instance - shared with the instances configured with the same keys.
+     *
+     * @return Shape reference.
+     */
+    const ConfigShape& configShape() const noexcept { return config_.shape(); }
+
+    /**
+     * @brief Return memory resource of the component instance - its own one if configured with the reserved config entries (@see MemoryResource),
+     * the global one otherwise. E.g. for the containers of the component, or the messages it allocates.
+     *
+     * @return Resource reference.
+     */
+    MemoryResource& memoryResource() const noexcept { return (nullptr != pMemoryResource_) ? *pMemoryResource_ : MemoryResource::global(); }
+
 private:
     const std::string& type_;
     const std::string id_;
 
-    const Config config_;
+    const ConfigLayout config_;
+    const std::unique_ptr<MemoryResource> pMemoryResource_;   // Destructed after the component itsself, which may still hold its memory.
 };
 
 template <typename T>
@@ -118,6 +205,21 @@ protected:
      */
     void registerAs(DependencyRegistry& dependencyRegistry) {}
 
+    /**
+     * @brief For the framework use only. Describe dependencies provided by the component (as declared by as<...> and side<...>).
+     *
+     * @param metadata Metadata to be completed.
+     */
+    static void describe(ComponentMetadata& metadata) {}
+
+    /**
+     * @brief Declare config entries expected by the component. To be hidden by a public static method of the same signature in the component type
+     * (@see ConfigSchema). Declares nothing by default.
+     *
+     * @param schema Schema to be completed.
+     */
+    static void schema(ConfigSchema& schema) {}
+
     /**
      *  @brief For the framework use only.
      */
@@ -203,6 +305,14 @@ protected:
         }
         Component<T, Vs...>::registerAs(dependencyRegistry);
     }
+
+    /**
+     * @brief @see Component<T>::describe
+     */
+    static void describe(ComponentMetadata& metadata) {
+        metadata.provides.emplace_back(&Demangler::of<U>());
+        Component<T, Vs...>::describe(metadata);
+    }
 };
 
 /**
@@ -264,7 +374,7 @@ protected:
 
             for (const auto& kv : sideDependencies) {
                 if (kv.first.empty()) {
-                    throw -0.5f;
+                    ErrorHandler::raise(Error{ErrorCode::SIDE_DEPENDENCY_ID_EMPTY, Component<T>::type(), Component<T>::id()});
                 }
 
                 std::set<std::string>::const_iterator it;
@@ -272,7 +382,7 @@ protected:
                 std::tie(it, emplaced) = Component<T>::sideDependencyIdentifiers_.emplace(Component<T>::id() + "_"s + kv.first);
 
                 if (!emplaced) {
-                    throw 9999;
+                    ErrorHandler::raise(Error{ErrorCode::SIDE_DEPENDENCY_ID_DUPLICATED, Component<T>::type(), *it});
                 }
 
                 dependencyRegistry.add<U>(*it, kv.second);
@@ -281,6 +391,166 @@ protected:
 
         Component<T, Vs...>::registerAs(dependencyRegistry);
     }
+
+    /**
+     * @brief @see Component<T>::describe
+     */
+    static void describe(ComponentMetadata& metadata) {
+        metadata.sides.emplace_back(&Demangler::of<U>());
+        Component<T, Vs...>::describe(metadata);
+    }
+};
+
+/**
+ * @brief Collection of named arrays of side dependencies to be registered in DependencyRegistry (@see side<Span<T>>). Side-ids follow the rules of
+ * SideDependencies. Each array is registered as a single dependency of type Span<T>, under the identifier composed as for SideDependencies. Each
+ * array element is available as a dependency of type T, under that identifier suffixed with the element index in square brackets (e.g.
+ * "component0_shards[7]").
+ *
+ * @tparam T Dependencies type.
+ */
+template <typename T>
+using IndexedSideDependencies = std::map<std::string /* side-id */, Span<T>>;
+
+/**
+ * @brief Specialization resolving user customization applied with side<Span<...>> and registering the component arrays of side dependencies of
+ * the given type. User defined component shall implement a protected member function of the following signature:
+ *      void side(IndexedSideDependencies<U> &indexedSideDependencies);
+ * which populates indexedSideDependencies object with contiguous arrays of side-dependency objects, with assigned side-identifiers for those arrays.
+ * Registration cost does not depend on array sizes - a single registry node is created per array.
+ *
+ * @tparam T User component type (CRTP pattern).
+ * @tparam U Dependency type of the component side dependencies to be registered.
+ * @tparam Vs Other user applied customizations.
+ */
+template <typename T, typename U, typename... Vs>
+class Component<T, side<Span<U>>, Vs...> : public Component<T, Vs...> {
+public:
+    virtual ~Component() = default;
+
+protected:
+    friend class Factory<T>;
+
+    Component() = default;
+
+    /**
+     * @brief @see Component<T>::registerAs
+     */
+    void registerAs(DependencyRegistry& dependencyRegistry) {
+        struct IndexedSideDependenciesExtractor : public T {
+            static void extract(T& t, IndexedSideDependencies<U>& indexedSideDependencies) {
+                (t.*(static_cast<void (T::*)(IndexedSideDependencies<U>&)>(&IndexedSideDependenciesExtractor::side)))(indexedSideDependencies);
+            }
+        };
+
+        IndexedSideDependenciesExtractor::extract(static_cast<T&>(*this), indexedSideDependencies_);
+
+        for (auto& kv : indexedSideDependencies_) {
+            if (kv.first.empty()) {
+                ErrorHandler::raise(Error{ErrorCode::SIDE_DEPENDENCY_ID_EMPTY, Component<T>::type(), Component<T>::id()});
+            }
+
+            std::set<std::string>::const_iterator it;
+            bool emplaced;
+            std::tie(it, emplaced) = Component<T>::sideDependencyIdentifiers_.emplace(Component<T>::id() + "_"s + kv.first);
+
+            if (!emplaced) {
+                ErrorHandler::raise(Error{ErrorCode::SIDE_DEPENDENCY_ID_DUPLICATED, Component<T>::type(), *it});
+            }
+
+            dependencyRegistry.add<Span<U>>(*it, kv.second);
+        }
+
+        Component<T, Vs...>::registerAs(dependencyRegistry);
+    }
+
+    /**
+     * @brief @see Component<T>::describe
+     */
+    static void describe(ComponentMetadata& metadata) {
+        metadata.indexedSides.emplace_back(&Demangler::of<U>());
+        Component<T, Vs...>::describe(metadata);
+    }
+
+private:
+    IndexedSideDependencies<U> indexedSideDependencies_;
+};
+
+/**
+ * @brief Used for component customization. Putting resettable as a template argument of the Component<...> template results in:
+ *  - User defined component shall implement a member function of the following signature:
+ *      void reset();
+ *    which restores the state the component had right after construction.
+ *  - Framework calls that function whenever a Build object holding the component instance is recycled (@see BuildPool), instead of destructing
+ * and constructing the instance again.
+ */
+struct resettable {};
+
+/**
+ * @brief Specialization resolving user customization applied with resettable and forwarding the framework reset request to the component.
+ *
+ * @tparam T User component type (CRTP pattern).
+ * @tparam Vs Other user applied customizations.
+ */
+template <typename T, typename... Vs>
+class Component<T, resettable, Vs...> : public Component<T, Vs...> {
+public:
+    virtual ~Component() = default;
+
+protected:
+    friend class Factory<T>;
+
+    Component() = default;
+
+    /**
+     * @brief @see Component<void>::resetComponent
+     */
+    void resetComponent() override {
+        struct Resetter : public T {
+            static void apply(T& t) { (t.*(static_cast<void (T::*)()>(&Resetter::reset)))(); }
+        };
+
+        Resetter::apply(static_cast<T&>(*this));
+    }
+};
+
+/**
+ * @brief Used for component customization. Putting warmable as a template argument of the Component<...> template results in:
+ *  - User defined component shall implement a member function of the following signature:
+ *      void warmup();
+ *    which brings the component to its steady state ahead of its first use - e.g. prefills its pools, touches its buffers, builds its lookup tables.
+ *  - Framework calls that function once the components are built, if requested (@see Build::warmup). Dependencies of the component are warmed up
+ * before it.
+ */
+struct warmable {};
+
+/**
+ * @brief Specialization resolving user customization applied with warmable and forwarding the framework warm-up request to the component.
+ *
+ * @tparam T User component type (CRTP pattern).
+ * @tparam Vs Other user applied customizations.
+ */
+template <typename T, typename... Vs>
+class Component<T, warmable, Vs...> : public Component<T, Vs...> {
+public:
+    virtual ~Component() = default;
+
+protected:
+    friend class Factory<T>;
+
+    Component() = default;
+
+    /**
+     * @brief @see Component<void>::warmupComponent
+     */
+    bool warmupComponent() override {
+        struct Warmer : public T {
+            static void apply(T& t) { (t.*(static_cast<void (T::*)()>(&Warmer::warmup)))(); }
+        };
+
+        Warmer::apply(static_cast<T&>(*this));
+        return true;
+    }
 };
 
 }   // namespace diff
@@ -0,0 +1,83 @@
+#pragma once
+
+/**
+ * @file ComponentMetadata.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines ComponentMetadata structure describing the dependencies a component type consumes and provides, and the config it expects.
+ * @version 0.1
+ * @date 2025-04-01
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <diff/ConfigSchema.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace diff {
+
+/**
+ * @brief Compile time metadata of a component type, published by its factory (@see Factory::metadata). Allows to type check a topology without
+ * instantiating any component (@see TopologyValidator).
+ */
+struct ComponentMetadata {
+    /**
+     * @brief Form in which a constructor parameter is injected.
+     */
+    enum class Injection : std::uint8_t {
+        REFERENCE,      // U& - single dependency
+        SPAN,           // Span<U> - array of side dependencies
+        DEPENDENCIES    // Dependencies<U> - collection selected by an identifier or identifier pattern
+    };
+
+    /**
+     * @brief Constructor parameter - injection form and dependency type name (element type name for collections).
+     */
+    struct Parameter {
+        Injection injection;
+        const std::string *pType;   // nullptr if not known (the injection of the parameter has not been instantiated in the binary)
+    };
+
+    /**
+     * @brief Size of the component object in bytes (sizeof), e.g. to estimate memory footprint of a topology without building it (@see Footprint).
+     */
+    std::size_t size = 0u;
+
+    /**
+     * @brief Alignment of the component object in bytes (alignof).
+     */
+    std::size_t alignment = 0u;
+
+    /**
+     * @brief Number of constructor parameters, each consuming one dependency id of the topology entry.
+     */
+    std::size_t arity = 0u;
+
+    /**
+     * @brief Constructor parameters, in order.
+     */
+    std::vector<Parameter> parameters;
+
+    /**
+     * @brief Dependency types the component is registered as (@see as).
+     */
+    std::vector<const std::string *> provides;
+
+    /**
+     * @brief Dependency types of the side dependencies exposed by the component (@see side). Registered under ids prefixed with the component id.
+     */
+    std::vector<const std::string *> sides;
+
+    /**
+     * @brief Element types of the arrays of side dependencies exposed by the component (@see side<Span<T>>).
+     */
+    std::vector<const std::string *> indexedSides;
+
+    /**
+     * @brief Config entries expected by the component (@see ConfigSchema). Empty if not declared.
+     */
+    ConfigSchema config;
+};
+
+}   // namespace diff
@@ -12,9 +12,12 @@
 #include <diff/CastChecker.h>
 #include <diff/Demangler.h>
 #include <diff/Exception.h>
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
+#include <new>
 #include <set>
 #include <stdexcept>
 #include <string>
@@ -25,66 +28,354 @@ using namespace std::string_literals;
 
 namespace diff {
 
+template <typename T = void>
+class ConfigValue;
+
 template <typename T = void>
 class ConfigEntry;
 
+class SharedConfigEntry;
+
 /**
- * @brief Abstract base class, a common interface for instantiations of ConfigEntry<T != void>. Multiple ConfigEntry objects compose a Config.
+ * @brief Abstract base class, a common interface for instantiations of ConfigValue<T != void> - a config value without its key. Values of a built
+ * component instance are stored this way, the keys being kept by their shape (@see ConfigLayout). Config entries are values along with the keys.
  */
 template <>
-class ConfigEntry<void> {
+class ConfigValue<void> {
 public:
-    virtual ~ConfigEntry() = default;
+    virtual ~ConfigValue() = default;
 
     /**
-     * @brief Return entry key.
+     * @brief Return the value. Value is casted to a type determined by T.
+     * @exception ConfigEntryCastError If value can not be casted to the given type (dependent on the actual value type and value, @see
+     * ConfigEntryCastError).
      *
-     * @return Entry key reference.
+     * @tparam T Requested type.
+     * @param key Key of the value, describing the failure.
+     * @return Value reference.
      */
-    const std::string& key() const noexcept { return key_; }
+    template <typename T>
+    const T& value(const std::string& key) const {
+        const Result<const T&> result = tryValue<T>(key);
+        if (!result) {
+            ErrorHandler::raise(result.error());
+        }
+        return result.value();
+    }
 
     /**
-     * @brief Return entry value. Value is casted to a type determined by T.
-     * @exception ConfigEntryCastError If value can not be casted to the given type (dependent on the actual entry type and value, @see
-     * ConfigEntryCastError).
+     * @brief @see value. Report failure with the returned object instead of raising an error.
      *
      * @tparam T Requested type.
-     * @return Value reference.
+     * @param key Key of the value, describing the failure.
+     * @return Value reference or ConfigEntryCastError description.
      */
     template <typename T>
-    const T& value() const {
+    Result<const T&> tryValue(const std::string& key) const {
         static_assert(!std::is_const<T>::value, "Unable to distinguish const type.");   // TODO
         static_assert(!std::is_volatile<T>::value, "Unable to distinguish volatile type.");
 
-        return *static_cast<const T*>(value(typeid(T)));
+        const void* const pValue = value(typeid(T));
+        if (nullptr == pValue) {
+            return castError<T>(key);
+        }
+        return *static_cast<const T*>(pValue);
+    }
+
+    /**
+     * @brief Return the value converted to type T, if representable by T - regardless of the value type (unlike value<T>, e.g. an int8_t value is
+     * convertible to int64_t). Values of integral types are converted to one another, except for bool. Values of other types are not converted.
+     *
+     * @tparam T Requested type.
+     * @param key Key of the value, describing the failure.
+     * @return Converted value or ConfigEntryCastError description.
+     */
+    template <typename T, std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value, bool> = true>
+    Result<T> tryConvert(const std::string& key) const {
+        std::uintmax_t magnitude = 0u;
+        bool negative = false;
+        if (!integral(magnitude, negative)) {
+            return castError<T>(key);
+        }
+
+        if (negative) {
+            const std::intmax_t value = -static_cast<std::intmax_t>(magnitude - 1u) - 1;   // Safe for the minimum of std::intmax_t.
+            if (!std::is_signed<T>::value || (value < static_cast<std::intmax_t>(std::numeric_limits<T>::min()))) {
+                return castError<T>(key);
+            }
+            return static_cast<T>(value);
+        }
+
+        if (static_cast<std::uintmax_t>(std::numeric_limits<T>::max()) < magnitude) {
+            return castError<T>(key);
+        }
+        return static_cast<T>(magnitude);
+    }
+
+    /**
+     * @brief @see tryConvert
+     */
+    template <typename T, std::enable_if_t<!std::is_integral<T>::value || std::is_same<T, bool>::value, bool> = true>
+    Result<T> tryConvert(const std::string& key) const {
+        const void* const pValue = (type() == Demangler::of<T>()) ? value(typeid(T)) : nullptr;
+        if (nullptr == pValue) {
+            return castError<T>(key);
+        }
+        return *static_cast<const T*>(pValue);
     }
 
     /**
-     * @brief Return entry type name.
+     * @brief Return value type name.
      *
-     * @return Reference to entry type name.
+     * @return Reference to value type name.
      */
     virtual const std::string& type() const noexcept = 0;
 
     /**
-     * @brief Return string representation of entry value.
+     * @brief Return string representation of the value.
      * For std::string type it is the value itsself. For integral types it is the equivalent of std::to_string().
      *
-     * @return String representation of entry value.
+     * @return String representation of the value.
      */
     virtual std::string toString() const noexcept = 0;
 
-protected:
-    ConfigEntry(const std::string& key) : key_{key} {}
+    /**
+     * @brief Return size of the value in bytes - the size of the value type for integral types, the length including terminator for std::string.
+     *
+     * @return Value size in bytes.
+     */
+    virtual std::size_t size() const noexcept = 0;
 
     /**
-     * @brief Return const void pointer to entry value variable.
-     * @exception ConfigEntryCastError If the underlying variable can not be reinterpreted as the type indicated by typeInfo.
+     * @brief For the framework use only. Return const void pointer to the value variable.
      *
      * @param typeInfo Indicator of the type for the variable to be reinterpreted as.
-     * @return Variable pointer.
+     * @return Variable pointer, or nullptr if the underlying variable can not be reinterpreted as the type indicated by typeInfo.
+     */
+    virtual const void* value(const std::type_info& typeInfo) const noexcept = 0;
+
+    /**
+     * @brief For the framework use only. Return the value as sign and magnitude, if of integral type other than bool.
+     *
+     * @param magnitude Absolute value.
+     * @param negative Sign of the value.
+     * @return True if the value is of integral type other than bool, false otherwise.
+     */
+    virtual bool integral(std::uintmax_t&, bool&) const noexcept { return false; }
+
+protected:
+    ConfigValue() = default;
+    ConfigValue(const ConfigValue&) = default;
+    ConfigValue(ConfigValue&&) = default;
+
+    ConfigValue& operator=(const ConfigValue&) = delete;
+    ConfigValue& operator=(ConfigValue&&) = delete;
+
+private:
+    template <typename T>
+    Error castError(const std::string& key) const {
+        return Error{ErrorCode::CONFIG_ENTRY_CAST_ERROR, key, toString(), type(), Demangler::of<T>()};
+    }
+};
+
+/**
+ * @brief Config value of std::string type.
+ */
+template <>
+class ConfigValue<std::string> final : public ConfigValue<> {
+public:
+    /**
+     * @brief Instantiate a value of type std::string.
+     *
+     * @param value Value.
+     */
+    explicit ConfigValue(const std::string& value) : value_{value} {}
+    explicit ConfigValue(std::string&& value) noexcept : value_{std::move(value)} {}
+    ConfigValue(const ConfigValue&) = default;
+    ConfigValue(ConfigValue&&) = default;
+    virtual ~ConfigValue() = default;
+
+    /**
+     * @brief Return the value.
+     */
+    const std::string& get() const noexcept { return value_; }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual const std::string& type() const noexcept override { return Demangler::of<std::string>(); }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual std::string toString() const noexcept override { return value_; }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual std::size_t size() const noexcept override { return value_.size() + 1u; }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual const void* value(const std::type_info& typeInfo) const noexcept override {
+        return (typeid(std::string) == typeInfo) ? static_cast<const void*>(&value_) : nullptr;
+    }
+
+private:
+    std::string value_;   // Not const - moved out of the config entry holding it (@see ConfigEntry::moveValue).
+};
+
+/**
+ * @brief Config value of integral type - @see std::is_integral.
+ */
+template <typename T>
+class ConfigValue final : public ConfigValue<> {
+public:
+    static_assert(std::is_integral<T>::value, "ConfigValue template parameter T shall be integral.");
+    static_assert(!std::is_const<T>::value, "ConfigValue template parameter T shall not be const.");
+    static_assert(!std::is_volatile<T>::value, "ConfigValue template parameter T shall not be volatile.");
+
+    /**
+     * @brief Instantiate a value of integral type.
+     *
+     * @param value Value.
+     */
+    explicit ConfigValue(const T& value) noexcept : value_{value} {}
+    ConfigValue(const ConfigValue&) = default;
+    ConfigValue(ConfigValue&&) = default;
+    virtual ~ConfigValue() = default;
+
+    /**
+     * @brief Return the value.
+     */
+    const T& get() const noexcept { return value_; }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual const std::string& type() const noexcept override { return Demangler::of<T>(); }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual std::string toString() const noexcept override {
+        if (std::is_same<bool, T>::value) {
+            return value_ ? ("true"s) : ("false"s);
+        } else {
+            return std::to_string(value_);
+        }
+    }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual std::size_t size() const noexcept override { return sizeof(T); }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual const void* value(const std::type_info& typeInfo) const noexcept override {
+        if (typeid(T) == typeInfo) {   // Exact type, e.g. converted to the type declared by the component (@see ConfigSchema).
+            return &value_;
+        }
+        return IntegralCastChecker::check(value_, typeInfo) ? static_cast<const void*>(&value_) : nullptr;
+    }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual bool integral(std::uintmax_t& magnitude, bool& negative) const noexcept override {
+        if (std::is_same<bool, T>::value) {
+            return false;
+        }
+        negative = (value_ < static_cast<T>(0));
+        magnitude = negative ? (static_cast<std::uintmax_t>(0u) - static_cast<std::uintmax_t>(value_)) : static_cast<std::uintmax_t>(value_);
+        return true;
+    }
+
+private:
+    const T value_;
+};
+
+/**
+ * @brief Abstract base class, a common interface for instantiations of ConfigEntry<T != void> - a config value along with its key. Multiple
+ * ConfigEntry objects compose a Config.
+ */
+template <>
+class ConfigEntry<void> : public ConfigValue<> {
+public:
+    virtual ~ConfigEntry() = default;
+
+    /**
+     * @brief Return entry key.
+     *
+     * @return Entry key reference.
+     */
+    const std::string& key() const noexcept { return key_; }
+
+    /**
+     * @brief @see ConfigValue<void>::value
+     */
+    template <typename T>
+    const T& value() const {
+        return ConfigValue<>::value<T>(key_);
+    }
+
+    /**
+     * @brief @see ConfigValue<void>::tryValue
+     */
+    template <typename T>
+    Result<const T&> tryValue() const {
+        return ConfigValue<>::tryValue<T>(key_);
+    }
+
+    /**
+     * @brief @see ConfigValue<void>::tryConvert
+     */
+    template <typename T>
+    Result<T> tryConvert() const {
+        return ConfigValue<>::tryConvert<T>(key_);
+    }
+
+    using ConfigValue<>::value;
+
+    /**
+     * @brief Return a copy of the entry.
+     *
+     * @return Pointer to the newly allocated copy.
+     */
+    virtual std::unique_ptr<ConfigEntry<>> clone() const = 0;
+
+    /**
+     * @brief Return a copy of the entry under another key.
+     *
+     * @param key Key of the copy.
+     * @return Pointer to the newly allocated copy.
+     */
+    virtual std::unique_ptr<ConfigEntry<>> clone(const std::string& key) const = 0;
+
+    /**
+     * @brief For the framework use only. Return size of the ConfigValue object holding the value of the entry (@see moveValue).
+     */
+    virtual std::size_t valueSize() const noexcept = 0;
+
+    /**
+     * @brief For the framework use only. Return alignment of the ConfigValue object holding the value of the entry (@see moveValue).
+     */
+    virtual std::size_t valueAlignment() const noexcept = 0;
+
+    /**
+     * @brief For the framework use only. Move the value out of the entry, to a ConfigValue object constructed in the given storage. The entry keeps
+     * its key, but its value is unspecified afterwards - it shall only be destructed.
+     *
+     * @param pStorage Storage of valueSize() bytes, aligned to valueAlignment().
+     * @return Constructed value reference.
      */
-    virtual const void* value(const std::type_info& typeInfo) const = 0;
+    virtual ConfigValue<>& moveValue(void* pStorage) noexcept = 0;
+
+protected:
+    ConfigEntry(const std::string& key) : key_{key} {}
 
     const std::string key_;
 };
@@ -104,30 +395,55 @@ public:
     ConfigEntry(const std::string& key, const std::string& value) : ConfigEntry<>(key), value_{value} {}
     virtual ~ConfigEntry() = default;
 
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual const std::string& type() const noexcept override { return value_.type(); }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual std::string toString() const noexcept override { return value_.toString(); }
+
     /**
      * @brief @see ConfigEntry<void>
      */
-    virtual const std::string& type() const noexcept override { return Demangler::of<std::string>(); }
+    virtual std::unique_ptr<ConfigEntry<>> clone() const override { return std::make_unique<ConfigEntry<std::string>>(key_, value_.get()); }
 
     /**
      * @brief @see ConfigEntry<void>
      */
-    virtual std::string toString() const noexcept override { return value_; }
+    virtual std::unique_ptr<ConfigEntry<>> clone(const std::string& key) const override {
+        return std::make_unique<ConfigEntry<std::string>>(key, value_.get());
+    }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual std::size_t size() const noexcept override { return value_.size(); }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual const void* value(const std::type_info& typeInfo) const noexcept override { return value_.value(typeInfo); }
 
-protected:
     /**
      * @brief @see ConfigEntry<void>
      */
-    virtual const void* value(const std::type_info& typeInfo) const override {
-        if (typeid(std::string) != typeInfo) {
-            throw ConfigEntryCastError(key_, toString(), Demangler::of<std::string>(), Demangler::from(typeInfo.name()));
-        }
+    virtual std::size_t valueSize() const noexcept override { return sizeof(ConfigValue<std::string>); }
 
-        return static_cast<const void*>(&value_);
-    }
+    /**
+     * @brief @see ConfigEntry<void>
+     */
+    virtual std::size_t valueAlignment() const noexcept override { return alignof(ConfigValue<std::string>); }
+
+    /**
+     * @brief @see ConfigEntry<void>
+     */
+    virtual ConfigValue<>& moveValue(void* pStorage) noexcept override { return *new (pStorage) ConfigValue<std::string>{std::move(value_)}; }
 
 private:
-    const std::string value_;
+    ConfigValue<std::string> value_;
 };
 
 /**
@@ -136,10 +452,6 @@ private:
 template <typename T>
 class ConfigEntry : public ConfigEntry<> {
 public:
-    static_assert(std::is_integral<T>::value, "ConfigEntry template parameter T shall be integral.");
-    static_assert(!std::is_const<T>::value, "ConfigEntry template parameter T shall not be const.");
-    static_assert(!std::is_volatile<T>::value, "ConfigEntry template parameter T shall not be volatile.");
-
     /**
      * @brief Instantiate an entry for integral type.
      *
@@ -149,36 +461,187 @@ public:
     ConfigEntry(const std::string& key, const T& value) : ConfigEntry<>(key), value_{value} {}
     virtual ~ConfigEntry() = default;
 
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual const std::string& type() const noexcept override { return value_.type(); }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual std::string toString() const noexcept override { return value_.toString(); }
+
     /**
      * @brief @see ConfigEntry<void>
      */
-    virtual const std::string& type() const noexcept override { return Demangler::of<T>(); }
+    virtual std::unique_ptr<ConfigEntry<>> clone() const override { return std::make_unique<ConfigEntry<T>>(key_, value_.get()); }
 
     /**
      * @brief @see ConfigEntry<void>
      */
-    virtual std::string toString() const noexcept override {
-        if (std::is_same<bool, T>::value) {
-            return value_ ? ("true"s) : ("false"s);
-        } else {
-            return std::to_string(value_);
-        }
-    }
+    virtual std::unique_ptr<ConfigEntry<>> clone(const std::string& key) const override { return std::make_unique<ConfigEntry<T>>(key, value_.get()); }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual std::size_t size() const noexcept override { return value_.size(); }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual const void* value(const std::type_info& typeInfo) const noexcept override { return value_.value(typeInfo); }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual bool integral(std::uintmax_t& magnitude, bool& negative) const noexcept override { return value_.integral(magnitude, negative); }
 
-protected:
     /**
      * @brief @see ConfigEntry<void>
      */
-    virtual const void* value(const std::type_info& typeInfo) const override {
-        if (!IntegralCastChecker::check(value_, typeInfo)) {
-            throw ConfigEntryCastError(key_, toString(), Demangler::of<T>(), Demangler::from(typeInfo.name()));
-        }
+    virtual std::size_t valueSize() const noexcept override { return sizeof(ConfigValue<T>); }
 
-        return static_cast<const void*>(&value_);
-    }
+    /**
+     * @brief @see ConfigEntry<void>
+     */
+    virtual std::size_t valueAlignment() const noexcept override { return alignof(ConfigValue<T>); }
+
+    /**
+     * @brief @see ConfigEntry<void>
+     */
+    virtual ConfigValue<>& moveValue(void* pStorage) noexcept override { return *new (pStorage) ConfigValue<T>{value_}; }
 
 private:
-    const T value_;
+    ConfigValue<T> value_;
+};
+
+/**
+ * @brief Config value shared with other values - e.g. a topology variable referenced by many components. The value is neither copied nor parsed
+ * again, it behaves just like the shared one.
+ */
+class SharedConfigValue final : public ConfigValue<> {
+public:
+    /**
+     * @brief Instantiate a value sharing another one.
+     *
+     * @param pShared Entry holding the value (its key is irrelevant).
+     */
+    explicit SharedConfigValue(const std::shared_ptr<const ConfigEntry<>>& pShared) noexcept : pShared_{pShared} {}
+    explicit SharedConfigValue(std::shared_ptr<const ConfigEntry<>>&& pShared) noexcept : pShared_{std::move(pShared)} {}
+    SharedConfigValue(const SharedConfigValue&) = default;
+    SharedConfigValue(SharedConfigValue&&) = default;
+    virtual ~SharedConfigValue() = default;
+
+    /**
+     * @brief Return entry holding the value.
+     *
+     * @return Shared entry pointer.
+     */
+    const std::shared_ptr<const ConfigEntry<>>& shared() const noexcept { return pShared_; }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual const std::string& type() const noexcept override { return pShared_->type(); }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual std::string toString() const noexcept override { return pShared_->toString(); }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual std::size_t size() const noexcept override { return pShared_->size(); }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual const void* value(const std::type_info& typeInfo) const noexcept override { return pShared_->value(typeInfo); }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual bool integral(std::uintmax_t& magnitude, bool& negative) const noexcept override { return pShared_->integral(magnitude, negative); }
+
+private:
+    std::shared_ptr<const ConfigEntry<>> pShared_;   // Not const - moved out of the config entry holding it (@see ConfigEntry::moveValue).
+};
+
+/**
+ * @brief Consists of key and a value shared with other entries - e.g. a topology variable referenced by many components. The value is neither copied
+ * nor parsed again, the entry behaves just like the shared one.
+ */
+class SharedConfigEntry final : public ConfigEntry<> {
+public:
+    /**
+     * @brief Instantiate an entry sharing the value of another one.
+     *
+     * @param key Entry key.
+     * @param pShared Entry holding the value (its key is irrelevant).
+     */
+    SharedConfigEntry(const std::string& key, const std::shared_ptr<const ConfigEntry<>>& pShared) : ConfigEntry<>(key), value_{pShared} {}
+    virtual ~SharedConfigEntry() = default;
+
+    /**
+     * @brief Return entry holding the value.
+     *
+     * @return Shared entry pointer.
+     */
+    const std::shared_ptr<const ConfigEntry<>>& shared() const noexcept { return value_.shared(); }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual const std::string& type() const noexcept override { return value_.type(); }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual std::string toString() const noexcept override { return value_.toString(); }
+
+    /**
+     * @brief @see ConfigEntry<void>
+     */
+    virtual std::unique_ptr<ConfigEntry<>> clone() const override { return std::make_unique<SharedConfigEntry>(key_, value_.shared()); }
+
+    /**
+     * @brief @see ConfigEntry<void>
+     */
+    virtual std::unique_ptr<ConfigEntry<>> clone(const std::string& key) const override { return std::make_unique<SharedConfigEntry>(key, value_.shared()); }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual std::size_t size() const noexcept override { return value_.size(); }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual const void* value(const std::type_info& typeInfo) const noexcept override { return value_.value(typeInfo); }
+
+    /**
+     * @brief @see ConfigValue<void>
+     */
+    virtual bool integral(std::uintmax_t& magnitude, bool& negative) const noexcept override { return value_.integral(magnitude, negative); }
+
+    /**
+     * @brief @see ConfigEntry<void>
+     */
+    virtual std::size_t valueSize() const noexcept override { return sizeof(SharedConfigValue); }
+
+    /**
+     * @brief @see ConfigEntry<void>
+     */
+    virtual std::size_t valueAlignment() const noexcept override { return alignof(SharedConfigValue); }
+
+    /**
+     * @brief @see ConfigEntry<void>
+     */
+    virtual ConfigValue<>& moveValue(void* pStorage) noexcept override { return *new (pStorage) SharedConfigValue{std::move(value_)}; }
+
+private:
+    SharedConfigValue value_;
 };
 
 inline bool operator<(const std::unique_ptr<const ConfigEntry<>>& pFirst, const std::unique_ptr<const ConfigEntry<>>& pSecond) {
@@ -192,4 +655,18 @@ inline bool operator<(const std::string& key, const std::unique_ptr<const Config
  */
 using Config = std::set<std::unique_ptr<const ConfigEntry<>>, std::less<>>;
 
+/**
+ * @brief Return a deep copy of the given config.
+ *
+ * @param config Config to be copied.
+ * @return Config consisting of copies of all the entries.
+ */
+inline Config clone(const Config& config) {
+    Config result;
+    for (const auto& pConfigEntry : config) {
+        result.emplace_hint(result.cend(), pConfigEntry->clone());
+    }
+    return result;
+}
+
 }   // namespace diff
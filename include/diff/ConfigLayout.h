@@ -0,0 +1,336 @@
+#pragma once
+
+/**
+ * @file ConfigLayout.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines ConfigShape, ConfigKey and ConfigLayout classes used to store config of built component instances compactly.
+ * @version 0.1
+ * @date 2025-04-14
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <diff/Config.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace diff {
+
+class ConfigLayout;
+
+/**
+ * @brief Immutable key-to-slot table of a distinct set of config keys. Shapes are interned - all the configs consisting of the same keys (typically
+ * all the instances of a component type) share a single shape object, which lives as long as any of them does (@see ConfigLayout). Looking up the
+ * shape of a config takes no allocation unless the shape is a new one.
+ */
+class ConfigShape final {
+public:
+    /**
+     * @brief Slot returned for keys not in the shape.
+     */
+    static constexpr std::size_t NPOS = static_cast<std::size_t>(-1);
+
+    ConfigShape(const ConfigShape&) = delete;
+    ConfigShape(ConfigShape&&) = delete;
+    ~ConfigShape() = default;
+
+    ConfigShape& operator=(const ConfigShape&) = delete;
+    ConfigShape& operator=(ConfigShape&&) = delete;
+
+    /**
+     * @brief Return keys of the shape, ordered by slot.
+     *
+     * @return Keys reference.
+     */
+    const std::vector<std::string>& keys() const noexcept { return keys_; }
+
+    /**
+     * @brief Return slot of the given key.
+     *
+     * @param key Config key.
+     * @return Slot index or NPOS if the key is not in the shape.
+     */
+    std::size_t slot(const std::string& key) const noexcept {
+        const auto it = std::lower_bound(keys_.cbegin(), keys_.cend(), key);
+        return ((keys_.cend() != it) && (key == *it)) ? static_cast<std::size_t>(it - keys_.cbegin()) : NPOS;
+    }
+
+    /**
+     * @brief Return number of slots.
+     */
+    std::size_t size() const noexcept { return keys_.size(); }
+
+    /**
+     * @brief Return identifier unique among all the shapes ever created by the process (never 0).
+     */
+    std::uint64_t serial() const noexcept { return serial_; }
+
+private:
+    friend class ConfigLayout;
+
+    static constexpr std::size_t BUCKETS = 64u;
+
+    // Shapes alive of the keys hashing to the bucket, linked through the shapes themselves.
+    struct Bucket {
+        std::mutex mutex;
+        ConfigShape* pFirst;
+    };
+
+    // Constant-initialized - exists before any config is built and takes no memory of its own.
+    struct Registry {
+        Bucket buckets[BUCKETS];
+    };
+
+    // Template, so that the registry is defined in the header once for the whole application.
+    template <typename = void>
+    struct Storage {
+        static Registry registry;
+    };
+
+    ConfigShape(const Config& config, std::size_t hash, ConfigShape* pNext) : keys_{}, hash_{hash}, serial_{nextSerial()}, references_{1u}, pNext_{pNext} {
+        keys_.reserve(config.size());
+        for (const std::unique_ptr<const ConfigEntry<>>& pConfigEntry : config) {
+            keys_.emplace_back(pConfigEntry->key());   // Config is ordered by key - so are the slots.
+        }
+    }
+
+    /**
+     * @brief Return the shape of the given config - the existing one if any config of the same keys is alive, a new one otherwise. Shall be released
+     * once no longer used.
+     */
+    static const ConfigShape& acquire(const Config& config) {
+        const std::size_t hash = hashOf(config);
+        Bucket& bucket = Storage<>::registry.buckets[hash % BUCKETS];
+        const std::lock_guard<std::mutex> lock{bucket.mutex};
+        for (ConfigShape* pShape = bucket.pFirst; nullptr != pShape; pShape = pShape->pNext_) {
+            if ((hash == pShape->hash_) &&
+                std::equal(config.cbegin(), config.cend(), pShape->keys_.cbegin(), pShape->keys_.cend(),
+                           [](const std::unique_ptr<const ConfigEntry<>>& pConfigEntry, const std::string& key) { return pConfigEntry->key() == key; })) {
+                ++pShape->references_;
+                return *pShape;
+            }
+        }
+
+        bucket.pFirst = new ConfigShape{config, hash, bucket.pFirst};
+        return *bucket.pFirst;
+    }
+
+    static void release(const ConfigShape& shape) noexcept {
+        ConfigShape* pReleased = nullptr;
+        {
+            Bucket& bucket = Storage<>::registry.buckets[shape.hash_ % BUCKETS];
+            const std::lock_guard<std::mutex> lock{bucket.mutex};
+            for (ConfigShape** ppShape = &bucket.pFirst; nullptr != *ppShape; ppShape = &(*ppShape)->pNext_) {
+                if ((&shape == *ppShape) && (0u == --(*ppShape)->references_)) {
+                    pReleased = *ppShape;
+                    *ppShape = pReleased->pNext_;
+                    break;
+                }
+            }
+        }
+        delete pReleased;
+    }
+
+    // FNV-1a of the keys, each one terminated - so that e.g. {"ab"} and {"a", "b"} differ.
+    static std::size_t hashOf(const Config& config) noexcept {
+        std::uint64_t hash = 14695981039346656037u;
+        for (const std::unique_ptr<const ConfigEntry<>>& pConfigEntry : config) {
+            const std::string& key = pConfigEntry->key();
+            for (std::size_t i = 0u; i <= key.size(); ++i) {
+                hash = (hash ^ static_cast<unsigned char>(key.c_str()[i])) * 1099511628211u;
+            }
+        }
+        return static_cast<std::size_t>(hash);
+    }
+
+    static std::uint64_t nextSerial() noexcept {
+        static std::atomic<std::uint64_t> serial{0u};
+        return ++serial;
+    }
+
+    std::vector<std::string> keys_;
+    const std::size_t hash_;
+    const std::uint64_t serial_;
+    std::size_t references_;   // Guarded by the bucket.
+    ConfigShape* pNext_;       // Guarded by the bucket.
+};
+
+template <typename T>
+ConfigShape::Registry ConfigShape::Storage<T>::registry{};
+
+constexpr std::size_t ConfigShape::NPOS;
+constexpr std::size_t ConfigShape::BUCKETS;
+
+/**
+ * @brief Config key resolving to a slot once per shape - intended as a static member (or function local static) of a component type, so that
+ * repeated reads of the config of its instances, which typically share one shape, skip the key lookup (@see Component::config). Thread safe.
+ */
+class ConfigKey final {
+public:
+    /**
+     * @brief Construct ConfigKey object.
+     *
+     * @param key Config key.
+     */
+    ConfigKey(const std::string& key) : key_{key}, cache_{0u} {}
+
+    ConfigKey(const ConfigKey&) = delete;
+    ConfigKey(ConfigKey&&) = delete;
+    ~ConfigKey() = default;
+
+    ConfigKey& operator=(const ConfigKey&) = delete;
+    ConfigKey& operator=(ConfigKey&&) = delete;
+
+    /**
+     * @brief Return config key.
+     *
+     * @return Key reference.
+     */
+    const std::string& key() const noexcept { return key_; }
+
+    /**
+     * @brief Return slot of the key in the given shape - cached for the shape resolved most recently.
+     *
+     * @param shape Config shape.
+     * @return Slot index or ConfigShape::NPOS if the key is not in the shape.
+     */
+    std::size_t slot(const ConfigShape& shape) const noexcept {
+        // Shape serial and slot packed together, so that a concurrent resolution for another shape is never observed half-written.
+        const std::uint64_t cache = cache_.load(std::memory_order_relaxed);
+        if ((cache >> SLOT_BITS) == shape.serial()) {
+            const std::size_t slot = static_cast<std::size_t>(cache & SLOT_MASK);
+            return (SLOT_MASK == slot) ? ConfigShape::NPOS : slot;
+        }
+
+        const std::size_t slot = shape.slot(key_);
+        if ((shape.size() < SLOT_MASK) && (shape.serial() <= (std::numeric_limits<std::uint64_t>::max() >> SLOT_BITS))) {
+            cache_.store((shape.serial() << SLOT_BITS) | ((ConfigShape::NPOS == slot) ? SLOT_MASK : slot), std::memory_order_relaxed);
+        }
+        return slot;
+    }
+
+private:
+    static constexpr unsigned SLOT_BITS = 16u;
+    static constexpr std::uint64_t SLOT_MASK = (std::uint64_t{1u} << SLOT_BITS) - 1u;
+
+    const std::string key_;
+    mutable std::atomic<std::uint64_t> cache_;
+};
+
+constexpr unsigned ConfigKey::SLOT_BITS;
+constexpr std::uint64_t ConfigKey::SLOT_MASK;
+
+/**
+ * @brief Config of a built component instance - the values ordered by slot of a shared shape (@see ConfigShape), in place of the keyed tree of Config.
+ * Keys are kept by the shape only. The values are moved, rather than copied, into a single allocation - a table of value pointers followed by the
+ * values themselves.
+ */
+class ConfigLayout final {
+public:
+    /**
+     * @brief Construct ConfigLayout object of the values of the given config. Values are moved - shared values (@see SharedConfigEntry) stay
+     * shared - and the config is released.
+     *
+     * @param config Config object, empty afterwards.
+     */
+    explicit ConfigLayout(Config&& config) : pValues_{allocate(config)}, shape_{ConfigShape::acquire(config)} {
+        char* const pStorage = reinterpret_cast<char*>(pValues_.get());
+        std::size_t offset = config.size() * sizeof(ConfigValue<>*);
+        std::size_t slot = 0u;
+        for (const std::unique_ptr<const ConfigEntry<>>& pConfigEntry : config) {
+            // Entries are never defined const, only referred to as such. Keys - and so the order of the config - are left intact.
+            ConfigEntry<>& configEntry = const_cast<ConfigEntry<>&>(*pConfigEntry);
+            offset = align(offset, configEntry.valueAlignment());
+            pValues_[slot++] = &configEntry.moveValue(pStorage + offset);
+            offset += configEntry.valueSize();
+        }
+        config.clear();
+    }
+
+    ConfigLayout(const ConfigLayout&) = delete;
+    ConfigLayout(ConfigLayout&&) = delete;
+    ~ConfigLayout() {
+        for (std::size_t slot = 0u; slot < shape_.size(); ++slot) {
+            pValues_[slot]->~ConfigValue();
+        }
+        ConfigShape::release(shape_);
+    }
+
+    ConfigLayout& operator=(const ConfigLayout&) = delete;
+    ConfigLayout& operator=(ConfigLayout&&) = delete;
+
+    /**
+     * @brief Return shape of the config.
+     *
+     * @return Shape reference.
+     */
+    const ConfigShape& shape() const noexcept { return shape_; }
+
+    /**
+     * @brief Return number of values.
+     */
+    std::size_t size() const noexcept { return shape_.size(); }
+
+    /**
+     * @brief Return value of the given key.
+     *
+     * @param key Config key.
+     * @return Value pointer or nullptr if not found.
+     */
+    const ConfigValue<>* find(const std::string& key) const noexcept { return at(shape_.slot(key)); }
+
+    /**
+     * @brief Return value of the given key, resolving the slot through the cache of the key.
+     *
+     * @param key Config key.
+     * @return Value pointer or nullptr if not found.
+     */
+    const ConfigValue<>* find(const ConfigKey& key) const noexcept { return at(key.slot(shape_)); }
+
+    /**
+     * @brief Return value of the given slot.
+     *
+     * @param slot Slot index.
+     * @return Value pointer or nullptr if the slot is out of range (e.g. ConfigShape::NPOS).
+     */
+    const ConfigValue<>* at(std::size_t slot) const noexcept { return (slot < shape_.size()) ? pValues_[slot] : nullptr; }
+
+    /**
+     * @brief Return key of the given slot.
+     *
+     * @param slot Slot index, less than size().
+     * @return Key reference.
+     */
+    const std::string& key(std::size_t slot) const noexcept { return shape_.keys()[slot]; }
+
+private:
+    struct Deallocator {
+        void operator()(ConfigValue<>** pValues) const noexcept { ::operator delete(pValues); }
+    };
+
+    static std::size_t align(std::size_t offset, std::size_t alignment) noexcept { return (offset + alignment - 1u) / alignment * alignment; }
+
+    // Storage of the values of the config - aligned for any of them, as allocated by the global operator new.
+    static ConfigValue<>** allocate(const Config& config) {
+        if (config.empty()) {
+            return nullptr;
+        }
+
+        std::size_t size = config.size() * sizeof(ConfigValue<>*);
+        for (const std::unique_ptr<const ConfigEntry<>>& pConfigEntry : config) {
+            size = align(size, pConfigEntry->valueAlignment()) + pConfigEntry->valueSize();
+        }
+        return static_cast<ConfigValue<>**>(::operator new(size));
+    }
+
+    const std::unique_ptr<ConfigValue<>*[], Deallocator> pValues_;   // Allocated before the shape is acquired, released if acquiring throws.
+    const ConfigShape& shape_;
+};
+
+}   // namespace diff
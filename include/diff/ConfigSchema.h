@@ -0,0 +1,226 @@
+#pragma once
+
+/**
+ * @file ConfigSchema.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines ConfigSchema class used to declare config entries expected by a component type.
+ * @version 0.1
+ * @date 2025-04-03
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <diff/Config.h>
+#include <diff/Demangler.h>
+#include <diff/Error.h>
+#include <diff/MemoryResource.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace diff {
+
+using namespace std::string_literals;
+
+/**
+ * @brief Config entries expected by a component type - keys, types and optionally ranges. Declared by the component in its static schema method and
+ * published by its factory (@see ComponentMetadata). Empty schema (the default) declares nothing and checks nothing.
+ *
+ * Example:
+ *     static void schema(ConfigSchema &schema) {
+ *         schema.entry<uint16_t>("port"s).range(1024u, 65535u);
+ *         schema.entry<std::string>("name"s).optional();
+ *     }
+ *
+ * Config of a component declaring a schema is checked against it before the component is constructed - by the factory, or for a whole topology at
+ * once (@see TopologyValidator). Each entry is converted to its declared type, so reading it with config<T> needs no cast check.
+ */
+class ConfigSchema final {
+public:
+    /**
+     * @brief Converts an entry to the declared type. Return NONE on success, CONFIG_ENTRY_CAST_ERROR or CONFIG_ENTRY_RANGE_ERROR otherwise. The
+     * converted entry is stored only if pConverted is not nullptr and the entry is not of the declared type already.
+     */
+    using Conversion = std::function<ErrorCode(const ConfigEntry<> &configEntry, std::unique_ptr<const ConfigEntry<>> *pConverted)>;
+
+    /**
+     * @brief Declared entry.
+     */
+    struct Entry {
+        const std::string *pType;
+        bool required;
+        std::string range;   // Empty if not declared.
+        Conversion conversion;
+    };
+
+    /**
+     * @brief Builder of an entry declaration, returned by ConfigSchema::entry.
+     *
+     * @tparam T Declared entry type.
+     */
+    template <typename T>
+    class EntryBuilder final {
+    public:
+        EntryBuilder(Entry &entry) : entry_{entry} {}
+
+        /**
+         * @brief Declare the entry as optional. Entries are required by default.
+         *
+         * @return Builder reference.
+         */
+        EntryBuilder &optional() noexcept {
+            entry_.required = false;
+            return *this;
+        }
+
+        /**
+         * @brief Declare inclusive range of the entry value.
+         *
+         * @param min Minimal value.
+         * @param max Maximal value.
+         * @return Builder reference.
+         */
+        EntryBuilder &range(const T &min, const T &max) {
+            static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value, "Range is applicable to integral types other than bool.");
+
+            entry_.range = "["s + std::to_string(min) + ", "s + std::to_string(max) + "]"s;
+            entry_.conversion = [min, max](const ConfigEntry<> &configEntry, std::unique_ptr<const ConfigEntry<>> *pConverted) {
+                const Result<T> result = configEntry.tryConvert<T>();
+                if (!result) {
+                    return ErrorCode::CONFIG_ENTRY_CAST_ERROR;
+                }
+                if ((result.value() < min) || (max < result.value())) {
+                    return ErrorCode::CONFIG_ENTRY_RANGE_ERROR;
+                }
+                return convert<T>(configEntry, pConverted);
+            };
+            return *this;
+        }
+
+    private:
+        Entry &entry_;
+    };
+
+    /**
+     * @brief Declare an entry.
+     *
+     * @tparam T Entry type - std::string or integral.
+     * @param key Entry key.
+     * @return Builder of the entry declaration.
+     */
+    template <typename T>
+    EntryBuilder<T> entry(const std::string &key) {
+        static_assert(std::is_same<T, std::string>::value || std::is_integral<T>::value, "Config entry type shall be std::string or integral.");
+
+        Entry &entry = entries_[key];
+        entry = Entry{&Demangler::of<T>(), true, ""s, &convert<T>};
+        return EntryBuilder<T>{entry};
+    }
+
+    /**
+     * @brief Return declared entries.
+     *
+     * @return Entries by key.
+     */
+    const std::map<std::string, Entry> &entries() const noexcept { return entries_; }
+
+    /**
+     * @brief Check the given config of a component against the schema. Report all the failures found.
+     *
+     * @param type Component type, for failure descriptions.
+     * @param id Component id, for failure descriptions.
+     * @param config Config to be checked.
+     * @param errors Container to append failures to - ConfigEntryUnexpected, ConfigEntryCastError, ConfigEntryRangeError, ConfigEntryNotFound.
+     */
+    void check(const std::string &type, const std::string &id, const Config &config, std::vector<Error> &errors) const {
+        visit(type, id, config, errors, nullptr);
+    }
+
+    /**
+     * @brief Check the given config of a component against the schema and convert each entry to its declared type.
+     *
+     * @param type Component type, for failure descriptions.
+     * @param id Component id, for failure descriptions.
+     * @param config Config to be checked and converted.
+     * @return The first failure found (@see check).
+     */
+    Result<> apply(const std::string &type, const std::string &id, Config &config) const {
+        if (entries_.empty()) {
+            return {};
+        }
+
+        std::vector<Error> errors;
+        std::vector<std::unique_ptr<const ConfigEntry<>>> converted;
+        visit(type, id, config, errors, &converted);
+        if (!errors.empty()) {
+            return errors.front();
+        }
+
+        for (std::unique_ptr<const ConfigEntry<>> &pConfigEntry : converted) {
+            const auto it = config.find(pConfigEntry->key());
+            config.emplace_hint(config.erase(it), std::move(pConfigEntry));
+        }
+
+        return {};
+    }
+
+private:
+    template <typename T>
+    static ErrorCode convert(const ConfigEntry<> &configEntry, std::unique_ptr<const ConfigEntry<>> *pConverted) {
+        const Result<T> result = configEntry.tryConvert<T>();
+        if (!result) {
+            return ErrorCode::CONFIG_ENTRY_CAST_ERROR;
+        }
+
+        if ((nullptr != pConverted) && (configEntry.type() != Demangler::of<T>())) {
+            *pConverted = std::make_unique<ConfigEntry<T>>(configEntry.key(), result.value());
+        }
+        return ErrorCode::NONE;
+    }
+
+    void visit(const std::string &type, const std::string &id, const Config &config, std::vector<Error> &errors,
+               std::vector<std::unique_ptr<const ConfigEntry<>>> *pConverted) const {
+        if (entries_.empty()) {
+            return;
+        }
+
+        for (const std::unique_ptr<const ConfigEntry<>> &pConfigEntry : config) {
+            if (MemoryResource::reserved(pConfigEntry->key())) {
+                continue;   // Checked when the memory resource is created.
+            }
+            const auto it = entries_.find(pConfigEntry->key());
+            if (entries_.cend() == it) {
+                errors.emplace_back(ErrorCode::CONFIG_ENTRY_UNEXPECTED, type, id, pConfigEntry->key());
+                continue;
+            }
+
+            std::unique_ptr<const ConfigEntry<>> pConvertedEntry;
+            const Entry &entry = it->second;
+            switch (entry.conversion(*pConfigEntry, (nullptr != pConverted) ? &pConvertedEntry : nullptr)) {
+                case ErrorCode::NONE:
+                    if (nullptr != pConvertedEntry) {
+                        pConverted->emplace_back(std::move(pConvertedEntry));
+                    }
+                    break;
+                case ErrorCode::CONFIG_ENTRY_RANGE_ERROR:
+                    errors.emplace_back(ErrorCode::CONFIG_ENTRY_RANGE_ERROR, type, id, pConfigEntry->key(), pConfigEntry->toString(), entry.range);
+                    break;
+                default:
+                    errors.emplace_back(ErrorCode::CONFIG_ENTRY_CAST_ERROR, pConfigEntry->key(), pConfigEntry->toString(), pConfigEntry->type(), *entry.pType);
+                    break;
+            }
+        }
+
+        for (const auto &keyEntry : entries_) {
+            if (keyEntry.second.required && (config.cend() == config.find(keyEntry.first))) {
+                errors.emplace_back(ErrorCode::CONFIG_ENTRY_NOT_FOUND, type, id, keyEntry.first);
+            }
+        }
+    }
+
+    std::map<std::string, Entry> entries_;
+};
+
+}   // namespace diff
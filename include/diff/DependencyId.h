@@ -25,4 +25,105 @@ using DependencyId = std::string;
  */
 using DependencyIds = std::vector<DependencyId>;
 
+/**
+ * @brief Dense integer index of a dependency identifier within a DependencyIdTable. Allows for resolving dependencies without string lookups.
+ */
+using DependencySlot = std::size_t;
+
+/**
+ * @brief Ordered collection of dependency slots, parallel to DependencyIds.
+ */
+using DependencySlots = std::vector<DependencySlot>;
+
+/**
+ * @brief Interprets dependency identifiers used to inject collections of dependencies (@see Dependencies). Such identifier is one of:
+ *  - Plain identifier - selects the single dependency of that identifier.
+ *  - Wildcard pattern - consists of at least one '*' character, which matches any (possibly empty) sequence of characters. E.g. "sensor*" selects
+ * all dependencies with identifiers starting with "sensor".
+ *  - Type pattern - "type:" prefix followed by the dependency type name (fully qualified or not), e.g. "type:ISensor". Selects all dependencies of
+ * the given type.
+ */
+class DependencyIdPattern final {
+public:
+    DependencyIdPattern() = delete;
+
+    /**
+     * @brief Indicate whether the identifier is a wildcard pattern.
+     *
+     * @param pattern Dependency identifier.
+     * @return True if the identifier consists of a wildcard, false otherwise.
+     */
+    static bool isWildcard(const DependencyId &pattern) noexcept { return (std::string::npos != pattern.find('*')); }
+
+    /**
+     * @brief Indicate whether the identifier is a type pattern.
+     *
+     * @param pattern Dependency identifier.
+     * @return True if the identifier is a type pattern, false otherwise.
+     */
+    static bool isType(const DependencyId &pattern) noexcept { return (0u == pattern.compare(0u, TYPE_PREFIX_LENGTH, TYPE_PREFIX)); }
+
+    /**
+     * @brief Indicate whether the type pattern selects dependencies of the given type.
+     *
+     * @param pattern Type pattern.
+     * @param type Demangled dependency type name.
+     * @return True if the pattern names the given type, false otherwise.
+     */
+    static bool matchesType(const DependencyId &pattern, const std::string &type) noexcept {
+        const std::size_t n = pattern.size() - TYPE_PREFIX_LENGTH;
+        if (type.size() < n) {
+            return false;
+        }
+
+        const std::size_t offset = type.size() - n;
+        return (0 == type.compare(offset, n, pattern, TYPE_PREFIX_LENGTH, n)) && ((0u == offset) || (':' == type[offset - 1u]));
+    }
+
+    /**
+     * @brief Return the wildcard pattern prefix - the part preceding the first '*' character. All the identifiers matching the pattern start with it.
+     *
+     * @param pattern Wildcard pattern.
+     * @return Pattern prefix.
+     */
+    static std::string prefix(const DependencyId &pattern) { return pattern.substr(0u, pattern.find('*')); }
+
+    /**
+     * @brief Indicate whether the identifier matches the wildcard pattern.
+     *
+     * @param pattern Wildcard pattern.
+     * @param id Dependency identifier.
+     * @return True if the identifier matches, false otherwise.
+     */
+    static bool matches(const DependencyId &pattern, const std::string &id) noexcept {
+        std::size_t p = 0u, i = 0u;
+        std::size_t pStar = std::string::npos, iStar = 0u;
+
+        while (i < id.size()) {
+            if ((p < pattern.size()) && ('*' == pattern[p])) {
+                pStar = p++;
+                iStar = i;
+            } else if ((p < pattern.size()) && (pattern[p] == id[i])) {
+                ++p;
+                ++i;
+            } else if (std::string::npos != pStar) {
+                p = pStar + 1u;
+                i = ++iStar;
+            } else {
+                return false;
+            }
+        }
+
+        while ((p < pattern.size()) && ('*' == pattern[p])) {
+            ++p;
+        }
+
+        return (pattern.size() == p);
+    }
+
+private:
+    static constexpr const char *TYPE_PREFIX = "type:";
+    static constexpr std::size_t TYPE_PREFIX_LENGTH = 5u;
+};
+
 }   // namespace diff
@@ -0,0 +1,113 @@
+#pragma once
+
+/**
+ * @file DependencyIdTable.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines DependencyIdTable class used to assign dense integer slots to dependency identifiers of a Topology.
+ * @version 0.1
+ * @date 2025-03-21
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <diff/DependencyId.h>
+#include <diff/Topology.h>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace diff {
+
+/**
+ * @brief Immutable mapping of dependency identifiers to dense integer slots, created when a Topology is finalized. Each component instance id and
+ * each dependency id referenced by the topology is assigned a slot. Dependencies registered under those ids are then kept in arrays indexed by
+ * slot (@see DependencyRegistry), so injecting them requires no string lookup.
+ */
+class DependencyIdTable final {
+public:
+    /**
+     * @brief Slot value indicating an identifier not present in the table.
+     */
+    static constexpr DependencySlot NONE = std::numeric_limits<DependencySlot>::max();
+
+    /**
+     * @brief Entry index returned for slots not of a component id.
+     */
+    static constexpr std::size_t NO_ENTRY = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @brief Construct empty table.
+     */
+    DependencyIdTable() = default;
+
+    /**
+     * @brief Construct table of all the identifiers referenced by the topology. Component ids are assigned slots in order of topology entries - an id
+     * shared by many entries (e.g. registered as different types) takes a single slot, so slots and entry indices differ then (@see entry).
+     *
+     * @param topology Topology object.
+     */
+    explicit DependencyIdTable(const Topology &topology) {
+        slots_.reserve(topology.size());
+        entries_.reserve(topology.size());
+        for (std::size_t i = 0u; i < topology.size(); ++i) {
+            if (slots_.emplace(topology[i].id, slots_.size()).second) {
+                entries_.emplace_back(i);
+            }
+        }
+        for (const TopologyEntry &topologyEntry : topology) {
+            for (const DependencyId &dependencyId : topologyEntry.dependencyIds) {
+                slots_.emplace(dependencyId, slots_.size());
+            }
+        }
+    }
+    ~DependencyIdTable() = default;
+
+    /**
+     * @brief Return number of slots.
+     *
+     * @return Number of slots.
+     */
+    std::size_t size() const noexcept { return slots_.size(); }
+
+    /**
+     * @brief Return slot of the given identifier.
+     *
+     * @param id Dependency identifier.
+     * @return Slot, or NONE if the identifier is not present in the table.
+     */
+    DependencySlot find(const std::string &id) const noexcept {
+        const auto it = slots_.find(id);
+        return (slots_.cend() == it) ? NONE : it->second;
+    }
+
+    /**
+     * @brief Return index of the first topology entry of the component id assigned the given slot.
+     *
+     * @param slot Slot of a dependency id.
+     * @return Entry index, or NO_ENTRY if the slot is not of a component id (e.g. of a side dependency id).
+     */
+    std::size_t entry(DependencySlot slot) const noexcept { return (slot < entries_.size()) ? entries_[slot] : NO_ENTRY; }
+
+    /**
+     * @brief Assign slots of dependency ids of all the topology entries (@see TopologyEntry::dependencySlots).
+     *
+     * @param topology Topology object the table was constructed from.
+     */
+    void resolve(Topology &topology) const {
+        for (TopologyEntry &topologyEntry : topology) {
+            topologyEntry.dependencySlots.clear();
+            topologyEntry.dependencySlots.reserve(topologyEntry.dependencyIds.size());
+            for (const DependencyId &dependencyId : topologyEntry.dependencyIds) {
+                topologyEntry.dependencySlots.emplace_back(find(dependencyId));
+            }
+        }
+    }
+
+private:
+    std::unordered_map<std::string, DependencySlot> slots_;
+    std::vector<std::size_t> entries_;   // By slot, of the component ids only.
+};
+
+constexpr std::size_t DependencyIdTable::NO_ENTRY;
+
+}   // namespace diff
@@ -10,10 +10,15 @@
  */
 
 #include <diff/Demangler.h>
+#include <diff/DependencyId.h>
+#include <diff/DependencyIdTable.h>
 #include <diff/Exception.h>
+#include <diff/Span.h>
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <set>
@@ -22,6 +27,15 @@
 
 namespace diff {
 
+/**
+ * @brief Collection of references to dependencies of the same type. A constructor parameter of this type is injected with all the dependencies
+ * selected by a dependency identifier pattern (@see DependencyIdPattern). The collection is resolved once, at construction.
+ *
+ * @tparam T Dependencies type.
+ */
+template <typename T>
+using Dependencies = std::vector<std::reference_wrapper<T>>;
+
 template <typename T = void>
 class DependencyRegister;
 
@@ -111,11 +125,24 @@ public:
      */
     void add(const std::string &id, T &dependency) {
         if (0u != dependencies_.count(id)) {
-            throw DependencyDuplicated(Demangler::of<T>(), id);
+            ErrorHandler::raise(Error{ErrorCode::DEPENDENCY_DUPLICATED, Demangler::of<T>(), id});
         }
         dependencies_.emplace(id, dependency);
     }
 
+    /**
+     * @brief Make registered dependency accessible by slot of its id (@see DependencyIdTable).
+     *
+     * @param slot Dependency slot.
+     * @param dependency Dependency reference.
+     */
+    void bind(DependencySlot slot, T &dependency) {
+        if (slots_.size() <= slot) {
+            slots_.resize(slot + 1u, nullptr);
+        }
+        slots_[slot] = &dependency;
+    }
+
     /**
      * @brief @see DependencyRegister<void>
      */
@@ -159,6 +186,22 @@ public:
         return result;
     }
 
+    /**
+     * @brief Append references to all registered dependencies with ids matching the wildcard pattern (@see DependencyIdPattern).
+     *
+     * @param pattern Wildcard pattern.
+     * @param result Collection to be appended to.
+     */
+    void match(const std::string &pattern, Dependencies<T> &result) const {
+        const std::string prefix = DependencyIdPattern::prefix(pattern);
+
+        for (auto it = dependencies_.lower_bound(prefix); (dependencies_.cend() != it) && (0 == it->first.get().compare(0u, prefix.size(), prefix)); ++it) {
+            if (DependencyIdPattern::matches(pattern, it->first)) {
+                result.emplace_back(it->second);
+            }
+        }
+    }
+
     /**
      * @brief Return reference to the dependency of a given id.
      * @exception DependencyNotFound If no dependency of the requested id is registered.
@@ -167,15 +210,73 @@ public:
      * @return Dependency reference.
      */
     T &get(const std::string &id) const {
+        T *const pDependency = find(id);
+        if (nullptr == pDependency) {
+            ErrorHandler::raise(Error{ErrorCode::DEPENDENCY_NOT_FOUND, Demangler::of<T>(), id});
+        }
+        return *pDependency;
+    }
+
+    /**
+     * @brief Return pointer to the dependency of a given id.
+     *
+     * @param id Dependency id.
+     * @return Dependency pointer, or nullptr if no dependency of the requested id is registered.
+     */
+    T *find(const std::string &id) const noexcept {
         const auto it = dependencies_.find(id);
         if (dependencies_.cend() == it) {
-            throw DependencyNotFound(Demangler::of<T>(), id);
+            return nullptr;
         }
-        return it->second;
+        return &it->second.get();
+    }
+
+    /**
+     * @brief Return pointer to the dependency bound to the given slot.
+     *
+     * @param slot Dependency slot.
+     * @return Dependency pointer, or nullptr if no dependency is bound to the slot.
+     */
+    T *find(DependencySlot slot) const noexcept { return (slot < slots_.size()) ? slots_[slot] : nullptr; }
+
+    /**
+     * @brief Return pointer to the dependency of the id given as a range of characters - with no copy of the id made.
+     *
+     * @param pId Pointer to the first character of the id.
+     * @param size Number of characters of the id.
+     * @return Dependency pointer, or nullptr if no dependency of the requested id is registered.
+     */
+    T *find(const char *pId, std::size_t size) const noexcept {
+        const auto it = dependencies_.find(IdRange{pId, size});
+        if (dependencies_.cend() == it) {
+            return nullptr;
+        }
+        return &it->second.get();
     }
 
 private:
-    std::map<std::reference_wrapper<const std::string>, std::reference_wrapper<T>, std::less<std::string>> dependencies_;
+    struct IdRange {
+        const char *pId;
+        std::size_t size;
+    };
+
+    /**
+     * @brief Orders ids, allows lookup by IdRange.
+     */
+    struct IdLess {
+        using is_transparent = void;
+
+        bool operator()(const std::string &first, const std::string &second) const noexcept { return first < second; }
+        bool operator()(const std::string &first, const IdRange &second) const noexcept {
+            return first.compare(0u, first.size(), second.pId, second.size) < 0;
+        }
+        bool operator()(const IdRange &first, const std::string &second) const noexcept {
+            return 0 < second.compare(0u, second.size(), first.pId, first.size);
+        }
+    };
+
+    std::vector<T *> slots_;
+    std::map<std::reference_wrapper<const std::string>, std::reference_wrapper<T>, IdLess> dependencies_;
 };
 
 inline bool operator<(const std::unique_ptr<DependencyRegister<>> &pFirst, const std::unique_ptr<DependencyRegister<>> &pSecond) {
@@ -187,6 +288,12 @@ inline bool operator<(const std::string &type, const std::unique_ptr<DependencyR
 /**
  * @brief Keeps a record of dependency of multiple types. Aggregates multiple DependencyRegisters and provides an interface for accessing any
  * previously registered dependency. Does not own the registered dependencies.
+ *
+ * A registry may be chained to a parent registry. Dependencies not registered in the registry itsself are then resolved from the parent (and
+ * its ancestors). Local dependencies shadow parent dependencies of the same type and id. The parent is never modified through its child.
+ *
+ * Arrays of dependencies are registered as a single dependency of type Span<T>. Each array element is also available as a dependency of type T,
+ * under the array id suffixed with the element index in square brackets - e.g. "shards[7]".
  */
 class DependencyRegistry final {
 public:
@@ -194,6 +301,16 @@ public:
      * @brief Instantiate empty registry.
      */
     DependencyRegistry() = default;
+
+    /**
+     * @brief Instantiate empty registry chained to the given parent registry. The parent shall outlive this registry.
+     *
+     * @param pParent Parent registry pointer, or nullptr for a standalone registry.
+     * @param pDependencyIdTable Table of slots of the dependency ids (@see get(DependencySlot, const std::string &)), or nullptr if dependencies
+     * are only accessed by ids. The table shall outlive this registry.
+     */
+    explicit DependencyRegistry(const DependencyRegistry *pParent, const DependencyIdTable *pDependencyIdTable = nullptr)
+        : pParent_{pParent}, pDependencyIdTable_{pDependencyIdTable} {}
     ~DependencyRegistry() = default;
 
     /**
@@ -214,6 +331,19 @@ public:
 
         DependencyRegister<T> &dependencyRegister = static_cast<DependencyRegister<T> &>(**it);
         dependencyRegister.add(id, dependency);
+
+        const std::size_t typeSlot = TypeSlot::of<T>();
+        if (registersBySlot_.size() <= typeSlot) {
+            registersBySlot_.resize(typeSlot + 1u, nullptr);
+        }
+        registersBySlot_[typeSlot] = &dependencyRegister;
+
+        if (nullptr != pDependencyIdTable_) {
+            const DependencySlot slot = pDependencyIdTable_->find(id);
+            if (DependencyIdTable::NONE != slot) {
+                dependencyRegister.bind(slot, dependency);
+            }
+        }
     }
 
     /**
@@ -229,7 +359,10 @@ public:
         }
 
         std::vector<std::pair<std::reference_wrapper<const std::string>, std::reference_wrapper<const std::string>>> result;
-        result.reserve(n);
+        if (nullptr != pParent_) {
+            result = pParent_->all();
+        }
+        result.reserve(result.size() + n);
 
         for (const auto &dependencyRegister : dependencyRegisters_) {
             const std::string &type = dependencyRegister->type();
@@ -250,12 +383,7 @@ public:
      */
     template <typename T>
     bool has(const std::string &id) const noexcept {
-        const auto it = dependencyRegisters_.find(Demangler::of<T>());
-        if (dependencyRegisters_.cend() == it) {
-            return false;
-        }
-
-        return (**it).has(id);
+        return (nullptr != find<T>(id));
     }
 
     /**
@@ -266,12 +394,18 @@ public:
      */
     template <typename T /* TODO */>
     std::vector<std::reference_wrapper<T>> get() const noexcept {
-        const auto it = dependencyRegisters_.find(Demangler::of<T>());
-        if (dependencyRegisters_.cend() == it) {
-            return {};
+        std::vector<std::reference_wrapper<T>> result;
+        if (nullptr != pParent_) {
+            result = pParent_->get<T>();
+        }
+
+        const DependencyRegister<T> *const pDependencyRegister = registerOf<T>();
+        if (nullptr != pDependencyRegister) {
+            const std::vector<std::reference_wrapper<T>> local = pDependencyRegister->get();
+            result.insert(result.end(), local.cbegin(), local.cend());
         }
 
-        return static_cast<DependencyRegister<T> &>(**it).get();
+        return result;
     }
 
     /**
@@ -285,12 +419,82 @@ public:
     template <typename T, std::enable_if_t<!std::is_const<T>::value && !std::is_volatile<T>::value, bool> = true>   // TODO chek everywhere else? check for
                                                                                                                     // pointer/array etxc?
                                                                                                                     T &get(const std::string &id) const {
-        const auto it = dependencyRegisters_.find(Demangler::of<T>());
-        if (dependencyRegisters_.cend() == it) {
-            throw DependencyRegisterNotFound(Demangler::of<T>(), id);
+        T *const pDependency = find<T>(id);
+        if (nullptr == pDependency) {
+            if (!hasRegister(Demangler::of<T>()) && !hasRegister(Demangler::of<Span<T>>())) {
+                ErrorHandler::raise(Error{ErrorCode::DEPENDENCY_REGISTER_NOT_FOUND, Demangler::of<T>(), id});
+            }
+            ErrorHandler::raise(Error{ErrorCode::DEPENDENCY_NOT_FOUND, Demangler::of<T>(), id});
         }
 
-        return static_cast<DependencyRegister<T> &>(**it).get(id);
+        return *pDependency;
+    }
+
+    /**
+     * @brief Return reference to the dependency of a given type, slot and id. The dependency is looked up by slot first, which requires no string
+     * lookup. If not found, the lookup falls back to the id (@see get(const std::string &)).
+     * @exception DependencyRegisterNotFound If no dependencies of the requested type are available.
+     * @exception DependencyNotFound If no dependency of the requested type and id is available.
+     *
+     * @tparam T Dependency type. Dependency type is its abstract interface, not the underlying implementing type.
+     * @param slot Slot of the dependency id (@see DependencyIdTable).
+     * @param id Dependency id.
+     * @return Dependency reference.
+     */
+    template <typename T, std::enable_if_t<!std::is_const<T>::value && !std::is_volatile<T>::value, bool> = true>
+    T &get(DependencySlot slot, const std::string &id) const {
+        const DependencyRegister<T> *const pDependencyRegister = registerOf<T>();
+        if (nullptr != pDependencyRegister) {
+            T *const pDependency = pDependencyRegister->find(slot);
+            if (nullptr != pDependency) {
+                return *pDependency;
+            }
+        }
+
+        return get<T>(id);
+    }
+
+    /**
+     * @brief Return references to all dependencies of the given type, selected by the given identifier or identifier pattern (@see
+     * DependencyIdPattern). Dependencies of the parent registry (if any) precede the local ones.
+     * @exception DependencyRegisterNotFound If a plain identifier is given and no dependencies of the requested type are available.
+     * @exception DependencyNotFound If a plain identifier is given and no dependency of the requested type and id is available.
+     *
+     * @tparam T Dependency type. Dependency type is its abstract interface, not the underlying implementing type.
+     * @param pattern Dependency identifier or identifier pattern.
+     * @return Vector of references.
+     */
+    template <typename T, std::enable_if_t<!std::is_const<T>::value && !std::is_volatile<T>::value, bool> = true>
+    Dependencies<T> match(const std::string &pattern) const {
+        if (DependencyIdPattern::isType(pattern)) {
+            return DependencyIdPattern::matchesType(pattern, Demangler::of<T>()) ? get<T>() : Dependencies<T>{};
+        }
+
+        if (!DependencyIdPattern::isWildcard(pattern)) {
+            return Dependencies<T>{get<T>(pattern)};
+        }
+
+        Dependencies<T> result;
+        matchWildcard<T>(pattern, result);
+        return result;
+    }
+
+    /**
+     * @brief Return pointer to the dependency of a given type and id. The lookup falls back to the parent registry (if any). Id of form
+     * "arrayId[index]" is resolved to an element of a registered dependency array.
+     *
+     * @tparam T Dependency type. Dependency type is its abstract interface, not the underlying implementing type.
+     * @param id Dependency id.
+     * @return Dependency pointer, or nullptr if no dependency of the requested type and id is registered.
+     */
+    template <typename T, std::enable_if_t<!std::is_const<T>::value && !std::is_volatile<T>::value, bool> = true>
+    T *find(const std::string &id) const noexcept {
+        T *const pDependency = findDirect<T>(id);
+        if (nullptr != pDependency) {
+            return pDependency;
+        }
+
+        return findIndexed<T>(id);
     }
 
     /**
@@ -321,7 +525,106 @@ public:
     }
 
 private:
+    /**
+     * @brief Assigns dense integer slots to dependency types, so that registers can be accessed without type name lookups.
+     */
+    class TypeSlot final {
+    public:
+        template <typename T>
+        static std::size_t of() noexcept {
+            static const std::size_t slot = next();
+            return slot;
+        }
+
+    private:
+        static std::size_t next() noexcept {
+            static std::atomic<std::size_t> counter{0u};
+            return counter.fetch_add(1u, std::memory_order_relaxed);
+        }
+    };
+
+    template <typename T>
+    const DependencyRegister<T> *registerOf() const noexcept {
+        // Slots are assigned per binary module unless the module shares the counter with the executable (exported symbols) - a slot hit is
+        // trusted only if it holds the register of the very type. Same module - same type name object, otherwise the names are compared.
+        const std::size_t typeSlot = TypeSlot::of<T>();
+        if (typeSlot < registersBySlot_.size()) {
+            const DependencyRegister<> *const pDependencyRegister = registersBySlot_[typeSlot];
+            const std::string &type = Demangler::of<T>();
+            if ((nullptr != pDependencyRegister) && ((&type == &pDependencyRegister->type()) || (type == pDependencyRegister->type()))) {
+                return static_cast<const DependencyRegister<T> *>(pDependencyRegister);
+            }
+        }
+
+        const auto it = dependencyRegisters_.find(Demangler::of<T>());   // type registered by another binary module
+        return (dependencyRegisters_.cend() == it) ? nullptr : static_cast<const DependencyRegister<T> *>(it->get());
+    }
+
+    /**
+     * @brief Return pointer to the dependency of the given id (as accepted by DependencyRegister<T>::find) - with no fallback to arrays.
+     */
+    template <typename T, typename... Id>
+    T *findDirect(const Id &...id) const noexcept {
+        const DependencyRegister<T> *const pDependencyRegister = registerOf<T>();
+        if (nullptr != pDependencyRegister) {
+            T *const pDependency = pDependencyRegister->find(id...);
+            if (nullptr != pDependency) {
+                return pDependency;
+            }
+        }
+
+        return (nullptr != pParent_) ? pParent_->findDirect<T>(id...) : nullptr;
+    }
+
+    template <typename T>
+    void matchWildcard(const std::string &pattern, Dependencies<T> &result) const {
+        if (nullptr != pParent_) {
+            pParent_->matchWildcard<T>(pattern, result);
+        }
+
+        const DependencyRegister<T> *const pDependencyRegister = registerOf<T>();
+        if (nullptr != pDependencyRegister) {
+            pDependencyRegister->match(pattern, result);
+        }
+    }
+
+    template <typename T>
+    T *findIndexed(const std::string &id) const noexcept {
+        const std::size_t n = id.size();
+        const std::size_t pos = id.rfind('[');
+        if ((n < 3u) || (']' != id[n - 1u]) || (std::string::npos == pos) || (0u == pos) || ((pos + 2u) == n)) {
+            return nullptr;
+        }
+
+        // Parsed in place - no allocation, indices not representable are not found.
+        std::size_t index = 0u;
+        for (std::size_t i = pos + 1u; i < (n - 1u); ++i) {
+            if ((id[i] < '0') || ('9' < id[i])) {
+                return nullptr;
+            }
+            const std::size_t digit = static_cast<std::size_t>(id[i] - '0');
+            if (((std::numeric_limits<std::size_t>::max() - digit) / 10u) < index) {
+                return nullptr;
+            }
+            index = (index * 10u) + digit;
+        }
+
+        const Span<T> *const pSpan = findDirect<Span<T>>(id.data(), pos);
+        if ((nullptr == pSpan) || (pSpan->size() <= index)) {
+            return nullptr;
+        }
+
+        return &(*pSpan)[index];
+    }
+
+    bool hasRegister(const std::string &type) const noexcept {
+        return (0u != dependencyRegisters_.count(type)) || ((nullptr != pParent_) && pParent_->hasRegister(type));
+    }
+
+    const DependencyRegistry *const pParent_ = nullptr;
+    const DependencyIdTable *const pDependencyIdTable_ = nullptr;
     std::set<std::unique_ptr<DependencyRegister<>>, std::less<>> dependencyRegisters_;
+    std::vector<DependencyRegister<> *> registersBySlot_;
 };
 
 }   // namespace diff
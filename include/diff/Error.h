@@ -0,0 +1,424 @@
+#pragma once
+
+/**
+ * @file Error.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines Error and Result classes used to report failures without exceptions.
+ * @version 0.1
+ * @date 2025-03-31
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+/**
+ * @brief Exception-free mode. Enabled explicitly, or implicitly if the code is compiled without exceptions support (e.g. -fno-exceptions). In this
+ * mode no framework API throws - failures of the result-returning APIs are reported with Result objects (e.g. TopologyLoader::tryLoad,
+ * Build::create, Component::tryConfig), while failures of the remaining ones are reported to the error handler (@see ErrorHandler).
+ */
+#if !defined(DIFF_NO_EXCEPTIONS) && !defined(__cpp_exceptions) && !defined(__EXCEPTIONS)
+#define DIFF_NO_EXCEPTIONS
+#endif
+
+namespace diff {
+
+using namespace std::string_literals;
+
+/**
+ * @brief Codes of all the failures reported by the framework. Each code corresponds to one exception type (@see Exception.h).
+ */
+enum class ErrorCode : std::uint8_t {
+    NONE = 0u,
+    DEPENDENCY_REGISTER_NOT_FOUND,
+    DEPENDENCY_DUPLICATED,
+    DEPENDENCY_NOT_FOUND,
+    FACTORY_NOT_FOUND,
+    CONFIG_ENTRY_KEY_DUPLICATED,
+    CONFIG_ENTRY_NOT_FOUND,
+    CONFIG_ENTRY_CAST_ERROR,
+    COMPONENT_ID_DUPLICATED,
+    SIDE_DEPENDENCY_ID_EMPTY,
+    SIDE_DEPENDENCY_ID_DUPLICATED,
+    SEALED_TOPOLOGY_MISMATCH,
+    SEALED_TOPOLOGY_SIZE_MISMATCH,
+    SEALED_DEPENDENCY_UNRESOLVED,
+    MODULE_LOAD_ERROR,
+    TOPOLOGY_LOADER_ERROR,
+    MODULE_MANIFEST_ERROR,
+    DEPENDENCY_COUNT_MISMATCH,
+    CONFIG_ENTRY_UNEXPECTED,
+    CONFIG_ENTRY_RANGE_ERROR,
+    CAPACITY_EXCEEDED,
+    MEMORY_LOCK_ERROR,
+    MEMORY_LIMIT_EXCEEDED,
+    MEMORY_RESOURCE_INVALID,
+    DEPENDENCY_TYPE_UNKNOWN,
+    FACTORY_TYPE_MISMATCH,
+
+    // TopologyLoader failures - arguments: component type, component id, config key, config entry type, config entry value (where applicable).
+    TOPOLOGY_FILE_NOT_ACCESSIBLE,
+    TOPOLOGY_SYNTAX_ERROR,
+    TOPOLOGY_NOT_AN_ARRAY,
+    COMPONENT_NOT_AN_OBJECT,
+    COMPONENT_TYPE_MISSING,
+    COMPONENT_TYPE_NOT_A_STRING,
+    COMPONENT_TYPE_EMPTY,
+    COMPONENT_ID_MISSING,
+    COMPONENT_ID_NOT_A_STRING,
+    COMPONENT_ID_EMPTY,
+    DEPENDENCIES_NOT_AN_ARRAY,
+    DEPENDENCY_ID_EMPTY,
+    DEPENDENCY_NOT_A_STRING,
+    CONFIG_NOT_AN_OBJECT,
+    CONFIG_KEY_EMPTY,
+    CONFIG_ENTRY_INVALID_TYPE,
+    CONFIG_ENTRY_OBJECT_SIZE,
+    CONFIG_ENTRY_OBJECT_INVALID_TYPE,
+    CONFIG_ENTRY_NOT_UNSIGNED,
+    CONFIG_ENTRY_NOT_INTEGER,
+    CONFIG_ENTRY_OUT_OF_RANGE,
+
+    // TopologyLoader template failures - arguments: template name, template parameter (where applicable).
+    TEMPLATE_NAME_INVALID,
+    TEMPLATE_DUPLICATED,
+    TEMPLATE_PARAMETERS_INVALID,
+    TEMPLATE_COMPONENTS_NOT_AN_ARRAY,
+    TEMPLATE_PARAMETER_UNKNOWN,
+    TEMPLATE_NOT_FOUND,
+    TEMPLATE_ARGUMENTS_NOT_AN_OBJECT,
+    TEMPLATE_ARGUMENT_UNEXPECTED,
+    TEMPLATE_ARGUMENT_MISSING,
+
+    // TopologyLoader composition failures - arguments: included file path or overlaid component id (where applicable).
+    INCLUDE_PATH_INVALID,
+    INCLUDE_CYCLE,
+    OVERLAY_ID_INVALID,
+    OVERLAY_TARGET_NOT_FOUND,
+
+    // TopologyLoader variable failures - arguments: variable name, or component type, instance id, config key and variable name.
+    VARIABLES_INVALID,
+    VARIABLE_DUPLICATED,
+    VARIABLE_NOT_FOUND
+};
+
+/**
+ * @brief Failure description - error code, its arguments (e.g. component type, instance id or config key) and indices locating the failure within
+ * its source (e.g. index of the topology entry and of its dependency), along with path of the source file if any. Message is formatted only on request.
+ */
+class Error final {
+public:
+    /**
+     * @brief Construct object indicating no failure.
+     */
+    Error() noexcept : code_{ErrorCode::NONE}, entryIndex_{0u}, itemIndex_{0u} {}
+
+    /**
+     * @brief Construct object describing a failure.
+     *
+     * @param code Error code.
+     * @param arguments Error arguments, as required by the code (@see message).
+     */
+    template <typename... Ts>
+    explicit Error(ErrorCode code, Ts &&...arguments)
+        : code_{code}, arguments_{{std::string{std::forward<Ts>(arguments)}...}}, entryIndex_{0u}, itemIndex_{0u} {
+        static_assert(sizeof...(Ts) <= 5u, "Error shall have at most 5 arguments.");
+    }
+
+    /**
+     * @brief Locate the failure within its source.
+     *
+     * @param entryIndex Index of the entry (e.g. topology entry).
+     * @param itemIndex Index of the item within the entry (e.g. dependency).
+     * @return Reference to *this.
+     */
+    Error &at(std::size_t entryIndex, std::size_t itemIndex = 0u) noexcept {
+        entryIndex_ = entryIndex;
+        itemIndex_ = itemIndex;
+        return *this;
+    }
+
+    /**
+     * @brief Name the file the failure is located in (@see at).
+     *
+     * @param path File path.
+     * @return Reference to *this.
+     */
+    Error &in(std::string path) noexcept {
+        path_ = std::move(path);
+        return *this;
+    }
+
+    /**
+     * @brief Return error code.
+     *
+     * @return Error code.
+     */
+    ErrorCode code() const noexcept { return code_; }
+
+    /**
+     * @brief Return error argument of the given index.
+     *
+     * @param index Argument index.
+     * @return Argument reference.
+     */
+    const std::string &argument(std::size_t index) const noexcept { return arguments_[index]; }
+
+    /**
+     * @brief Return index of the entry the failure concerns (@see at).
+     *
+     * @return Entry index.
+     */
+    std::size_t entryIndex() const noexcept { return entryIndex_; }
+
+    /**
+     * @brief Return index of the item within the entry the failure concerns (@see at).
+     *
+     * @return Item index.
+     */
+    std::size_t itemIndex() const noexcept { return itemIndex_; }
+
+    /**
+     * @brief Return path of the file the failure is located in (@see in). Empty if not located in a file.
+     *
+     * @return File path.
+     */
+    const std::string &path() const noexcept { return path_; }
+
+    /**
+     * @brief Format human readable error message.
+     *
+     * @return Error message.
+     */
+    std::string message() const { return path_.empty() ? text() : ("File{\""s + path_ + "\"} : "s + text()); }
+
+private:
+    std::string text() const {
+        const std::array<std::string, 5u> &a = arguments_;
+
+        switch (code_) {
+            case ErrorCode::NONE:
+                return ""s;
+            case ErrorCode::DEPENDENCY_REGISTER_NOT_FOUND:
+            case ErrorCode::DEPENDENCY_NOT_FOUND:
+                return "Dependency "s + a[0] + "{} with id=\""s + a[1] + "\" not found."s;
+            case ErrorCode::DEPENDENCY_DUPLICATED:
+                return "Dependency "s + a[0] + "{} already registered with id=\""s + a[1] + "\"."s;
+            case ErrorCode::FACTORY_NOT_FOUND:
+                return "Factory of "s + a[0] + "{} not registered."s;
+            case ErrorCode::CONFIG_ENTRY_KEY_DUPLICATED:
+                return a[0];
+            case ErrorCode::CONFIG_ENTRY_NOT_FOUND:
+                return "Config entry \""s + a[2] + "\" of component "s + a[0] + "{\""s + a[1] + "\"} not found."s;
+            case ErrorCode::CONFIG_ENTRY_CAST_ERROR:
+                return "Could not cast config entry \""s + a[0] + "\" from "s + a[2] + "{"s + a[1] + "} to "s + a[3] + "."s;
+            case ErrorCode::COMPONENT_ID_DUPLICATED:
+                return "Component id duplicated for component "s + a[0] + "{\""s + a[1] + "\"}."s;
+            case ErrorCode::SIDE_DEPENDENCY_ID_EMPTY:
+                return "Side dependency id empty for component "s + a[0] + "{\""s + a[1] + "\"}."s;
+            case ErrorCode::SIDE_DEPENDENCY_ID_DUPLICATED:
+                return "Side dependency id duplicated for component "s + a[0] + "{\""s + a[1] + "\"}."s;
+            case ErrorCode::SEALED_TOPOLOGY_MISMATCH:
+                return "Topology entry "s + a[0] + "{\""s + a[1] + "\"} does not match the sealed build."s;
+            case ErrorCode::SEALED_TOPOLOGY_SIZE_MISMATCH:
+                return "Topology of "s + a[1] + " entries does not match the sealed build of "s + a[0] + " entries."s;
+            case ErrorCode::SEALED_DEPENDENCY_UNRESOLVED:
+                return "Dependency \""s + a[2] + "\" of component "s + a[0] + "{\""s + a[1] + "\"} can not be sealed."s;
+            case ErrorCode::MODULE_LOAD_ERROR:
+                return "Module \""s + a[0] + "\" could not be loaded. Details: "s + a[1];
+            case ErrorCode::TOPOLOGY_LOADER_ERROR:
+            case ErrorCode::MODULE_MANIFEST_ERROR:
+                return a[0];
+            case ErrorCode::DEPENDENCY_COUNT_MISMATCH:
+                return "Component "s + a[0] + "{\""s + a[1] + "\"} requires "s + a[2] + " dependencies, "s + a[3] + " given."s;
+            case ErrorCode::CONFIG_ENTRY_UNEXPECTED:
+                return "Config entry \""s + a[2] + "\" not expected by component "s + a[0] + "{\""s + a[1] + "\"}."s;
+            case ErrorCode::CONFIG_ENTRY_RANGE_ERROR:
+                return "Config entry \""s + a[2] + "\" of component "s + a[0] + "{\""s + a[1] + "\"} shall be in range "s + a[4] + ", "s + a[3] + " given."s;
+            case ErrorCode::CAPACITY_EXCEEDED:
+                return "Static capacity of "s + a[0] + " exceeded - "s + a[2] + " required, "s + a[1] + " available."s;
+            case ErrorCode::MEMORY_LOCK_ERROR:
+                return "Memory could not be locked. Details: "s + a[0];
+            case ErrorCode::MEMORY_LIMIT_EXCEEDED:
+                return "Memory limit of component "s + a[0] + "{\""s + a[1] + "\"} exceeded - "s + a[3] + " bytes required, "s + a[2] + " available."s;
+            case ErrorCode::MEMORY_RESOURCE_INVALID:
+                return "Memory resource config entry \""s + a[2] + "\" of component "s + a[0] + "{\""s + a[1] + "\"} invalid - "s + a[3] + " given."s;
+            case ErrorCode::DEPENDENCY_TYPE_UNKNOWN:
+                return "Type of dependency \""s + a[2] + "\" of component "s + a[0] + "{\""s + a[1] + "\"} not known."s;
+            case ErrorCode::FACTORY_TYPE_MISMATCH:
+                return "Factory of "s + a[0] + "{} registered as \""s + a[1] + "\" - the type shall be spelled as reported by Demangler."s;
+            case ErrorCode::TOPOLOGY_FILE_NOT_ACCESSIBLE:
+                return "Topology file not accessible. Path: \""s + a[0] + "\"."s;
+            case ErrorCode::TOPOLOGY_SYNTAX_ERROR:
+                return a[0].empty() ? "Topology json syntax error."s : ("Topology json syntax error. Details: \n"s + a[0]);
+            case ErrorCode::TOPOLOGY_NOT_AN_ARRAY:
+                return "Topology json shall be an array."s;
+            case ErrorCode::COMPONENT_NOT_AN_OBJECT:
+                return entry() + " - Component shall be an object."s;
+            case ErrorCode::COMPONENT_TYPE_MISSING:
+                return entry() + " - Component type shall be specified."s;
+            case ErrorCode::COMPONENT_TYPE_NOT_A_STRING:
+                return entry() + " - Component type shall be a string."s;
+            case ErrorCode::COMPONENT_TYPE_EMPTY:
+                return entry() + " - Component type shall not be empty."s;
+            case ErrorCode::COMPONENT_ID_MISSING:
+                return entry() + " - Component id shall be specified."s;
+            case ErrorCode::COMPONENT_ID_NOT_A_STRING:
+                return entry() + " - Component id shall be a string."s;
+            case ErrorCode::COMPONENT_ID_EMPTY:
+                return entry() + " - Component id shall not be empty."s;
+            case ErrorCode::DEPENDENCIES_NOT_AN_ARRAY:
+                return component() + " - Dependencies shall be an array."s;
+            case ErrorCode::DEPENDENCY_ID_EMPTY:
+                return dependency() + " - Dependency id shall not be empty."s;
+            case ErrorCode::DEPENDENCY_NOT_A_STRING:
+                return dependency() + " - Dependency type shall be a string."s;
+            case ErrorCode::CONFIG_NOT_AN_OBJECT:
+                return component() + " - Config shall be an object."s;
+            case ErrorCode::CONFIG_KEY_EMPTY:
+                return component() + " - Config shall not consist of empty keys."s;
+            case ErrorCode::CONFIG_ENTRY_INVALID_TYPE:
+                return component() + " : Config{\""s + a[2] + "\"} - Config entry type shall be one of {bool, ungigned int, signed int, string, object}."s;
+            case ErrorCode::CONFIG_ENTRY_OBJECT_SIZE:
+                return component() + " : Config{\""s + a[2] + "\"} - Config entry object shall be of size 1."s;
+            case ErrorCode::CONFIG_ENTRY_OBJECT_INVALID_TYPE:
+                return component() + " : Config{\""s + a[2] +
+                       "\"} - Config entry object type shall be one of {uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t, uint64_t, int64_t}."s;
+            case ErrorCode::CONFIG_ENTRY_NOT_UNSIGNED:
+                return component() + " : Config{\""s + a[2] + "\", "s + a[3] + "} - Config entry value type shall be unsigned integer."s;
+            case ErrorCode::CONFIG_ENTRY_NOT_INTEGER:
+                return component() + " : Config{\""s + a[2] + "\", "s + a[3] + "} - Config entry value type shall be integer."s;
+            case ErrorCode::CONFIG_ENTRY_OUT_OF_RANGE:
+                return component() + " : Config{\""s + a[2] + "\", "s + a[3] + "{"s + a[4] + "}} - Config entry value shall be in range of its declared type."s;
+            case ErrorCode::TEMPLATE_NAME_INVALID:
+                return entry() + " - Template name shall be a non-empty string."s;
+            case ErrorCode::TEMPLATE_DUPLICATED:
+                return entry() + " : Template{\""s + a[0] + "\"} - Template name shall be unique."s;
+            case ErrorCode::TEMPLATE_PARAMETERS_INVALID:
+                return entry() + " : Template{\""s + a[0] + "\"} - Template parameters shall be an array of unique, non-empty strings."s;
+            case ErrorCode::TEMPLATE_COMPONENTS_NOT_AN_ARRAY:
+                return entry() + " : Template{\""s + a[0] + "\"} - Template components shall be an array."s;
+            case ErrorCode::TEMPLATE_PARAMETER_UNKNOWN:
+                return entry() + " : Template{\""s + a[0] + "\"} - Parameter \""s + a[1] + "\" shall be declared."s;
+            case ErrorCode::TEMPLATE_NOT_FOUND:
+                return entry() + " : Template{\""s + a[0] + "\"} - Template shall be defined before its instantiation."s;
+            case ErrorCode::TEMPLATE_ARGUMENTS_NOT_AN_OBJECT:
+                return entry() + " : Template{\""s + a[0] + "\"} - Template arguments shall be an object."s;
+            case ErrorCode::TEMPLATE_ARGUMENT_UNEXPECTED:
+                return entry() + " : Template{\""s + a[0] + "\"} - Argument \""s + a[1] + "\" shall match a template parameter."s;
+            case ErrorCode::TEMPLATE_ARGUMENT_MISSING:
+                return entry() + " : Template{\""s + a[0] + "\"} - Argument \""s + a[1] + "\" shall be given."s;
+            case ErrorCode::INCLUDE_PATH_INVALID:
+                return entry() + " - Include path shall be a non-empty string."s;
+            case ErrorCode::INCLUDE_CYCLE:
+                return entry() + " : Include{\""s + a[0] + "\"} - Topology file shall not include itself, directly or indirectly."s;
+            case ErrorCode::OVERLAY_ID_INVALID:
+                return entry() + " - Overlay id shall be a non-empty string."s;
+            case ErrorCode::OVERLAY_TARGET_NOT_FOUND:
+                return entry() + " : Overlay{\""s + a[0] + "\"} - Component shall be defined before its overlay."s;
+            case ErrorCode::VARIABLES_INVALID:
+                return entry() + " - Variables shall be an object with non-empty keys."s;
+            case ErrorCode::VARIABLE_DUPLICATED:
+                return entry() + " : Variable{\""s + a[0] + "\"} - Variable name shall be unique."s;
+            case ErrorCode::VARIABLE_NOT_FOUND:
+                return component() + " : Config{\""s + a[2] + "\"} : Variable{\""s + a[3] + "\"} - Variable shall be defined before its use."s;
+        }
+        return ""s;
+    }
+
+    std::string entry() const { return "Component{#"s + std::to_string(entryIndex_) + "}"s; }
+
+    std::string component() const {
+        return "Component{#"s + std::to_string(entryIndex_) + ", \""s + arguments_[0] + "\" : \""s + arguments_[1] + "\"}"s;
+    }
+
+    std::string dependency() const { return component() + " : Dependency{#"s + std::to_string(itemIndex_) + "}"s; }
+
+    ErrorCode code_;
+    std::array<std::string, 5u> arguments_;
+    std::size_t entryIndex_;
+    std::size_t itemIndex_;
+    std::string path_;
+};
+
+/**
+ * @brief Either a value of type T or an Error describing why the value is not available.
+ *
+ * @tparam T Value type. Shall be default constructible.
+ */
+template <typename T = void>
+class Result final {
+public:
+    Result(T value) : value_{std::move(value)} {}
+    Result(Error error) : value_{}, error_{std::move(error)} {}
+
+    /**
+     * @brief Indicate whether the value is available.
+     *
+     * @return True if no failure occured, false otherwise.
+     */
+    bool ok() const noexcept { return ErrorCode::NONE == error_.code(); }
+    explicit operator bool() const noexcept { return ok(); }
+
+    /**
+     * @brief Return the value. Valid only if ok().
+     *
+     * @return Value reference.
+     */
+    T &value() noexcept { return value_; }
+    const T &value() const noexcept { return value_; }
+
+    /**
+     * @brief Return failure description. Valid only if not ok().
+     *
+     * @return Error reference.
+     */
+    const Error &error() const noexcept { return error_; }
+
+private:
+    T value_;
+    Error error_;
+};
+
+/**
+ * @brief Result specialization for references.
+ */
+template <typename T>
+class Result<T &> final {
+public:
+    Result(T &value) noexcept : pValue_{&value} {}
+    Result(Error error) : pValue_{nullptr}, error_{std::move(error)} {}
+
+    bool ok() const noexcept { return ErrorCode::NONE == error_.code(); }
+    explicit operator bool() const noexcept { return ok(); }
+
+    T &value() const noexcept { return *pValue_; }
+
+    const Error &error() const noexcept { return error_; }
+
+private:
+    T *pValue_;
+    Error error_;
+};
+
+/**
+ * @brief Result specialization for operations providing no value.
+ */
+template <>
+class Result<void> final {
+public:
+    Result() = default;
+    Result(Error error) : error_{std::move(error)} {}
+
+    bool ok() const noexcept { return ErrorCode::NONE == error_.code(); }
+    explicit operator bool() const noexcept { return ok(); }
+
+    const Error &error() const noexcept { return error_; }
+
+private:
+    Error error_;
+};
+
+}   // namespace diff
@@ -10,44 +10,85 @@
  * @copyright Copyright (c) 2024
  */
 
+#include <diff/Error.h>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <string>
 
 using namespace std::string_literals;
 
 namespace diff {
 
 /**
- * @brief Base exception type used across diff.
+ * @brief Base exception type used across diff. Carries the Error object it has been raised for. The message is formatted on the first call to what(),
+ * so a caught and handled exception costs no formatting. Copies of the exception share the Error and the message.
  */
 class Exception : public std::logic_error {
+public:
+    /**
+     * @brief Return failure description.
+     *
+     * @return Error reference.
+     */
+    const Error& error() const noexcept { return pState_->error; }
+
+    /**
+     * @brief Return human readable failure message (@see Error::message).
+     *
+     * @return Null-terminated message.
+     */
+    const char* what() const noexcept override {
+        std::call_once(pState_->once, [this]() { pState_->message = pState_->error.message(); });
+        return pState_->message.c_str();
+    }
+
 protected:
-    Exception(const std::string& what) : std::logic_error{what} {}
+    Exception(const Error& error) : std::logic_error{std::string{}}, pState_{std::make_shared<State>(error)} {}
+
+private:
+    struct State {
+        State(const Error& error) : error{error} {}
+
+        const Error error;
+        std::once_flag once;
+        std::string message;
+    };
+
+    std::shared_ptr<State> pState_;
 };
 
 struct DependencyRegisterNotFound : public Exception {
-    DependencyRegisterNotFound(const std::string& type, const std::string& id) : Exception{"Dependency "s + type + "{} with id=\""s + id + "\" not found."s} {}
+    DependencyRegisterNotFound(const std::string& type, const std::string& id) : Exception{Error{ErrorCode::DEPENDENCY_REGISTER_NOT_FOUND, type, id}} {}
+    explicit DependencyRegisterNotFound(const Error& error) : Exception{error} {}
 };
 struct DependencyDuplicated : public Exception {
-    DependencyDuplicated(const std::string& type, const std::string& id)
-        : Exception{"Dependency "s + type + "{} already registered with id=\""s + id + "\"."s} {}
+    DependencyDuplicated(const std::string& type, const std::string& id) : Exception{Error{ErrorCode::DEPENDENCY_DUPLICATED, type, id}} {}
+    explicit DependencyDuplicated(const Error& error) : Exception{error} {}
 };
 
 struct DependencyNotFound : public Exception {
-    DependencyNotFound(const std::string& type, const std::string& id) : Exception{"Dependency "s + type + "{} with id=\""s + id + "\" not found."s} {}
+    DependencyNotFound(const std::string& type, const std::string& id) : Exception{Error{ErrorCode::DEPENDENCY_NOT_FOUND, type, id}} {}
+    explicit DependencyNotFound(const Error& error) : Exception{error} {}
 };
 
 /**
  * @brief Thrown if factory for a certain component type name is requested, but no such factory has been registered.
  */
 struct FactoryNotFound : public Exception {
-    FactoryNotFound(const std::string& type) : Exception{"Factory of "s + type + "{} not registered."s} {}
+    FactoryNotFound(const std::string& type) : Exception{Error{ErrorCode::FACTORY_NOT_FOUND, type}} {}
+    explicit FactoryNotFound(const Error& error) : Exception{error} {}
 };
 
 /**
  * @brief Thrown if config already consist of an entry with the given key.
  */
 struct ConfigEntryKeyDuplicated : public Exception {
-    ConfigEntryKeyDuplicated(const std::string& key) : Exception{key} {}
+    ConfigEntryKeyDuplicated(const std::string& key) : Exception{Error{ErrorCode::CONFIG_ENTRY_KEY_DUPLICATED, key}} {}
+    explicit ConfigEntryKeyDuplicated(const Error& error) : Exception{error} {}
 };
 
 /**
@@ -55,7 +96,8 @@ struct ConfigEntryKeyDuplicated : public Exception {
  */
 struct ConfigEntryNotFound : public Exception {
     ConfigEntryNotFound(const std::string& type, const std::string& id, const std::string& key)
-        : Exception{"TODO CONFIG ENTRY NOT FOUND FOR "s + type + id + key} {}
+        : Exception{Error{ErrorCode::CONFIG_ENTRY_NOT_FOUND, type, id, key}} {}
+    explicit ConfigEntryNotFound(const Error& error) : Exception{error} {}
 };
 
 /**
@@ -67,20 +109,282 @@ struct ConfigEntryNotFound : public Exception {
  */
 struct ConfigEntryCastError : public Exception {
     ConfigEntryCastError(const std::string& key, const std::string& value, const std::string& sourceType, const std::string& targetType)
-        : Exception{"Could not cast config entry \""s + key + "\" from "s + sourceType + "{"s + value + "} to "s + targetType + "."s} {}
+        : Exception{Error{ErrorCode::CONFIG_ENTRY_CAST_ERROR, key, value, sourceType, targetType}} {}
+    explicit ConfigEntryCastError(const Error& error) : Exception{error} {}
 };
 
 /**
  * @brief Thrown if factory for a certain component type name is requested, but no such factory has been registered.
  */
 struct ComponentIdDuplicated : public Exception {
-    ComponentIdDuplicated(const std::string& type, const std::string& id)
-        : Exception{"Component id duplicated for component "s + type + "{\""s + id + "\"}."s} {}
+    ComponentIdDuplicated(const std::string& type, const std::string& id) : Exception{Error{ErrorCode::COMPONENT_ID_DUPLICATED, type, id}} {}
+    explicit ComponentIdDuplicated(const Error& error) : Exception{error} {}
+};
+
+/**
+ * @brief Thrown if a component exposes a side dependency with an empty side-id.
+ */
+struct SideDependencyIdEmpty : public Exception {
+    SideDependencyIdEmpty(const std::string& type, const std::string& id) : Exception{Error{ErrorCode::SIDE_DEPENDENCY_ID_EMPTY, type, id}} {}
+    explicit SideDependencyIdEmpty(const Error& error) : Exception{error} {}
+};
+
+/**
+ * @brief Thrown if a component exposes multiple side dependencies with the same side-id.
+ */
+struct SideDependencyIdDuplicated : public Exception {
+    SideDependencyIdDuplicated(const std::string& type, const std::string& id) : Exception{Error{ErrorCode::SIDE_DEPENDENCY_ID_DUPLICATED, type, id}} {}
+    explicit SideDependencyIdDuplicated(const Error& error) : Exception{error} {}
+};
+
+/**
+ * @brief Thrown if a topology does not define exactly the component instances a SealedBuild was generated for.
+ */
+struct SealedTopologyMismatch : public Exception {
+    SealedTopologyMismatch(const std::string& type, const std::string& id) : Exception{Error{ErrorCode::SEALED_TOPOLOGY_MISMATCH, type, id}} {}
+    SealedTopologyMismatch(std::size_t expected, std::size_t actual)
+        : Exception{Error{ErrorCode::SEALED_TOPOLOGY_SIZE_MISMATCH, std::to_string(expected), std::to_string(actual)}} {}
+    explicit SealedTopologyMismatch(const Error& error) : Exception{error} {}
+};
+
+/**
+ * @brief Thrown if a dependency can not be wired statically - it is not the id of a component instance preceding the dependent one.
+ */
+struct SealedDependencyUnresolved : public Exception {
+    SealedDependencyUnresolved(const std::string& type, const std::string& id, const std::string& dependencyId)
+        : Exception{Error{ErrorCode::SEALED_DEPENDENCY_UNRESOLVED, type, id, dependencyId}} {}
+    explicit SealedDependencyUnresolved(const Error& error) : Exception{error} {}
+};
+
+/**
+ * @brief Thrown if a component module (shared object) can not be loaded.
+ */
+struct ModuleLoadError : public Exception {
+    ModuleLoadError(const std::string& path, const std::string& details) : Exception{Error{ErrorCode::MODULE_LOAD_ERROR, path, details}} {}
+    explicit ModuleLoadError(const Error& error) : Exception{error} {}
+};
+
+/**
+ * @brief Thrown if a topology entry defines fewer dependency ids than the number of constructor parameters of its component type.
+ */
+struct DependencyCountMismatch : public Exception {
+    DependencyCountMismatch(const std::string& type, const std::string& id, std::size_t expected, std::size_t actual)
+        : Exception{Error{ErrorCode::DEPENDENCY_COUNT_MISMATCH, type, id, std::to_string(expected), std::to_string(actual)}} {}
+    explicit DependencyCountMismatch(const Error& error) : Exception{error} {}
+};
+
+/**
+ * @brief Thrown if config consists of an entry not declared by the config schema of the component (@see ConfigSchema).
+ */
+struct ConfigEntryUnexpected : public Exception {
+    ConfigEntryUnexpected(const std::string& type, const std::string& id, const std::string& key)
+        : Exception{Error{ErrorCode::CONFIG_ENTRY_UNEXPECTED, type, id, key}} {}
+    explicit ConfigEntryUnexpected(const Error& error) : Exception{error} {}
+};
+
+/**
+ * @brief Thrown if config entry value is out of range declared by the config schema of the component (@see ConfigSchema).
+ */
+struct ConfigEntryRangeError : public Exception {
+    ConfigEntryRangeError(const std::string& type, const std::string& id, const std::string& key, const std::string& value, const std::string& range)
+        : Exception{Error{ErrorCode::CONFIG_ENTRY_RANGE_ERROR, type, id, key, value, range}} {}
+    explicit ConfigEntryRangeError(const Error& error) : Exception{error} {}
+};
+
+/**
+ * @brief Thrown if topology does not fit in the capacities of the static memory mode (@see StaticCapacity).
+ */
+struct CapacityExceeded : public Exception {
+    CapacityExceeded(const std::string& capacity, std::size_t available, std::size_t required)
+        : Exception{Error{ErrorCode::CAPACITY_EXCEEDED, capacity, std::to_string(available), std::to_string(required)}} {}
+    explicit CapacityExceeded(const Error& error) : Exception{error} {}
+};
+
+/**
+ * @brief Thrown if memory of the process could not be locked (@see RealTime::lockMemory).
+ */
+struct MemoryLockError : public Exception {
+    MemoryLockError(const std::string& details) : Exception{Error{ErrorCode::MEMORY_LOCK_ERROR, details}} {}
+    explicit MemoryLockError(const Error& error) : Exception{error} {}
+};
+
+/**
+ * @brief Thrown if allocation from the memory resource of a component instance exceeds its limit (@see MemoryResource).
+ */
+struct MemoryLimitExceeded : public Exception {
+    MemoryLimitExceeded(const std::string& type, const std::string& id, std::size_t limit, std::size_t required)
+        : Exception{Error{ErrorCode::MEMORY_LIMIT_EXCEEDED, type, id, std::to_string(limit), std::to_string(required)}} {}
+    explicit MemoryLimitExceeded(const Error& error) : Exception{error} {}
+};
+
+/**
+ * @brief Thrown if the memory resource of a component instance is configured incorrectly (@see MemoryResource).
+ */
+struct MemoryResourceInvalid : public Exception {
+    MemoryResourceInvalid(const std::string& type, const std::string& id, const std::string& key, const std::string& value)
+        : Exception{Error{ErrorCode::MEMORY_RESOURCE_INVALID, type, id, key, value}} {}
+    explicit MemoryResourceInvalid(const Error& error) : Exception{error} {}
+};
+
+/**
+ * @brief Thrown if type of a constructor parameter of a component is not known, so the dependency can not be verified (@see TopologyValidator).
+ */
+struct DependencyTypeUnknown : public Exception {
+    DependencyTypeUnknown(const std::string& type, const std::string& id, const std::string& dependencyId)
+        : Exception{Error{ErrorCode::DEPENDENCY_TYPE_UNKNOWN, type, id, dependencyId}} {}
+    explicit DependencyTypeUnknown(const Error& error) : Exception{error} {}
+};
+
+/**
+ * @brief Thrown if a factory descriptor spells the component type differently than Demangler does (@see DIFF_REGISTER_FACTORY).
+ */
+struct FactoryTypeMismatch : public Exception {
+    FactoryTypeMismatch(const std::string& type, const std::string& spelling) : Exception{Error{ErrorCode::FACTORY_TYPE_MISMATCH, type, spelling}} {}
+    explicit FactoryTypeMismatch(const Error& error) : Exception{error} {}
 };
 
 class TopologyLoaderException : public diff::Exception {
 public:
-    TopologyLoaderException(const std::string& what) : diff::Exception{what} {}
+    TopologyLoaderException(const std::string& what) : diff::Exception{Error{ErrorCode::TOPOLOGY_LOADER_ERROR, what}} {}
+    explicit TopologyLoaderException(const Error& error) : diff::Exception{error} {}
+};
+
+class ModuleManifestException : public diff::Exception {
+public:
+    ModuleManifestException(const std::string& what) : diff::Exception{Error{ErrorCode::MODULE_MANIFEST_ERROR, what}} {}
+    explicit ModuleManifestException(const Error& error) : diff::Exception{error} {}
+};
+
+/**
+ * @brief Reports failures of the framework. By default each failure is thrown as the exception type corresponding to its error code. In exception-free
+ * mode (@see DIFF_NO_EXCEPTIONS) the installed handler is called instead and the process is aborted once it returns. The mode shall be the same in all
+ * translation units of a binary.
+ */
+class ErrorHandler final {
+public:
+    using Function = void (*)(const Error&);
+
+    ErrorHandler() = delete;
+
+    /**
+     * @brief Install handler called in exception-free mode. The default one prints the error message to stderr.
+     *
+     * @param function Handler function.
+     * @return Previously installed handler.
+     */
+    static Function set(Function function) noexcept { return handler().exchange(function); }
+
+    /**
+     * @brief Report the given failure. Never returns.
+     * @exception Exception Exception type corresponding to the error code, unless in exception-free mode.
+     *
+     * @param error Failure description.
+     */
+    [[noreturn]] static void raise(const Error& error) {
+#if defined(DIFF_NO_EXCEPTIONS)
+        handler().load()(error);
+#else
+        switch (error.code()) {
+            case ErrorCode::NONE:
+                break;
+            case ErrorCode::DEPENDENCY_REGISTER_NOT_FOUND:
+                throw DependencyRegisterNotFound{error};
+            case ErrorCode::DEPENDENCY_DUPLICATED:
+                throw DependencyDuplicated{error};
+            case ErrorCode::DEPENDENCY_NOT_FOUND:
+                throw DependencyNotFound{error};
+            case ErrorCode::FACTORY_NOT_FOUND:
+                throw FactoryNotFound{error};
+            case ErrorCode::CONFIG_ENTRY_KEY_DUPLICATED:
+                throw ConfigEntryKeyDuplicated{error};
+            case ErrorCode::CONFIG_ENTRY_NOT_FOUND:
+                throw ConfigEntryNotFound{error};
+            case ErrorCode::CONFIG_ENTRY_CAST_ERROR:
+                throw ConfigEntryCastError{error};
+            case ErrorCode::COMPONENT_ID_DUPLICATED:
+                throw ComponentIdDuplicated{error};
+            case ErrorCode::SIDE_DEPENDENCY_ID_EMPTY:
+                throw SideDependencyIdEmpty{error};
+            case ErrorCode::SIDE_DEPENDENCY_ID_DUPLICATED:
+                throw SideDependencyIdDuplicated{error};
+            case ErrorCode::SEALED_TOPOLOGY_MISMATCH:
+            case ErrorCode::SEALED_TOPOLOGY_SIZE_MISMATCH:
+                throw SealedTopologyMismatch{error};
+            case ErrorCode::SEALED_DEPENDENCY_UNRESOLVED:
+                throw SealedDependencyUnresolved{error};
+            case ErrorCode::MODULE_LOAD_ERROR:
+                throw ModuleLoadError{error};
+            case ErrorCode::DEPENDENCY_COUNT_MISMATCH:
+                throw DependencyCountMismatch{error};
+            case ErrorCode::CONFIG_ENTRY_UNEXPECTED:
+                throw ConfigEntryUnexpected{error};
+            case ErrorCode::CONFIG_ENTRY_RANGE_ERROR:
+                throw ConfigEntryRangeError{error};
+            case ErrorCode::CAPACITY_EXCEEDED:
+                throw CapacityExceeded{error};
+            case ErrorCode::MEMORY_LOCK_ERROR:
+                throw MemoryLockError{error};
+            case ErrorCode::MEMORY_LIMIT_EXCEEDED:
+                throw MemoryLimitExceeded{error};
+            case ErrorCode::MEMORY_RESOURCE_INVALID:
+                throw MemoryResourceInvalid{error};
+            case ErrorCode::DEPENDENCY_TYPE_UNKNOWN:
+                throw DependencyTypeUnknown{error};
+            case ErrorCode::FACTORY_TYPE_MISMATCH:
+                throw FactoryTypeMismatch{error};
+            case ErrorCode::TOPOLOGY_LOADER_ERROR:
+            case ErrorCode::TOPOLOGY_FILE_NOT_ACCESSIBLE:
+            case ErrorCode::TOPOLOGY_SYNTAX_ERROR:
+            case ErrorCode::TOPOLOGY_NOT_AN_ARRAY:
+            case ErrorCode::COMPONENT_NOT_AN_OBJECT:
+            case ErrorCode::COMPONENT_TYPE_MISSING:
+            case ErrorCode::COMPONENT_TYPE_NOT_A_STRING:
+            case ErrorCode::COMPONENT_TYPE_EMPTY:
+            case ErrorCode::COMPONENT_ID_MISSING:
+            case ErrorCode::COMPONENT_ID_NOT_A_STRING:
+            case ErrorCode::COMPONENT_ID_EMPTY:
+            case ErrorCode::DEPENDENCIES_NOT_AN_ARRAY:
+            case ErrorCode::DEPENDENCY_ID_EMPTY:
+            case ErrorCode::DEPENDENCY_NOT_A_STRING:
+            case ErrorCode::CONFIG_NOT_AN_OBJECT:
+            case ErrorCode::CONFIG_KEY_EMPTY:
+            case ErrorCode::CONFIG_ENTRY_INVALID_TYPE:
+            case ErrorCode::CONFIG_ENTRY_OBJECT_SIZE:
+            case ErrorCode::CONFIG_ENTRY_OBJECT_INVALID_TYPE:
+            case ErrorCode::CONFIG_ENTRY_NOT_UNSIGNED:
+            case ErrorCode::CONFIG_ENTRY_NOT_INTEGER:
+            case ErrorCode::CONFIG_ENTRY_OUT_OF_RANGE:
+            case ErrorCode::TEMPLATE_NAME_INVALID:
+            case ErrorCode::TEMPLATE_DUPLICATED:
+            case ErrorCode::TEMPLATE_PARAMETERS_INVALID:
+            case ErrorCode::TEMPLATE_COMPONENTS_NOT_AN_ARRAY:
+            case ErrorCode::TEMPLATE_PARAMETER_UNKNOWN:
+            case ErrorCode::TEMPLATE_NOT_FOUND:
+            case ErrorCode::TEMPLATE_ARGUMENTS_NOT_AN_OBJECT:
+            case ErrorCode::TEMPLATE_ARGUMENT_UNEXPECTED:
+            case ErrorCode::TEMPLATE_ARGUMENT_MISSING:
+            case ErrorCode::INCLUDE_PATH_INVALID:
+            case ErrorCode::INCLUDE_CYCLE:
+            case ErrorCode::OVERLAY_ID_INVALID:
+            case ErrorCode::OVERLAY_TARGET_NOT_FOUND:
+            case ErrorCode::VARIABLES_INVALID:
+            case ErrorCode::VARIABLE_DUPLICATED:
+            case ErrorCode::VARIABLE_NOT_FOUND:
+                throw TopologyLoaderException{error};
+            case ErrorCode::MODULE_MANIFEST_ERROR:
+                throw ModuleManifestException{error};
+        }
+#endif
+        std::abort();
+    }
+
+private:
+    static void print(const Error& error) { std::fprintf(stderr, "diff: %s\n", error.message().c_str()); }
+
+    static std::atomic<Function>& handler() noexcept {
+        static std::atomic<Function> instance{&print};
+        return instance;
+    }
 };
 
 }   // namespace diff
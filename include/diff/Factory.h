@@ -10,11 +10,16 @@
  */
 
 #include <diff/Component.h>
+#include <diff/ComponentMetadata.h>
 #include <diff/Demangler.h>
 #include <diff/DependencyId.h>
 #include <diff/DependencyRegistry.h>
+#include <diff/Instances.h>
+#include <diff/Topology.h>
 #include <iostream>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace diff {
 
@@ -47,6 +52,31 @@ public:
      */
     virtual std::unique_ptr<Component<>> build(std::string &id, const DependencyIds &dependencyIds, Config &config, DependencyRegistry &dependencyRegistry) = 0;
 
+    /**
+     * @brief Construct components of the underlying type for consecutive topology entries. All the instances are stored in a single contiguous array.
+     * Each instance is registered in the dependency registry right after its construction, so an entry may depend on any entry preceding it. Ids and
+     * configs are moved out of the topology entries.
+     *
+     * @param pTopologyEntries Pointer to the first of the topology entries.
+     * @param n Number of topology entries.
+     * @param dependencyRegistry Registry of dependencies.
+     * @return Constructed instances.
+     */
+    virtual std::unique_ptr<Instances<>> buildMany(TopologyEntry *pTopologyEntries, std::size_t n, DependencyRegistry &dependencyRegistry) = 0;
+
+    /**
+     * @brief @see buildMany. Ids and configs are copied from the topology entries, which are left intact.
+     */
+    virtual std::unique_ptr<Instances<>> buildMany(const TopologyEntry *pTopologyEntries, std::size_t n, DependencyRegistry &dependencyRegistry) = 0;
+
+    /**
+     * @brief Return metadata of the constructed component type - dependencies it consumes and provides (@see ComponentMetadata). Described on first
+     * use - types of the constructor parameters are resolved from the injections instantiated by the binary (or module) instantiating the factory.
+     *
+     * @return Metadata reference.
+     */
+    virtual const ComponentMetadata &metadata() const noexcept = 0;
+
 protected:
     Factory(const std::string &type) : type_{type} {}
 
@@ -74,59 +104,280 @@ public:
      * @brief @see Factory<void>
      */
     virtual std::unique_ptr<Component<>> build(std::string &id, const DependencyIds &dependencyIds, Config &config, DependencyRegistry &dependencyRegistry) {
+        check(id, dependencyIds);
+        configure(id, config);
+
         Component<T>::initializer_.first = std::move(id);
         Component<T>::initializer_.second = std::move(config);
 
-        std::unique_ptr<T> p_ = Constructor{dependencyRegistry, dependencyIds};
+        std::unique_ptr<T> p_{Constructor{dependencyRegistry, dependencyIds, DependencySlots{}}([](auto &&...injectors) {   //
+            return new T(std::forward<decltype(injectors)>(injectors)...);
+        })};
 
         p_->registerAs(dependencyRegistry);
 
-        return std::move(p_);
+        return p_;
+    }
+
+    /**
+     * @brief @see Factory<void>
+     */
+    virtual std::unique_ptr<Instances<>> buildMany(TopologyEntry *pTopologyEntries, std::size_t n, DependencyRegistry &dependencyRegistry) {
+        return buildMany<TopologyEntry>(pTopologyEntries, n, dependencyRegistry);
+    }
+
+    /**
+     * @brief @see Factory<void>
+     */
+    virtual std::unique_ptr<Instances<>> buildMany(const TopologyEntry *pTopologyEntries, std::size_t n, DependencyRegistry &dependencyRegistry) {
+        return buildMany<const TopologyEntry>(pTopologyEntries, n, dependencyRegistry);
+    }
+
+    /**
+     * @brief @see Factory<void>
+     */
+    virtual const ComponentMetadata &metadata() const noexcept { return metadataInstance(); }
+
+    /**
+     * @brief Construct component of the underlying type in place, injecting the given dependencies directly - without any lookup in the dependency
+     * registry (@see SealedBuild). The constructed component is registered in the dependency registry afterwards.
+     *
+     * @tparam Us Dependency types, typically the concrete component types.
+     * @param pStorage Address of suitably aligned storage for the component instance.
+     * @param id Id to be assigned to the constructed component instance.
+     * @param config Instance config.
+     * @param dependencyRegistry Registry to register the component in.
+     * @param dependencies Dependencies passed to the component constructor.
+     * @return Constructed instance reference.
+     */
+    template <typename... Us>
+    static T &emplace(void *pStorage, std::string &&id, Config &&config, DependencyRegistry &dependencyRegistry, Us &...dependencies) {
+        static_assert(std::is_constructible<T, Reference<Us>...>::value, "Component type shall be constructible from the sealed dependencies.");
+
+        configure(id, config);
+
+        Component<T>::initializer_.first = std::move(id);
+        Component<T>::initializer_.second = std::move(config);
+
+        T &instance = *new (pStorage) T(Reference<Us>{dependencies}...);
+        instance.registerAs(dependencyRegistry);
+
+        return instance;
     }
 
 private:
+    template <typename U>
+    std::unique_ptr<Instances<>> buildMany(U *pTopologyEntries, std::size_t n, DependencyRegistry &dependencyRegistry) {
+        std::unique_ptr<Instances<T>> pInstances = std::make_unique<Instances<T>>(n);
+
+        for (std::size_t i = 0u; i < n; ++i) {
+            U &topologyEntry = pTopologyEntries[i];
+            check(topologyEntry.id, topologyEntry.dependencyIds);
+
+            Component<T>::initializer_.first = take(topologyEntry.id);
+            Component<T>::initializer_.second = take(topologyEntry.config);
+            configure(Component<T>::initializer_.first, Component<T>::initializer_.second);
+
+            const Constructor constructor{dependencyRegistry, topologyEntry.dependencyIds, topologyEntry.dependencySlots};
+            T &instance = pInstances->emplace([&constructor](void *pStorage) {
+                return constructor([pStorage](auto &&...injectors) {   //
+                    return new (pStorage) T(std::forward<decltype(injectors)>(injectors)...);
+                });
+            });
+
+            instance.registerAs(dependencyRegistry);
+        }
+
+        return pInstances;
+    }
+
+    static void check(const std::string &id, const DependencyIds &dependencyIds) {
+        if (dependencyIds.size() < arity()) {
+            ErrorHandler::raise(
+                Error{ErrorCode::DEPENDENCY_COUNT_MISMATCH, Demangler::of<T>(), id, std::to_string(arity()), std::to_string(dependencyIds.size())});
+        }
+    }
+
+    static void configure(const std::string &id, Config &config) {
+        const Result<> result = metadataInstance().config.apply(Demangler::of<T>(), id, config);
+        if (!result) {
+            ErrorHandler::raise(result.error());
+        }
+    }
+
+    static ComponentMetadata &metadataInstance() {
+        static ComponentMetadata instance = describe();
+        return instance;
+    }
+
+    static ComponentMetadata describe() {
+        ComponentMetadata result;
+        result.size = sizeof(T);
+        result.alignment = alignof(T);
+        result.arity = arity();
+        result.parameters = parameters(std::make_index_sequence<arity()>{});
+        T::describe(result);
+        T::schema(result.config);
+        return result;
+    }
+
+    template <std::size_t... Is>
+    static std::vector<ComponentMetadata::Parameter> parameters(std::index_sequence<Is...>) {
+        return {((nullptr != Slot<Is>::pDescribe) ? Slot<Is>::pDescribe() : ComponentMetadata::Parameter{ComponentMetadata::Injection::REFERENCE, nullptr})...};
+    }
+
+    /**
+     * @brief Describes constructor parameter I once the injection of that parameter is instantiated (@see Parameter). Constant-initialized, so set
+     * before any component is described.
+     */
+    template <std::size_t I>
+    struct Slot final {
+        static ComponentMetadata::Parameter (*pDescribe)();
+    };
+
+    /**
+     * @brief Records constructor parameter I in its slot. Instantiated along with the injection of that parameter, and initialized at static
+     * initialization - no component needs to be constructed. Only the describing function is recorded, the type name is resolved by describe().
+     */
+    template <int I, ComponentMetadata::Injection J, typename U>
+    struct Parameter final {
+        static const bool recorded;
+
+        static ComponentMetadata::Parameter describe() { return ComponentMetadata::Parameter{J, &Demangler::of<U>()}; }
+    };
+
+    static std::string &&take(std::string &id) noexcept { return std::move(id); }
+    static std::string take(const std::string &id) { return id; }
+    static Config &&take(Config &config) noexcept { return std::move(config); }
+    static Config take(const Config &config) { return clone(config); }
+
+    template <typename U>
+    struct IsCollection : std::false_type {};
+
+    template <typename U>
+    struct IsCollection<Span<U>> : std::true_type {};
+
+    template <typename U>
+    struct IsCollection<Dependencies<U>> : std::true_type {};
+
+    template <int I>
     class Injector final {
     public:
-        Injector(const DependencyRegistry &dependencyRegistry, const DependencyId &dependencyId)
-            : dependencyRegistry_{dependencyRegistry}, dependencyId_{dependencyId} {}
+        Injector(const DependencyRegistry &dependencyRegistry, const DependencyId &dependencyId, DependencySlot dependencySlot)
+            : dependencyRegistry_{dependencyRegistry}, dependencyId_{dependencyId}, dependencySlot_{dependencySlot} {}
         ~Injector() = default;
 
         template <typename U, typename V = std::remove_cv_t<U>,
-                  std::enable_if_t<!std::is_same<T, V>::value, bool> = true /* Don`t match for implicit copy/move constructor. */>
+                  std::enable_if_t<!std::is_same<T, V>::value && !IsCollection<V>::value, bool> = true /* Don`t match for implicit copy/move constructor. */>
         operator U &() const {
             static_assert(std::is_abstract<V>::value, "Dependency type shall be abstract.");
+            static_cast<void>(Parameter<I, ComponentMetadata::Injection::REFERENCE, V>::recorded);
+
+            return dependencyRegistry_.get<V>(dependencySlot_, dependencyId_);
+        }
+
+        /**
+         * @brief Inject the whole array of dependencies (@see side<Span<U>>).
+         */
+        template <typename U>
+        operator Span<U>() const {
+            static_cast<void>(Parameter<I, ComponentMetadata::Injection::SPAN, U>::recorded);
 
-            return dependencyRegistry_.get<V>(dependencyId_);
+            return dependencyRegistry_.get<Span<U>>(dependencyId_);
+        }
+
+        /**
+         * @brief Inject the collection of dependencies selected by the dependency identifier pattern (@see Dependencies, DependencyIdPattern).
+         */
+        template <typename U>
+        operator Dependencies<U>() const {
+            static_assert(std::is_abstract<U>::value, "Dependency type shall be abstract.");
+            static_cast<void>(Parameter<I, ComponentMetadata::Injection::DEPENDENCIES, U>::recorded);
+
+            return dependencyRegistry_.match<U>(dependencyId_);
         }
 
     private:
         const DependencyRegistry &dependencyRegistry_;
         const DependencyId &dependencyId_;
+        const DependencySlot dependencySlot_;
+    };
+
+    /**
+     * @brief Injects the given dependency as any of its base types (@see emplace).
+     */
+    template <typename U>
+    class Reference final {
+    public:
+        explicit Reference(U &dependency) noexcept : dependency_{dependency} {}
+
+        template <typename V, std::enable_if_t<!std::is_same<T, std::remove_cv_t<V>>::value && std::is_base_of<std::remove_cv_t<V>, U>::value,
+                                               bool> = true /* Don`t match for implicit copy/move constructor. */>
+        operator V &() const noexcept {
+            return dependency_;
+        }
+
+    private:
+        U &dependency_;
     };
 
     class Constructor {
     public:
-        Constructor(const DependencyRegistry &dependencyRegistry, const DependencyIds &dependencyIds)
-            : dependencyRegistry_{dependencyRegistry}, dependencyIds_{dependencyIds} {}
+        Constructor(const DependencyRegistry &dependencyRegistry, const DependencyIds &dependencyIds, const DependencySlots &dependencySlots)
+            : dependencyRegistry_{dependencyRegistry}, dependencyIds_{dependencyIds}, dependencySlots_{dependencySlots} {}
 
-        operator std::unique_ptr<T>() const noexcept { return construct(); }
+        /**
+         * @brief Pass Injector objects to the given callable - exactly as many as required by the constructor of T.
+         *
+         * @tparam F Callable of signature T *(Injector&&...), constructing an instance of T.
+         * @param f Callable to be called.
+         * @return Pointer returned by the callable.
+         */
+        template <typename F>
+        T *operator()(F &&f) const {
+            return construct(std::forward<F>(f));
+        }
 
     private:
-        template <int... Ints>
-        constexpr std::enable_if_t<std::is_constructible<T, decltype((Ints, Injector{DependencyRegistry{}, DependencyId{}}))...>::value, std::unique_ptr<T>>
-        construct() const noexcept {
-            return std::make_unique<T>((Injector{dependencyRegistry_, dependencyIds_[Ints]})...);
+        template <int... Ints, typename F>
+        std::enable_if_t<std::is_constructible<T, Injector<Ints>...>::value, T *> construct(F &&f) const {
+            return f((Injector<Ints>{dependencyRegistry_, dependencyIds_[Ints], slot(Ints)})...);
         }
 
-        template <int... Ints>
-        constexpr std::enable_if_t<!std::is_constructible<T, decltype((Ints, Injector{DependencyRegistry{}, DependencyId{}}))...>::value, std::unique_ptr<T>>
-        construct() const noexcept {
-            return construct<Ints..., sizeof...(Ints)>();
+        template <int... Ints, typename F>
+        std::enable_if_t<!std::is_constructible<T, Injector<Ints>...>::value, T *> construct(F &&f) const {
+            return construct<Ints..., sizeof...(Ints)>(std::forward<F>(f));
+        }
+
+        DependencySlot slot(std::size_t index) const noexcept {
+            return (index < dependencySlots_.size()) ? dependencySlots_[index] : DependencySlot{DependencyIdTable::NONE};
         }
 
         const DependencyRegistry &dependencyRegistry_;
         const DependencyIds &dependencyIds_;
+        const DependencySlots &dependencySlots_;
     };
+
+    /**
+     * @brief Return number of constructor parameters - the lowest number of Injector objects T is constructible from (@see Constructor).
+     */
+    template <int... Ints>
+    static constexpr std::enable_if_t<std::is_constructible<T, Injector<Ints>...>::value, std::size_t> arity() {
+        return sizeof...(Ints);
+    }
+
+    template <int... Ints>
+    static constexpr std::enable_if_t<!std::is_constructible<T, Injector<Ints>...>::value, std::size_t> arity() {
+        return arity<Ints..., sizeof...(Ints)>();
+    }
 };
 
+template <typename T>
+template <std::size_t I>
+ComponentMetadata::Parameter (*Factory<T>::Slot<I>::pDescribe)() = nullptr;
+
+template <typename T>
+template <int I, ComponentMetadata::Injection J, typename U>
+const bool Factory<T>::Parameter<I, J, U>::recorded = (Factory<T>::template Slot<I>::pDescribe = &Parameter::describe, true);
+
 }   // namespace diff
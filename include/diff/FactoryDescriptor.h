@@ -0,0 +1,102 @@
+#pragma once
+
+/**
+ * @file FactoryDescriptor.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines FactoryDescriptor structure and DIFF_REGISTER_FACTORY macro used to register component factories without static initialization.
+ * @version 0.1
+ * @date 2025-03-26
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <diff/Demangler.h>
+#include <diff/Error.h>
+#include <diff/Factory.h>
+
+namespace diff {
+
+/**
+ * @brief Constant descriptor of a component factory - component type name and accessor of the factory object. Descriptors are placed by the linker
+ * in a dedicated section of the binary (@see DIFF_REGISTER_FACTORY) and looked up by FactoryRegistry on first use. Factory object of the given type
+ * is constructed on first access.
+ */
+struct FactoryDescriptor {
+    /**
+     * @brief Return factory object of the given component type. Constructed on first call.
+     *
+     * @tparam T Component type.
+     * @return Factory reference.
+     */
+    template <typename T>
+    static Factory<> &factory() {
+        static Factory<T> instance;
+        return instance;
+    }
+
+    /**
+     * @brief Check that the component type is spelled as reported by Demangler - the spelling is the type name used for the lookup, while the factory
+     * reports the demangled one (@see Factory::type). Checked when the descriptor is collected (@see FactoryRegistry).
+     *
+     * @return Nothing or FactoryTypeMismatch description.
+     */
+    Result<> check() const {
+        const std::string &name = demangled();
+        if (name != type) {
+            return Error{ErrorCode::FACTORY_TYPE_MISMATCH, name, type};
+        }
+        return {};
+    }
+
+    /**
+     * @brief Component type name, as spelled by the registration.
+     */
+    const char *type;
+
+    /**
+     * @brief Accessor of the component type name, as reported by Demangler.
+     */
+    const std::string &(*demangled)();
+
+    /**
+     * @brief Accessor of the factory object.
+     */
+    Factory<> &(*get)();
+};
+
+}   // namespace diff
+
+#define DIFF_CONCATENATE_IMPL(first, second) first##second
+#define DIFF_CONCATENATE(first, second) DIFF_CONCATENATE_IMPL(first, second)
+
+#if defined(__ELF__)
+
+// Delimiters of the section holding factory descriptors, defined by the linker (weak - the section is absent if no descriptors are registered). Each
+// binary or module has its own ones - the section of a module is looked up through them when the module is loaded (@see Module).
+extern "C" const diff::FactoryDescriptor __start_diff_factories[] __attribute__((weak));
+extern "C" const diff::FactoryDescriptor __stop_diff_factories[] __attribute__((weak));
+
+/**
+ * @brief Register factory of the given component type. The type shall be spelled fully qualified, exactly as reported by Demangler (e.g.
+ * DIFF_REGISTER_FACTORY(app::Filter)) - the spelling is the type name used for the lookup. Unlike FactoryRegisterer, the registration requires no
+ * work at startup - a constant descriptor is placed in a dedicated section of the binary and the factory object is constructed on first use. Shall
+ * be used in source files, at namespace scope. Registrations of modules are collected when the module is loaded (@see ModuleLoader). The delimiters
+ * of the section are referenced, so that the linker defines them for the module (the linker defines them only if referenced). Descriptors are
+ * aligned explicitly - otherwise the compiler may align them beyond their size, leaving gaps in the section.
+ */
+#define DIFF_REGISTER_FACTORY(...)                                                                                                                 \
+    __attribute__((used)) static const ::diff::FactoryDescriptor *const DIFF_CONCATENATE(diffFactoryBounds, __COUNTER__)[] = {                     \
+        __start_diff_factories, __stop_diff_factories};                                                                                            \
+    __attribute__((used, section("diff_factories"))) alignas(::diff::FactoryDescriptor) static const ::diff::FactoryDescriptor                     \
+        DIFF_CONCATENATE(diffFactoryDescriptor, __COUNTER__) = {                                                                                   \
+        #__VA_ARGS__, &::diff::Demangler::of<__VA_ARGS__>, &::diff::FactoryDescriptor::factory<__VA_ARGS__>}
+
+#else
+
+#include <diff/FactoryRegisterer.h>
+
+/**
+ * @brief @see DIFF_REGISTER_FACTORY above. Binary format without linker defined section boundaries - falls back to FactoryRegisterer.
+ */
+#define DIFF_REGISTER_FACTORY(...) static ::diff::FactoryRegisterer<__VA_ARGS__> DIFF_CONCATENATE(diffFactoryRegisterer, __COUNTER__)
+
+#endif
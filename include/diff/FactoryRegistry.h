@@ -13,17 +13,32 @@
 
 #include <diff/Exception.h>
 #include <diff/Factory.h>
+#include <diff/FactoryDescriptor.h>
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <map>
+#include <mutex>
 #include <set>
+#include <vector>
 #include <stdexcept>
 
 using namespace std::string_literals;
 
 namespace diff {
 
+class Module;
+
 /**
- * @brief A singleton class. Aggregation point of all Factory<> class objects available within the binary.
+ * @brief A singleton class. Aggregation point of all Factory<> class objects available within the binary - both registered at runtime (@see
+ * FactoryRegisterer) and described by constant descriptors placed in the binary (@see DIFF_REGISTER_FACTORY). Descriptors of the binary are
+ * collected and sorted once, when the singleton is first accessed, and the ones of each module when the module is loaded (@see Module). A
+ * descriptor spelling the type differently than Demangler is rejected when collected (@see FactoryDescriptor::check).
+ *
+ * Factories are looked up in a flat table sorted by hashes of the type names, frozen on first lookup. Registering or unregistering a factory
+ * (e.g. when a module is loaded or unloaded) invalidates the table, which is rebuilt on the next lookup. Lookups are thread-safe, but they shall
+ * not be concurrent with registering or unregistering.
  */
 class FactoryRegistry final {
 public:
@@ -47,8 +62,14 @@ public:
     std::vector<std::reference_wrapper<const std::string>> all() const noexcept {
         std::vector<std::reference_wrapper<const std::string>> result;
 
-        result.reserve(factories_.size());
+        result.reserve(factories_.size() + descriptors_.size());
         std::transform(factories_.cbegin(), factories_.cend(), std::back_inserter(result), [](const Factory<> &factory) { return std::cref(factory.type()); });
+        for (std::size_t i = 0u; i < descriptors_.size(); ++i) {
+            const FactoryDescriptor *const pDescriptor = descriptors_[i];
+            if (!duplicated(i) && (0u == factories_.count(pDescriptor->type))) {
+                result.emplace_back(std::cref(pDescriptor->get().type()));
+            }
+        }
 
         return result;
     }
@@ -59,7 +80,7 @@ public:
      * @param type Component type name.
      * @return True if factory is registered, false otherwise.
      */
-    bool has(const std::string &type) const noexcept { return (0u != factories_.count(type)); }
+    bool has(const std::string &type) const noexcept { return (nullptr != find(hash(type), type)); }
 
     /**
      * @brief Return reference to a factory for the given component type name.
@@ -69,17 +90,35 @@ public:
      * @param type Component type name.
      * @return Factory reference.
      */
-    Factory<> &get(const std::string &type) const {
-        const auto it = factories_.find(type);
-        if (factories_.cend() == it) {
-            throw FactoryNotFound(type);
+    Factory<> &get(const std::string &type) const { return get(hash(type), type); }
+
+    /**
+     * @brief @see get(const std::string &). Use the precomputed hash of the type name (@see hash).
+     *
+     * @param hash Hash of the component type name.
+     * @param type Component type name.
+     * @return Factory reference.
+     */
+    Factory<> &get(std::size_t hash, const std::string &type) const {
+        const Entry *const pEntry = find(hash, type);
+        if (nullptr == pEntry) {
+            ErrorHandler::raise(Error{ErrorCode::FACTORY_NOT_FOUND, type});
         }
-        return it->get();
+        return (nullptr != pEntry->pFactory) ? *pEntry->pFactory : pEntry->pDescriptor->get();
     }
 
+    /**
+     * @brief Return hash of the given component type name, as used for lookups (64-bit FNV-1a).
+     *
+     * @param type Component type name.
+     * @return Hash value.
+     */
+    static std::size_t hash(const std::string &type) noexcept { return hash(type.c_str()); }
+
 private:
     template <typename T>
     friend class FactoryRegisterer;
+    friend class Module;
 
     struct FactoryComparator {
         using is_transparent = void;
@@ -91,11 +130,116 @@ private:
         bool operator()(const std::string &type, const std::reference_wrapper<Factory<>> &factory) const { return type < factory.get().type(); }
     };
 
-    FactoryRegistry() = default;
+    FactoryRegistry() {
+#if defined(__ELF__)
+        if ((nullptr != __start_diff_factories) && (nullptr != __stop_diff_factories)) {
+            collect(__start_diff_factories, __stop_diff_factories);
+        }
+#endif
+    }
+
+    // Descriptors are kept sorted by type, in order of collection within a type - the first one takes precedence over the ones of the same type
+    // (e.g. registered in many files, or by the binary and a module).
+    void collect(const FactoryDescriptor *pFirst, const FactoryDescriptor *pLast) {
+        for (const FactoryDescriptor *pDescriptor = pFirst; pDescriptor != pLast; ++pDescriptor) {
+            const Result<> result = pDescriptor->check();
+            if (!result) {
+                ErrorHandler::raise(result.error());
+            }
+        }
+
+        descriptors_.reserve(descriptors_.size() + (pLast - pFirst));
+        for (const FactoryDescriptor *pDescriptor = pFirst; pDescriptor != pLast; ++pDescriptor) {
+            descriptors_.emplace_back(pDescriptor);
+        }
+        std::stable_sort(descriptors_.begin(), descriptors_.end(),
+                         [](const FactoryDescriptor *pFirst, const FactoryDescriptor *pSecond) { return std::strcmp(pFirst->type, pSecond->type) < 0; });
+    }
+
+    bool duplicated(std::size_t i) const noexcept { return (0u < i) && (0 == std::strcmp(descriptors_[i - 1u]->type, descriptors_[i]->type)); }
 
-    bool add(Factory<> &factory) noexcept { return factories_.emplace(factory).second; }
+    /**
+     * @brief Collect descriptors of the given module (@see Module).
+     */
+    void add(const FactoryDescriptor *pFirst, const FactoryDescriptor *pLast) {
+        const std::lock_guard<std::mutex> lock{mutex_};
+        frozen_.store(false, std::memory_order_relaxed);
+        collect(pFirst, pLast);
+    }
+
+    /**
+     * @brief Drop descriptors of the given module, before it is unloaded (@see Module).
+     */
+    void remove(const FactoryDescriptor *pFirst, const FactoryDescriptor *pLast) noexcept {
+        const std::lock_guard<std::mutex> lock{mutex_};
+        frozen_.store(false, std::memory_order_relaxed);
+        descriptors_.erase(std::remove_if(descriptors_.begin(), descriptors_.end(),
+                                          [pFirst, pLast](const FactoryDescriptor *pDescriptor) { return (pFirst <= pDescriptor) && (pDescriptor < pLast); }),
+                           descriptors_.end());
+    }
+
+    struct Entry {
+        std::size_t hash;
+        const char *type;
+        Factory<> *pFactory;                   // Registered factory, or nullptr if described only.
+        const FactoryDescriptor *pDescriptor;   // Descriptor of a factory constructed on first use.
+    };
+
+    static std::size_t hash(const char *type) noexcept {
+        std::uint64_t result = 14695981039346656037ull;
+        for (; '\0' != *type; ++type) {
+            result = (result ^ static_cast<unsigned char>(*type)) * 1099511628211ull;
+        }
+        return static_cast<std::size_t>(result);
+    }
+
+    const Entry *find(std::size_t hash, const std::string &type) const {
+        if (!frozen_.load(std::memory_order_acquire)) {
+            freeze();
+        }
+
+        auto it = std::lower_bound(table_.cbegin(), table_.cend(), hash, [](const Entry &entry, std::size_t hash) { return entry.hash < hash; });
+        for (; (table_.cend() != it) && (hash == it->hash); ++it) {
+            if (0 == type.compare(it->type)) {
+                return &*it;
+            }
+        }
+        return nullptr;
+    }
+
+    void freeze() const {
+        const std::lock_guard<std::mutex> lock{mutex_};
+        if (frozen_.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        table_.clear();
+        table_.reserve(factories_.size() + descriptors_.size());
+        for (Factory<> &factory : factories_) {
+            table_.emplace_back(Entry{hash(factory.type()), factory.type().c_str(), &factory, nullptr});
+        }
+        for (std::size_t i = 0u; i < descriptors_.size(); ++i) {
+            const FactoryDescriptor *const pDescriptor = descriptors_[i];
+            if (!duplicated(i) && (0u == factories_.count(pDescriptor->type))) {   // registered factory takes precedence
+                table_.emplace_back(Entry{hash(pDescriptor->type), pDescriptor->type, nullptr, pDescriptor});
+            }
+        }
+        std::sort(table_.begin(), table_.end(), [](const Entry &first, const Entry &second) {
+            return (first.hash < second.hash) || ((first.hash == second.hash) && (std::strcmp(first.type, second.type) < 0));
+        });
+
+        frozen_.store(true, std::memory_order_release);
+    }
+
+    bool add(Factory<> &factory) noexcept {
+        const std::lock_guard<std::mutex> lock{mutex_};
+        frozen_.store(false, std::memory_order_relaxed);
+        return factories_.emplace(factory).second;
+    }
 
     void remove(const Factory<> &factory) noexcept {
+        const std::lock_guard<std::mutex> lock{mutex_};
+        frozen_.store(false, std::memory_order_relaxed);
         const auto it = factories_.find(factory.type());
         if (factories_.cend() != it) {
             factories_.erase(it);
@@ -103,6 +247,11 @@ private:
     }
 
     std::set<std::reference_wrapper<Factory<>>, FactoryComparator> factories_;
+    std::vector<const FactoryDescriptor *> descriptors_;
+
+    mutable std::mutex mutex_;
+    mutable std::atomic<bool> frozen_{false};
+    mutable std::vector<Entry> table_;
 };
 
 }   // namespace diff
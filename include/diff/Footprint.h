@@ -0,0 +1,223 @@
+#pragma once
+
+/**
+ * @file Footprint.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines Footprint class used to estimate memory taken by the components of a topology, without building it.
+ * @version 0.1
+ * @date 2025-04-13
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <diff/Config.h>
+#include <diff/ConfigLayout.h>
+#include <diff/Error.h>
+#include <diff/FactoryRegistry.h>
+#include <diff/Topology.h>
+#include <cstddef>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace diff {
+
+/**
+ * @brief Estimate of memory taken by a built topology (@see Build) - component objects, as published by their factories (@see ComponentMetadata),
+ * and the framework structures kept along with them: config values and shapes, dependency registry nodes, dependency id table and strings exceeding
+ * the small string buffer. Framework structures are estimated with the sizes of this build of the framework and typical node layouts of the standard
+ * containers, so the estimate is meant for comparisons and budgets rather than exact accounting. Allocator overhead is not included.
+ */
+class Footprint final {
+public:
+    /**
+     * @brief Estimate of a single topology entry, in bytes.
+     */
+    struct Entry {
+        std::string type;
+        std::string id;
+        std::size_t object;     // Component object.
+        std::size_t config;     // Config values - slots and objects.
+        std::size_t registry;   // Dependency registry nodes of the dependencies provided.
+        std::size_t strings;    // Id and string values - memory beyond the small string buffer. Config keys are held by the shapes.
+
+        std::size_t total() const noexcept { return object + config + registry + strings; }
+
+        /**
+         * @brief Indicate whether the strings of the entry take more memory than the component object itsself.
+         */
+        bool stringDominated() const noexcept { return object < strings; }
+    };
+
+    /**
+     * @brief Estimate of all the instances of a component type.
+     */
+    struct Type {
+        std::size_t size;        // Of a single object.
+        std::size_t alignment;   // Of a single object.
+        std::size_t instances;
+    };
+
+    /**
+     * @brief Construct empty footprint.
+     */
+    Footprint() : components_{0u}, overhead_{0u}, strings_{0u} {}
+
+    /**
+     * @brief Estimate memory footprint of the topology. Factories of all the component types shall be registered (@see FactoryRegistry).
+     *
+     * @param topology Topology object.
+     * @return Footprint or FactoryNotFound description.
+     */
+    static Result<Footprint> estimate(const Topology &topology) {
+        const FactoryRegistry &factoryRegistry = FactoryRegistry::getInstance();
+        const std::size_t buffer = std::string{}.capacity();
+        const auto heap = [buffer](const std::string &text) { return (buffer < text.size()) ? (text.size() + 1u) : 0u; };
+
+        Footprint result;
+        std::set<const ConfigEntry<> *> shared;
+        std::set<std::string> dependencyIds;
+        std::set<std::vector<std::string>> shapes;
+        for (std::size_t i = 0u; i < topology.size(); ++i) {
+            const TopologyEntry &topologyEntry = topology[i];
+            if (!factoryRegistry.has(topologyEntry.type)) {
+                return Error{ErrorCode::FACTORY_NOT_FOUND, topologyEntry.type};
+            }
+            const ComponentMetadata &metadata = factoryRegistry.get(topologyEntry.type).metadata();
+
+            Entry entry{topologyEntry.type, topologyEntry.id, metadata.size, 0u, 0u, heap(topologyEntry.id)};
+            std::vector<std::string> keys;
+            for (const std::unique_ptr<const ConfigEntry<>> &pConfigEntry : topologyEntry.config) {
+                // Value pointer and the value itsself, in the storage of the config layout - the key is held by the shape only.
+                entry.config += sizeof(ConfigValue<> *) + pConfigEntry->valueSize();
+                keys.emplace_back(pConfigEntry->key());
+
+                const SharedConfigEntry *const pSharedEntry = dynamic_cast<const SharedConfigEntry *>(pConfigEntry.get());
+                const ConfigEntry<> &value = (nullptr != pSharedEntry) ? *pSharedEntry->shared() : *pConfigEntry;
+                if ((nullptr != pSharedEntry) && !shared.emplace(&value).second) {
+                    continue;   // Shared value already counted.
+                }
+                if (nullptr != pSharedEntry) {
+                    entry.config += object(value) + sizeof(std::shared_ptr<const ConfigEntry<>>);
+                }
+                if (Demangler::of<std::string>() == value.type()) {
+                    entry.strings += heap(value.value<std::string>());
+                }
+            }
+            shapes.emplace(std::move(keys));
+
+            // Registered under the component id as each of the dependency types provided, and the side dependencies under their own ids.
+            entry.registry = (metadata.provides.size() + metadata.sides.size()) * (NODE + 2u * sizeof(void *) + sizeof(void *));
+
+            for (const DependencyId &dependencyId : topologyEntry.dependencyIds) {
+                dependencyIds.emplace(dependencyId);
+            }
+            dependencyIds.emplace(topologyEntry.id);
+
+            Type &type = result.types_[topologyEntry.type];
+            type.size = metadata.size;
+            type.alignment = metadata.alignment;
+            ++type.instances;
+
+            result.components_ += entry.object;
+            result.overhead_ += entry.config + entry.registry;
+            result.strings_ += entry.strings;
+            result.entries_.emplace_back(std::move(entry));
+        }
+
+        // Dependency id table - hash node (next pointer, key, slot, cached hash) and bucket of each id.
+        for (const std::string &dependencyId : dependencyIds) {
+            result.overhead_ += 3u * sizeof(void *) + sizeof(std::string) + sizeof(std::size_t);
+            result.strings_ += heap(dependencyId);
+        }
+
+        // Config shapes (@see ConfigShape) - shared by the instances of the same config keys, linked into the registry through themselves.
+        for (const std::vector<std::string> &keys : shapes) {
+            result.overhead_ += sizeof(ConfigShape) + keys.size() * sizeof(std::string);
+            for (const std::string &key : keys) {
+                result.strings_ += heap(key);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Return estimates of the topology entries, in order.
+     */
+    const std::vector<Entry> &entries() const noexcept { return entries_; }
+
+    /**
+     * @brief Return estimates of the component types, by type name.
+     */
+    const std::map<std::string, Type> &types() const noexcept { return types_; }
+
+    /**
+     * @brief Return bytes of all the component objects.
+     */
+    std::size_t components() const noexcept { return components_; }
+
+    /**
+     * @brief Return bytes of the framework structures - config values and shapes, registry nodes, dependency id table.
+     */
+    std::size_t overhead() const noexcept { return overhead_; }
+
+    /**
+     * @brief Return bytes of strings beyond the small string buffer.
+     */
+    std::size_t strings() const noexcept { return strings_; }
+
+    /**
+     * @brief Return total bytes.
+     */
+    std::size_t total() const noexcept { return components_ + overhead_ + strings_; }
+
+    /**
+     * @brief Write human readable report - types, entries (marking the ones dominated by strings) and totals.
+     *
+     * @param os Output stream.
+     */
+    void print(std::ostream &os) const {
+        os << "Types:\n";
+        for (const auto &nameType : types_) {
+            const Type &type = nameType.second;
+            os << "  " << std::left << std::setw(40) << nameType.first << std::right << std::setw(8) << type.size << " B x " << std::setw(5)
+               << type.instances << " = " << std::setw(10) << (type.size * type.instances) << " B (align " << type.alignment << ")\n";
+        }
+
+        os << "Entries:\n";
+        for (const Entry &entry : entries_) {
+            os << "  " << std::left << std::setw(40) << (entry.type + "{\"" + entry.id + "\"}") << std::right << " object " << std::setw(8)
+               << entry.object << " B, config " << std::setw(8) << entry.config << " B, registry " << std::setw(6) << entry.registry << " B, strings "
+               << std::setw(8) << entry.strings << " B" << (entry.stringDominated() ? " - dominated by strings" : "") << "\n";
+        }
+
+        os << "Totals:\n";
+        os << "  components " << components_ << " B\n";
+        os << "  framework  " << overhead_ << " B\n";
+        os << "  strings    " << strings_ << " B\n";
+        os << "  total      " << total() << " B\n";
+    }
+
+private:
+    // Node of the ordered containers (color and three pointers) - dependency registry, config shape registry.
+    static constexpr std::size_t NODE = 4u * sizeof(void *);
+
+    static std::size_t object(const ConfigEntry<> &configEntry) noexcept {
+        if (nullptr != dynamic_cast<const SharedConfigEntry *>(&configEntry)) {
+            return sizeof(SharedConfigEntry);
+        }
+        return (Demangler::of<std::string>() == configEntry.type()) ? sizeof(ConfigEntry<std::string>) : sizeof(ConfigEntry<std::uint64_t>);
+    }
+
+    std::vector<Entry> entries_;
+    std::map<std::string, Type> types_;
+    std::size_t components_;
+    std::size_t overhead_;
+    std::size_t strings_;
+};
+
+constexpr std::size_t Footprint::NODE;
+
+}   // namespace diff
@@ -0,0 +1,109 @@
+#pragma once
+
+/**
+ * @file Inspect.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines Inspect class implementing the diff-inspect command line tool, reporting memory footprint of topologies.
+ * @version 0.1
+ * @date 2025-04-13
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <diff/Exception.h>
+#include <diff/Footprint.h>
+#include <diff/TopologyLoader.h>
+#include <diff/TopologyValidator.h>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace diff {
+
+/**
+ * @brief diff-inspect command line tool. Loads a topology against the factories linked into the binary (@see diff_add_inspect in
+ * DiffApplication.cmake), type checks it and reports its estimated memory footprint (@see Footprint) - without instantiating any component.
+ *
+ * Usage: diff-inspect <topology.json>... [--budget <bytes>]
+ *
+ * Multiple files are composed as by TopologyLoader. Exit status is 0 on success, 1 if the total exceeds the budget, 2 if the topology is invalid or
+ * the arguments are - so the tool can gate continuous integration of product topologies.
+ */
+class Inspect final {
+public:
+    Inspect() = delete;
+
+    /**
+     * @brief Run the tool.
+     *
+     * @param argc Number of arguments, including the program name.
+     * @param argv Arguments.
+     * @param os Report stream.
+     * @param es Error stream.
+     * @return Exit status.
+     */
+    static int main(int argc, const char *const *argv, std::ostream &os = std::cout, std::ostream &es = std::cerr) {
+        std::vector<std::string> paths;
+        std::size_t budget = 0u;
+        for (int i = 1; i < argc; ++i) {
+            const std::string argument = argv[i];
+            if ("--budget"s == argument) {
+                char *pEnd = nullptr;
+                budget = ((i + 1) < argc) ? static_cast<std::size_t>(std::strtoull(argv[i + 1], &pEnd, 10)) : 0u;
+                if ((0u == budget) || (nullptr == pEnd) || ('\0' != *pEnd)) {
+                    es << "Budget shall be a positive number of bytes.\n";
+                    return 2;
+                }
+                ++i;
+            } else {
+                paths.emplace_back(argument);
+            }
+        }
+        if (paths.empty()) {
+            es << "Usage: " << ((0 < argc) ? argv[0] : "diff-inspect") << " <topology.json>... [--budget <bytes>]\n";
+            return 2;
+        }
+
+        Topology topology;
+        const Result<> loaded = load(paths, topology);
+        if (!loaded) {
+            es << loaded.error().message() << "\n";
+            return 2;
+        }
+        const std::vector<Error> errors = TopologyValidator::validate(topology);
+        for (const Error &error : errors) {
+            es << error.message() << "\n";
+        }
+        if (!errors.empty()) {
+            return 2;
+        }
+
+        const Result<Footprint> footprint = Footprint::estimate(topology);
+        if (!footprint) {
+            es << footprint.error().message() << "\n";
+            return 2;
+        }
+        footprint.value().print(os);
+
+        if ((0u != budget) && (budget < footprint.value().total())) {
+            es << "Footprint of " << footprint.value().total() << " B exceeds the budget of " << budget << " B.\n";
+            return 1;
+        }
+        return 0;
+    }
+
+private:
+    static Result<> load(const std::vector<std::string> &paths, Topology &topology) {
+#if !defined(DIFF_NO_EXCEPTIONS)
+        try {
+            return TopologyLoader{paths}.tryLoad(topology);
+        } catch (const Exception &exception) {
+            return exception.error();   // Root file not loaded - raised by the constructor.
+        }
+#else
+        return TopologyLoader{paths}.tryLoad(topology);
+#endif
+    }
+};
+
+}   // namespace diff
@@ -0,0 +1,139 @@
+#pragma once
+
+/**
+ * @file Instances.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines Instances class used to own component instances of the same type, stored in a single contiguous array.
+ * @version 0.1
+ * @date 2025-03-14
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <diff/Component.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace diff {
+
+template <typename T = void>
+class Instances;
+
+/**
+ * @brief Abstract base class, a common interface for instantiations of Instances<T != void>.
+ */
+template <>
+class Instances<void> {
+public:
+    virtual ~Instances() = default;
+
+    /**
+     * @brief Return number of owned component instances.
+     *
+     * @return Number of instances.
+     */
+    virtual std::size_t size() const noexcept = 0;
+
+    /**
+     * @brief Return component instance of the given index.
+     *
+     * @param index Instance index, in order of construction.
+     * @return Component instance reference.
+     */
+    virtual Component<> &operator[](std::size_t index) noexcept = 0;
+
+protected:
+    Instances() = default;
+};
+
+/**
+ * @brief Owns component instances of the given type. All the instances are stored in a single contiguous, properly aligned array, allocated once
+ * for the declared capacity. Instances are destructed in reverse order of construction. Over-aligned types are aligned by the class itsself, as
+ * new expressions before C++17 do not honour alignment beyond the fundamental one.
+ *
+ * @tparam T Component type.
+ */
+template <typename T>
+class Instances final : public Instances<> {
+public:
+    Instances() = delete;
+    Instances(const Instances &) = delete;
+    Instances(Instances &&) = delete;
+
+    /**
+     * @brief Allocate storage for the given number of instances. No instance is constructed.
+     *
+     * @param capacity Maximal number of instances.
+     */
+    explicit Instances(std::size_t capacity) : pBlock_{new unsigned char[(capacity * sizeof(Storage)) + PADDING]}, pStorage_{align(pBlock_.get())}, size_{0u} {}
+
+    ~Instances() {
+        while (0u != size_) {
+            --size_;
+            at(size_).~T();
+        }
+    }
+
+    Instances &operator=(const Instances &) = delete;
+    Instances &operator=(Instances &&) = delete;
+
+    /**
+     * @brief Construct next instance in place.
+     *
+     * @tparam F Callable of signature T *(void *), constructing an instance at the given address (with placement new) and returning its pointer.
+     * @param construct Callable constructing the instance.
+     * @return Constructed instance reference.
+     */
+    template <typename F>
+    T &emplace(F &&construct) {
+        T *const pInstance = construct(static_cast<void *>(&pStorage_[size_]));
+        ++size_;
+        return *pInstance;
+    }
+
+    /**
+     * @brief Return pointer to the first instance. Instances are contiguous, so the pointer can be used to iterate over all of them.
+     *
+     * @return Pointer to the first instance.
+     */
+    T *data() noexcept { return &at(0u); }
+
+    /**
+     * @brief @see Instances<void>
+     */
+    std::size_t size() const noexcept override { return size_; }
+
+    /**
+     * @brief @see Instances<void>
+     */
+    Component<> &operator[](std::size_t index) noexcept override { return at(index); }
+
+private:
+    using Storage = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+    // Bytes allocated beyond the array, so that an over-aligned array fits the block.
+    static constexpr std::size_t PADDING = (alignof(std::max_align_t) < alignof(T)) ? (alignof(T) - 1u) : 0u;
+
+    static Storage *align(unsigned char *pBlock) noexcept {
+        return reinterpret_cast<Storage *>((reinterpret_cast<std::uintptr_t>(pBlock) + PADDING) & ~static_cast<std::uintptr_t>(PADDING));
+    }
+
+    T &at(std::size_t index) noexcept {
+#if defined(__cpp_lib_launder)
+        return *std::launder(reinterpret_cast<T *>(&pStorage_[index]));
+#else
+        return *reinterpret_cast<T *>(&pStorage_[index]);
+#endif
+    }
+
+    const std::unique_ptr<unsigned char[]> pBlock_;
+    Storage *const pStorage_;
+    std::size_t size_;
+};
+
+template <typename T>
+constexpr std::size_t Instances<T>::PADDING;
+
+}   // namespace diff
@@ -0,0 +1,406 @@
+#pragma once
+
+/**
+ * @file MemoryResource.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines MemoryResource classes used to give component instances their own, separately accounted memory.
+ * @version 0.1
+ * @date 2025-04-12
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <diff/Config.h>
+#include <diff/ConfigLayout.h>
+#include <diff/Error.h>
+#include <diff/Exception.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+
+/**
+ * @brief Memory resources derive from std::pmr::memory_resource if DIFF_PMR is defined, so they can be used with std::pmr containers directly.
+ * Otherwise they derive from an equivalent interface (@see MemoryResourceBase). The choice changes the layout of components, so it is made for the
+ * whole build rather than per translation unit - DIFF_PMR is defined by the diff CMake target (option DIFF_PMR), which requires C++17 then.
+ */
+#if defined(DIFF_PMR)
+#include <memory_resource>
+#if !defined(__cpp_lib_memory_resource)
+#error "DIFF_PMR requires C++17 with <memory_resource>."
+#endif
+#endif
+
+namespace diff {
+
+#if defined(DIFF_PMR)
+using MemoryResourceBase = std::pmr::memory_resource;
+#else
+/**
+ * @brief Interface of std::pmr::memory_resource, for the standards lacking it (names follow the standard ones).
+ */
+class MemoryResourceBase {
+public:
+    virtual ~MemoryResourceBase() = default;
+
+    void *allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) { return do_allocate(bytes, alignment); }
+    void deallocate(void *p, std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) { do_deallocate(p, bytes, alignment); }
+    bool is_equal(const MemoryResourceBase &other) const noexcept { return do_is_equal(other); }
+
+private:
+    virtual void *do_allocate(std::size_t bytes, std::size_t alignment) = 0;
+    virtual void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) = 0;
+    virtual bool do_is_equal(const MemoryResourceBase &other) const noexcept = 0;
+};
+#endif
+
+/**
+ * @brief Memory resource of a component instance, configured with reserved entries of its config:
+ *  - "memory.resource" - "monotonic" (memory released on destruction only), "pool" (blocks of a few sizes reused) or "bounded" (the global heap),
+ *  - "memory.size" - bytes obtained at once from the global heap by monotonic and pool resources (4096 by default),
+ *  - "memory.limit" - bytes the resource may hold at once (unlimited by default) - for monotonic and pool resources bytes obtained from the global
+ *    heap, for bounded resource bytes allocated.
+ * Allocation exceeding the limit raises MemoryLimitExceeded. Resources are synchronized - can be used from multiple threads.
+ *
+ * Resource keeps its usage statistics - bytes held, the maximum of bytes held and number of allocations refused due to the limit.
+ */
+class MemoryResource : public MemoryResourceBase {
+public:
+    virtual ~MemoryResource() = default;
+
+    /**
+     * @brief Return whether the config key is reserved for the memory resource configuration - not passed through the config schema check.
+     *
+     * @param key Config key.
+     * @return True if reserved, false otherwise.
+     */
+    static bool reserved(const std::string &key) noexcept { return 0 == key.compare(0u, 7u, "memory."); }
+
+    /**
+     * @brief Create memory resource as configured.
+     * @exception MemoryResourceInvalid If the configuration is invalid.
+     *
+     * @param type Type of the component instance.
+     * @param id Id of the component instance. Referenced by the resource.
+     * @param config Config of the component instance.
+     * @return Resource pointer, or nullptr if not configured.
+     */
+    static std::unique_ptr<MemoryResource> create(const std::string &type, const std::string &id, const ConfigLayout &config);
+
+    /**
+     * @brief Return process-wide resource, the global heap, for the component instances not configured with their own one. Unlimited.
+     *
+     * @return Resource reference.
+     */
+    static MemoryResource &global();
+
+    /**
+     * @brief Return number of bytes held.
+     *
+     * @return Bytes held.
+     */
+    std::size_t used() const noexcept { return used_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Return the maximum number of bytes held so far.
+     *
+     * @return High-water mark in bytes.
+     */
+    std::size_t peak() const noexcept { return peak_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Return limit of bytes held.
+     *
+     * @return Limit in bytes, std::numeric_limits<std::size_t>::max() if unlimited.
+     */
+    std::size_t limit() const noexcept { return limit_; }
+
+    /**
+     * @brief Return number of allocations refused due to the limit.
+     *
+     * @return Number of limit violations.
+     */
+    std::size_t violations() const noexcept { return violations_.load(std::memory_order_relaxed); }
+
+protected:
+    MemoryResource(const std::string &type, const std::string &id, std::size_t limit) noexcept
+        : type_{type}, id_{id}, limit_{limit}, used_{0u}, peak_{0u}, violations_{0u} {}
+
+    /**
+     * @brief Obtain memory from the global heap, within the limit.
+     */
+    void *acquire(std::size_t bytes, std::size_t alignment) {
+        std::size_t used = used_.load(std::memory_order_relaxed);
+        do {
+            if (limit_ - used < bytes) {
+                violations_.fetch_add(1u, std::memory_order_relaxed);
+                ErrorHandler::raise(Error{ErrorCode::MEMORY_LIMIT_EXCEEDED, type_, id_, std::to_string(limit_), std::to_string(used + bytes)});
+            }
+        } while (!used_.compare_exchange_weak(used, used + bytes, std::memory_order_relaxed));
+
+        std::size_t peak = peak_.load(std::memory_order_relaxed);
+        while ((peak < used + bytes) && !peak_.compare_exchange_weak(peak, used + bytes, std::memory_order_relaxed)) {
+        }
+
+        if (alignment <= alignof(std::max_align_t)) {
+            return ::operator new(bytes);
+        }
+        // Over-aligned - pointer to the whole block stored right before the aligned one.
+        unsigned char *const pBlock = static_cast<unsigned char *>(::operator new(bytes + alignment + sizeof(void *)));
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(pBlock + sizeof(void *));
+        void **const pAligned = reinterpret_cast<void **>((address + alignment - 1u) & ~static_cast<std::uintptr_t>(alignment - 1u));
+        pAligned[-1] = pBlock;
+        return pAligned;
+    }
+
+    /**
+     * @brief Return memory obtained with acquire to the global heap.
+     */
+    void release(void *p, std::size_t bytes, std::size_t alignment) noexcept {
+        used_.fetch_sub(bytes, std::memory_order_relaxed);
+        ::operator delete((alignment <= alignof(std::max_align_t)) ? p : static_cast<void **>(p)[-1]);
+    }
+
+    bool do_is_equal(const MemoryResourceBase &other) const noexcept override { return this == &other; }
+
+private:
+    const std::string &type_;
+    const std::string &id_;
+    const std::size_t limit_;
+
+    std::atomic<std::size_t> used_;
+    std::atomic<std::size_t> peak_;
+    std::atomic<std::size_t> violations_;
+};
+
+/**
+ * @brief Resource allocating from the global heap, with the limit applied to the bytes allocated.
+ */
+class BoundedResource final : public MemoryResource {
+public:
+    BoundedResource(const std::string &type, const std::string &id, std::size_t limit) noexcept : MemoryResource{type, id, limit} {}
+    ~BoundedResource() = default;
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override { return acquire(bytes, alignment); }
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override { release(p, bytes, alignment); }
+};
+
+/**
+ * @brief Resource serving allocations in order from chunks obtained from the global heap, each twice the size of the previous one. Deallocation has
+ * no effect - chunks are released on destruction.
+ */
+class MonotonicResource final : public MemoryResource {
+public:
+    MonotonicResource(const std::string &type, const std::string &id, std::size_t limit, std::size_t size) noexcept
+        : MemoryResource{type, id, limit}, pChunk_{nullptr}, p_{nullptr}, remaining_{0u}, size_{std::max<std::size_t>(size, 64u)} {}
+
+    ~MonotonicResource() {
+        while (nullptr != pChunk_) {
+            Chunk *const pNext = pChunk_->pNext;
+            release(pChunk_, pChunk_->size, alignof(Chunk));
+            pChunk_ = pNext;
+        }
+    }
+
+private:
+    struct alignas(std::max_align_t) Chunk {
+        Chunk *pNext;
+        std::size_t size;
+    };
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        const std::lock_guard<std::mutex> lock{mutex_};
+        void *p = p_;
+        if ((nullptr == p) || (nullptr == std::align(alignment, bytes, p, remaining_))) {
+            const std::size_t size = std::max(size_, sizeof(Chunk) + bytes + alignment);
+            Chunk *const pChunk = static_cast<Chunk *>(acquire(size, alignof(Chunk)));
+            pChunk_ = new (pChunk) Chunk{pChunk_, size};
+            size_ *= 2u;
+
+            p = pChunk_ + 1;
+            remaining_ = size - sizeof(Chunk);
+            std::align(alignment, bytes, p, remaining_);
+        }
+        p_ = static_cast<unsigned char *>(p) + bytes;
+        remaining_ -= bytes;
+        return p;
+    }
+
+    void do_deallocate(void *, std::size_t, std::size_t) override {}
+
+    std::mutex mutex_;
+    Chunk *pChunk_;
+    void *p_;
+    std::size_t remaining_;
+    std::size_t size_;   // Of the next chunk.
+};
+
+/**
+ * @brief Resource keeping lists of free blocks of sizes 8 to 1024 bytes (powers of two), carved from chunks obtained from the global heap - e.g. for
+ * messages allocated and deallocated repeatedly. Larger or over-aligned blocks are allocated from the global heap directly. Chunks are released on
+ * destruction.
+ */
+class PoolResource final : public MemoryResource {
+public:
+    PoolResource(const std::string &type, const std::string &id, std::size_t limit, std::size_t size) noexcept
+        : MemoryResource{type, id, limit}, pChunk_{nullptr}, free_{}, size_{std::max<std::size_t>(size, 2u * MAX_BLOCK)} {}
+
+    ~PoolResource() {
+        while (nullptr != pChunk_) {
+            Chunk *const pNext = pChunk_->pNext;
+            release(pChunk_, size_, alignof(Chunk));
+            pChunk_ = pNext;
+        }
+    }
+
+private:
+    static constexpr std::size_t MIN_BLOCK = 8u;
+    static constexpr std::size_t MAX_BLOCK = 1024u;
+    static constexpr std::size_t CLASSES = 8u;
+
+    struct alignas(std::max_align_t) Chunk {
+        Chunk *pNext;
+    };
+
+    struct Block {
+        Block *pNext;
+    };
+
+    static std::size_t index(std::size_t bytes) noexcept {
+        std::size_t result = 0u;
+        while ((MIN_BLOCK << result) < bytes) {
+            ++result;
+        }
+        return result;
+    }
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        if ((MAX_BLOCK < bytes) || (alignof(std::max_align_t) < alignment)) {
+            return acquire(bytes, alignment);
+        }
+
+        const std::size_t i = index(std::max(bytes, alignment));
+        const std::lock_guard<std::mutex> lock{mutex_};
+        if (nullptr == free_[i]) {
+            Chunk *const pChunk = static_cast<Chunk *>(acquire(size_, alignof(Chunk)));
+            pChunk_ = new (pChunk) Chunk{pChunk_};
+
+            const std::size_t block = MIN_BLOCK << i;
+            unsigned char *const pFirst = reinterpret_cast<unsigned char *>(pChunk_ + 1);
+            for (std::size_t offset = ((size_ - sizeof(Chunk)) / block) * block; 0u < offset;) {
+                offset -= block;
+                free_[i] = new (pFirst + offset) Block{free_[i]};
+            }
+        }
+        Block *const pBlock = free_[i];
+        free_[i] = pBlock->pNext;
+        return pBlock;
+    }
+
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override {
+        if ((MAX_BLOCK < bytes) || (alignof(std::max_align_t) < alignment)) {
+            release(p, bytes, alignment);
+            return;
+        }
+
+        const std::size_t i = index(std::max(bytes, alignment));
+        const std::lock_guard<std::mutex> lock{mutex_};
+        free_[i] = new (p) Block{free_[i]};
+    }
+
+    std::mutex mutex_;
+    Chunk *pChunk_;
+    std::array<Block *, CLASSES> free_;
+    const std::size_t size_;   // Of each chunk.
+};
+
+constexpr std::size_t PoolResource::MIN_BLOCK;
+constexpr std::size_t PoolResource::MAX_BLOCK;
+constexpr std::size_t PoolResource::CLASSES;
+
+inline std::unique_ptr<MemoryResource> MemoryResource::create(const std::string &type, const std::string &id, const ConfigLayout &config) {
+    const ConfigValue<> *const pResource = config.find("memory.resource"s);
+    if (nullptr == pResource) {
+        for (std::size_t slot = 0u; slot < config.size(); ++slot) {
+            if (reserved(config.key(slot))) {
+                ErrorHandler::raise(Error{ErrorCode::MEMORY_RESOURCE_INVALID, type, id, config.key(slot), config.at(slot)->toString()});
+            }
+        }
+        return nullptr;
+    }
+
+    std::size_t limit = std::numeric_limits<std::size_t>::max();
+    std::size_t size = 4096u;
+    for (std::size_t slot = 0u; slot < config.size(); ++slot) {
+        const std::string &key = config.key(slot);
+        if (!reserved(key) || ("memory.resource"s == key)) {
+            continue;
+        }
+        const Result<std::size_t> value = config.at(slot)->tryConvert<std::size_t>(key);
+        if (!value || (("memory.limit"s != key) && ("memory.size"s != key))) {
+            ErrorHandler::raise(Error{ErrorCode::MEMORY_RESOURCE_INVALID, type, id, key, config.at(slot)->toString()});
+        }
+        (("memory.limit"s == key) ? limit : size) = value.value();
+    }
+
+    const Result<const std::string &> name = pResource->tryValue<std::string>("memory.resource"s);
+    if (name && ("monotonic"s == name.value())) {
+        return std::make_unique<MonotonicResource>(type, id, limit, size);
+    }
+    if (name && ("pool"s == name.value())) {
+        return std::make_unique<PoolResource>(type, id, limit, size);
+    }
+    if (name && ("bounded"s == name.value())) {
+        return std::make_unique<BoundedResource>(type, id, limit);
+    }
+    ErrorHandler::raise(Error{ErrorCode::MEMORY_RESOURCE_INVALID, type, id, "memory.resource"s, pResource->toString()});
+}
+
+inline MemoryResource &MemoryResource::global() {
+    static const std::string name{};
+    static BoundedResource resource{name, name, std::numeric_limits<std::size_t>::max()};
+    return resource;
+}
+
+/**
+ * @brief Allocator using a memory resource, for standard containers (e.g. std::vector<T, ResourceAllocator<T>>). With std::pmr available, the
+ * memory resources can be used with std::pmr::polymorphic_allocator just as well.
+ *
+ * @tparam T Value type.
+ */
+template <typename T>
+class ResourceAllocator {
+public:
+    using value_type = T;
+
+    ResourceAllocator(MemoryResourceBase &memoryResource) noexcept : pMemoryResource_{&memoryResource} {}
+
+    template <typename U>
+    ResourceAllocator(const ResourceAllocator<U> &other) noexcept : pMemoryResource_{other.resource()} {}
+
+    T *allocate(std::size_t n) { return static_cast<T *>(pMemoryResource_->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T *p, std::size_t n) noexcept { pMemoryResource_->deallocate(p, n * sizeof(T), alignof(T)); }
+
+    MemoryResourceBase *resource() const noexcept { return pMemoryResource_; }
+
+private:
+    MemoryResourceBase *pMemoryResource_;
+};
+
+template <typename T, typename U>
+bool operator==(const ResourceAllocator<T> &first, const ResourceAllocator<U> &second) noexcept {
+    return (first.resource() == second.resource()) || first.resource()->is_equal(*second.resource());
+}
+
+template <typename T, typename U>
+bool operator!=(const ResourceAllocator<T> &first, const ResourceAllocator<U> &second) noexcept {
+    return !(first == second);
+}
+
+}   // namespace diff
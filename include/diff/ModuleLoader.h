@@ -0,0 +1,274 @@
+#pragma once
+
+/**
+ * @file ModuleLoader.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines ModuleManifest and ModuleLoader classes used to load only the component modules required by a Topology.
+ * @version 0.1
+ * @date 2025-03-28
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <diff/Build.h>
+#include <diff/Exception.h>
+#include <diff/FactoryRegistry.h>
+#include <diff/Topology.h>
+#include <dlfcn.h>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <set>
+#include <string>
+
+#if defined(__ELF__)
+#include <link.h>
+#endif
+
+namespace diff {
+
+using namespace std::string_literals;
+
+/**
+ * @brief Mapping of component type names to the shared objects (modules) providing their factories. Loaded from a Json object of the following
+ * form:
+ *      { "libfilters.so" : ["app::Filter", "app::Mixer"], "libsinks.so" : ["app::Sink"] }
+ */
+class ModuleManifest final {
+public:
+    /**
+     * @brief Construct empty manifest.
+     */
+    ModuleManifest() = default;
+
+    /**
+     * @brief Construct ModuleManifest object. Load the mapping from a Json file.
+     * @exception ModuleManifestException If loading fails.
+     *
+     * @param path Json file path.
+     */
+    explicit ModuleManifest(const std::string &path) : ModuleManifest{loadFile(path)} {}
+
+    /**
+     * @brief Construct ModuleManifest object. Load the mapping from Json object.
+     * @exception ModuleManifestException If loading fails.
+     *
+     * @param jsonManifest Json object.
+     */
+    explicit ModuleManifest(const nlohmann::json &jsonManifest) {
+        if (!jsonManifest.is_object()) {
+            ErrorHandler::raise(Error{ErrorCode::MODULE_MANIFEST_ERROR, "Module manifest json shall be an object."s});
+        }
+
+        for (const auto &kv : jsonManifest.items()) {
+            if (!kv.value().is_array()) {
+                ErrorHandler::raise(Error{ErrorCode::MODULE_MANIFEST_ERROR, "Module{\""s + kv.key() + "\"} - Component types shall be an array."s});
+            }
+            for (const nlohmann::json &typeJson : kv.value()) {
+                if (!typeJson.is_string()) {
+                    ErrorHandler::raise(Error{ErrorCode::MODULE_MANIFEST_ERROR, "Module{\""s + kv.key() + "\"} - Component type shall be a string."s});
+                }
+                add(typeJson.get<std::string>(), kv.key());
+            }
+        }
+    }
+    ~ModuleManifest() = default;
+
+    /**
+     * @brief Map the given component type to the given module.
+     * @exception ModuleManifestException If the type is already mapped to another module.
+     *
+     * @param type Component type name.
+     * @param path Module path, as accepted by dlopen.
+     */
+    void add(const std::string &type, const std::string &path) {
+        const auto result = modules_.emplace(type, path);
+        if (!result.second && (result.first->second != path)) {
+            ErrorHandler::raise(Error{ErrorCode::MODULE_MANIFEST_ERROR,
+                                      "Component type "s + type + "{} provided by modules \""s + result.first->second + "\" and \""s + path + "\"."s});
+        }
+    }
+
+    /**
+     * @brief Return path of the module providing the given component type.
+     *
+     * @param type Component type name.
+     * @return Module path pointer, or nullptr if the type is not provided by any module (e.g. it is linked into the binary).
+     */
+    const std::string *find(const std::string &type) const noexcept {
+        const auto it = modules_.find(type);
+        return (modules_.cend() == it) ? nullptr : &it->second;
+    }
+
+private:
+    static nlohmann::json loadFile(const std::string &path) {
+        std::ifstream file(path);
+        if (!file) {
+            ErrorHandler::raise(Error{ErrorCode::MODULE_MANIFEST_ERROR, "Module manifest file not accessible. Path: \""s + path + "\"."s});
+        }
+
+#if defined(DIFF_NO_EXCEPTIONS)
+        nlohmann::json json = nlohmann::json::parse(file, nullptr, false, true);
+        if (json.is_discarded()) {
+            ErrorHandler::raise(Error{ErrorCode::MODULE_MANIFEST_ERROR, "Module manifest json syntax error."s});
+        }
+        return json;
+#else
+        try {
+            return nlohmann::json::parse(file, nullptr, true, true);
+        } catch (const nlohmann::json::parse_error &e) {
+            ErrorHandler::raise(Error{ErrorCode::MODULE_MANIFEST_ERROR, "Module manifest json syntax error. Details: \n"s + e.what()});
+        }
+#endif
+    }
+
+    std::map<std::string /* type */, std::string /* path */> modules_;
+};
+
+/**
+ * @brief Shared object loaded with dlopen. Unloaded when destructed. Factories of a module are registered by its static FactoryRegisterer objects
+ * when the module is loaded, and unregistered when it is unloaded. Factory descriptors of the module (@see DIFF_REGISTER_FACTORY) are looked up in
+ * its own section - through the section delimiters defined for the module - and collected by the FactoryRegistry the same way.
+ */
+class Module final {
+public:
+    Module() = delete;
+    Module(const Module &) = delete;
+    Module(Module &&) = delete;
+
+    /**
+     * @brief Load the given shared object.
+     * @exception ModuleLoadError If the shared object can not be loaded.
+     *
+     * @param path Module path, as accepted by dlopen.
+     */
+    explicit Module(const std::string &path)
+        : path_{path}, pHandle_{dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL)}, pFirstDescriptor_{nullptr}, pLastDescriptor_{nullptr} {
+        if (nullptr == pHandle_) {
+            const char *const pError = dlerror();
+            ErrorHandler::raise(Error{ErrorCode::MODULE_LOAD_ERROR, path, (nullptr != pError) ? pError : ""s});
+        }
+
+#if defined(__ELF__)
+        const auto *const pFirst = static_cast<const FactoryDescriptor *>(dlsym(pHandle_, "__start_diff_factories"));
+        const auto *const pLast = static_cast<const FactoryDescriptor *>(dlsym(pHandle_, "__stop_diff_factories"));
+        if ((nullptr != pFirst) && (pFirst < pLast) && owns(pFirst)) {   // Not the delimiters of a library the module depends on.
+#if defined(DIFF_NO_EXCEPTIONS)
+            FactoryRegistry::getInstance().add(pFirst, pLast);
+#else
+            try {
+                FactoryRegistry::getInstance().add(pFirst, pLast);
+            } catch (...) {
+                dlclose(pHandle_);
+                throw;
+            }
+#endif
+            pFirstDescriptor_ = pFirst;
+            pLastDescriptor_ = pLast;
+        }
+#endif
+    }
+
+    ~Module() {
+        if (nullptr != pFirstDescriptor_) {
+            FactoryRegistry::getInstance().remove(pFirstDescriptor_, pLastDescriptor_);
+        }
+        dlclose(pHandle_);
+    }
+
+    Module &operator=(const Module &) = delete;
+    Module &operator=(Module &&) = delete;
+
+    /**
+     * @brief Return module path.
+     *
+     * @return Path reference.
+     */
+    const std::string &path() const noexcept { return path_; }
+
+private:
+#if defined(__ELF__)
+    bool owns(const void *pSymbol) const noexcept {
+        Dl_info info;
+        struct link_map *pLinkMap = nullptr;
+        return (0 != dladdr(pSymbol, &info)) && (0 == dlinfo(pHandle_, RTLD_DI_LINKMAP, &pLinkMap)) && (nullptr != pLinkMap) &&
+               (reinterpret_cast<ElfW(Addr)>(info.dli_fbase) == pLinkMap->l_addr);
+    }
+#endif
+
+    const std::string path_;
+    void *const pHandle_;
+    const FactoryDescriptor *pFirstDescriptor_;   // Collected descriptors of the module, or nullptr if none.
+    const FactoryDescriptor *pLastDescriptor_;
+};
+
+/**
+ * @brief Loads modules required by the given topology - only modules providing component types used by the topology are loaded (@see
+ * ModuleManifest). Each module is loaded once and shared by all the topologies requiring it. A module is unloaded when the last owner of the
+ * returned Modules objects (typically Build objects) is destructed.
+ *
+ * The binary shall export its symbols (e.g. be linked with -rdynamic), so that FactoryRegisterer objects of the modules register their factories in
+ * the FactoryRegistry of the binary. Factory descriptors of the modules are collected by the loader itsself (@see Module). Modules built with GCC shall
+ * be compiled with -fno-gnu-unique - otherwise the dynamic linker never unloads them.
+ */
+class ModuleLoader final {
+public:
+    ModuleLoader() = delete;
+    ModuleLoader(const ModuleLoader &) = delete;
+    ModuleLoader(ModuleLoader &&) = delete;
+
+    /**
+     * @brief Construct ModuleLoader object.
+     *
+     * @param moduleManifest Mapping of component types to modules.
+     */
+    explicit ModuleLoader(ModuleManifest moduleManifest) : moduleManifest_{std::move(moduleManifest)} {}
+    ~ModuleLoader() = default;
+
+    ModuleLoader &operator=(const ModuleLoader &) = delete;
+    ModuleLoader &operator=(ModuleLoader &&) = delete;
+
+    /**
+     * @brief Load modules providing component types used by the topology. Modules already loaded are shared. Component types not present in the
+     * manifest are assumed to be linked into the binary.
+     * @exception ModuleLoadError If a module can not be loaded.
+     *
+     * @param topology Topology object.
+     * @return Shared ownership of the required modules, to be passed to Build (@see Build::Build).
+     */
+    Modules load(const Topology &topology) {
+        std::set<std::reference_wrapper<const std::string>, std::less<std::string>> paths;
+        for (const TopologyEntry &topologyEntry : topology) {
+            const std::string *const pPath = moduleManifest_.find(topologyEntry.type);
+            if (nullptr != pPath) {
+                paths.emplace(*pPath);
+            }
+        }
+
+        const std::lock_guard<std::mutex> lock{mutex_};
+
+        Modules result;
+        result.reserve(paths.size());
+        for (const std::string &path : paths) {
+            std::weak_ptr<const Module> &pLoaded = modules_[path];
+
+            std::shared_ptr<const Module> pModule = pLoaded.lock();
+            if (nullptr == pModule) {
+                pModule = std::make_shared<const Module>(path);
+                pLoaded = pModule;
+            }
+            result.emplace_back(std::move(pModule));
+        }
+
+        return result;
+    }
+
+private:
+    const ModuleManifest moduleManifest_;
+
+    std::mutex mutex_;
+    std::map<std::string /* path */, std::weak_ptr<const Module>> modules_;
+};
+
+}   // namespace diff
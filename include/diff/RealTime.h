@@ -0,0 +1,90 @@
+#pragma once
+
+/**
+ * @file RealTime.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines RealTime class used to prepare the process for latency-critical operation once the components are built.
+ * @version 0.1
+ * @date 2025-04-11
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <diff/Error.h>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <sys/mman.h>
+#endif
+
+namespace diff {
+
+/**
+ * @brief Readiness phase helpers, complementing the warm-up of the components (@see Build::warmup) - so that the first messages processed do not
+ * take page faults the steady state does not take. Intended order: build, warm up, lock memory, prefault stacks of the latency-critical threads.
+ */
+class RealTime final {
+public:
+    RealTime() = delete;
+
+    /**
+     * @brief Lock all the pages of the process in memory - current ones and the ones mapped in the future (mlockall(MCL_CURRENT | MCL_FUTURE)).
+     * Requires the privilege or memory lock limit to do so.
+     *
+     * @return Nothing or MemoryLockError description.
+     */
+    static Result<> lockMemory() {
+#if defined(__unix__) || defined(__APPLE__)
+        if (0 != mlockall(MCL_CURRENT | MCL_FUTURE)) {
+            return Error{ErrorCode::MEMORY_LOCK_ERROR, std::string{std::strerror(errno)}};
+        }
+        return {};
+#else
+        return Error{ErrorCode::MEMORY_LOCK_ERROR, "Not supported on this platform."s};
+#endif
+    }
+
+    /**
+     * @brief Unlock all the pages of the process (@see lockMemory).
+     */
+    static void unlockMemory() noexcept {
+#if defined(__unix__) || defined(__APPLE__)
+        munlockall();
+#endif
+    }
+
+    /**
+     * @brief Touch the given number of bytes of the stack of the calling thread below the current frame, so that its pages are mapped (and locked,
+     * if the memory is locked) before the thread gets latency-critical.
+     *
+     * @param size Stack size in bytes to be touched.
+     */
+    static void prefaultStack(std::size_t size) noexcept {
+        if (0u != size) {
+            touch(size);
+        }
+    }
+
+private:
+    static constexpr std::size_t PAGE = 4096u;
+
+#if defined(_MSC_VER)
+    __declspec(noinline)
+#else
+    __attribute__((noinline))
+#endif
+    static void touch(std::size_t size) noexcept {
+        volatile unsigned char page[PAGE];
+        page[0] = 0u;
+        if (PAGE < size) {
+            touch(size - PAGE);
+        }
+        page[PAGE - 1u] = page[0];   // Used after the call - prevents the recursion from being turned into a loop reusing the frame.
+    }
+};
+
+constexpr std::size_t RealTime::PAGE;
+
+}   // namespace diff
@@ -0,0 +1,110 @@
+#pragma once
+
+/**
+ * @file ScopeTopology.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines ScopeTopology class used to instantiate scoped Build objects repeatedly from a single Topology.
+ * @version 0.1
+ * @date 2025-03-10
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <diff/DependencyIdTable.h>
+#include <diff/Factory.h>
+#include <diff/FactoryRegistry.h>
+#include <diff/Topology.h>
+#include <functional>
+#include <vector>
+
+namespace diff {
+
+/**
+ * @brief Pre-compiled Topology of a scope (e.g. a session, transaction or request). Consecutive entries of the same component type are grouped into
+ * runs and factories of all the runs are resolved once, at construction, so that any number of scoped Build objects can be instantiated from it
+ * without repeating the lookup. The underlying Topology is owned and never modified - each scoped Build works on copies of instance ids and configs.
+ */
+class ScopeTopology final {
+public:
+    /**
+     * @brief Consecutive topology entries of the same component type, constructed together (@see Factory::buildMany).
+     */
+    struct Run {
+        /**
+         * @brief Factory of the run component type.
+         */
+        std::reference_wrapper<Factory<>> factory;
+
+        /**
+         * @brief Index of the first topology entry of the run.
+         */
+        std::size_t first;
+
+        /**
+         * @brief Number of topology entries in the run.
+         */
+        std::size_t size;
+    };
+
+    ScopeTopology() = delete;
+    ScopeTopology(const ScopeTopology &) = delete;
+    ScopeTopology(ScopeTopology &&) = default;
+
+    /**
+     * @brief Construct ScopeTopology object. Resolve factories of all component types defined by the Topology object and slots of all the
+     * dependency ids (@see DependencyIdTable).
+     * @exception FactoryNotFound If factory of a requested component type is not registered within FactoryRegistry.
+     *
+     * @param topology Topology object defining components of the scope. Moved into the constructed object.
+     */
+    explicit ScopeTopology(Topology &&topology) : topology_{std::move(topology)}, dependencyIdTable_{topology_} {
+        dependencyIdTable_.resolve(topology_);
+
+        std::size_t first = 0u;
+        while (first < topology_.size()) {
+            const std::string &type = topology_[first].type;
+
+            std::size_t size = 1u;
+            while (((first + size) < topology_.size()) && (topology_[first + size].type == type)) {
+                ++size;
+            }
+
+            runs_.emplace_back(Run{FactoryRegistry::getInstance().get(type), first, size});
+            first += size;
+        }
+    }
+    ~ScopeTopology() = default;
+
+    ScopeTopology &operator=(const ScopeTopology &) = delete;
+    ScopeTopology &operator=(ScopeTopology &&) = default;
+
+    /**
+     * @brief Return number of component instances defined by the scope.
+     *
+     * @return Number of entries.
+     */
+    std::size_t size() const noexcept { return topology_.size(); }
+
+    /**
+     * @brief Return topology entries of the scope.
+     *
+     * @return Topology reference.
+     */
+    const Topology &topology() const noexcept { return topology_; }
+
+    /**
+     * @brief Return table of slots of the dependency ids of the scope.
+     *
+     * @return DependencyIdTable reference.
+     */
+    const DependencyIdTable &dependencyIdTable() const noexcept { return dependencyIdTable_; }
+
+    std::vector<Run>::const_iterator begin() const noexcept { return runs_.cbegin(); }
+    std::vector<Run>::const_iterator end() const noexcept { return runs_.cend(); }
+
+private:
+    Topology topology_;
+    DependencyIdTable dependencyIdTable_;
+    std::vector<Run> runs_;
+};
+
+}   // namespace diff
@@ -0,0 +1,250 @@
+#pragma once
+
+/**
+ * @file SealedBuild.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines SealedBuild class used to instantiate a fixed topology with its wiring resolved at compile time.
+ * @version 0.1
+ * @date 2025-03-24
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <diff/Component.h>
+#include <diff/DependencyRegistry.h>
+#include <diff/Exception.h>
+#include <diff/Factory.h>
+#include <diff/Topology.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace diff {
+
+/**
+ * @brief Describes a single component instance of a SealedBuild - its type as named by the topology (@see rebind) and the indices of component
+ * instances it depends on (in order of the constructor parameters). Instances are indexed in order of the topology entries.
+ *
+ * @tparam T Component type.
+ * @tparam Is Indices of the dependency instances. Each shall be lower than the index of the described instance.
+ */
+template <typename T, std::size_t... Is>
+struct sealed {
+    using Type = T;
+    using Dependencies = std::index_sequence<Is...>;
+};
+
+/**
+ * @brief Concrete type a sealed component instance is constructed as, given the concrete types of its dependency instances (@see SealedBuild).
+ * A component template instantiated on the interface types of its dependencies (e.g. Stage<IStage>) is rebound to the concrete types of the
+ * dependency instances (e.g. Stage<Sink>), provided that there is a template argument per dependency, and each dependency type is final and derives
+ * from the corresponding argument. Any other type is kept as is.
+ *
+ * May be specialized for component types which shall be kept, or rebound differently.
+ *
+ * @tparam T Component type, as named by the topology.
+ * @tparam Ds Concrete types of the dependency instances, in order of the constructor parameters.
+ */
+template <typename T, typename... Ds>
+struct rebind {
+    using type = T;
+};
+
+template <template <typename...> class C, typename... As, typename... Ds>
+struct rebind<C<As...>, Ds...> {
+private:
+    template <typename Us, typename = void>
+    struct Rebindable : std::false_type {};
+
+    template <typename... Us>
+    struct Rebindable<std::tuple<Us...>, std::enable_if_t<(0u != sizeof...(Us)) && (sizeof...(As) == sizeof...(Us))>>
+        : std::is_same<std::integer_sequence<bool, true, (std::is_base_of<As, Us>::value && std::is_final<Us>::value && !std::is_same<As, Us>::value)...>,
+                       std::integer_sequence<bool, ((void)sizeof(Us), true)..., true>> {};
+
+    // C<Ds...> named only if rebindable - it may not even be a valid type otherwise.
+    template <bool B, typename = void>
+    struct Rebound {
+        using type = C<As...>;
+    };
+
+    template <typename V>
+    struct Rebound<true, V> {
+        using type = C<Ds...>;
+    };
+
+public:
+    using type = typename Rebound<Rebindable<std::tuple<Ds...>>::value>::type;
+};
+
+template <typename T, typename... Ds>
+using rebind_t = typename rebind<T, Ds...>::type;
+
+/**
+ * @brief SealedBuild object instantiates and owns components of a fixed topology, with the wiring resolved at compile time (@see
+ * SealedBuildGenerator). Each component is constructed from references to the instances of its dependencies instead of Injector objects, so
+ * neither factories nor dependency lookups are involved, and all the instances are stored in a single object. Components are registered in the
+ * dependency registry as usual, so the remaining Build interface is available as well.
+ *
+ * Components templated on the types of their dependencies are constructed as instantiations on the concrete types of the dependency instances
+ * (@see rebind), so calls between them are devirtualized (and may be inlined) although the topology names the interface instantiations. Other
+ * components keep the dependency types they declare - one taking an interface reference calls its dependency virtually, just like in a Build.
+ *
+ * The Topology object passed to the constructor provides ids and configs. It shall define exactly the instances the SealedBuild was generated for.
+ *
+ * @tparam Ss Component instance descriptors (@see sealed), in order of the topology entries.
+ */
+template <typename... Ss>
+class SealedBuild final {
+    template <std::size_t I, typename = typename std::tuple_element_t<I, std::tuple<Ss...>>::Dependencies>
+    struct Bound;
+
+    template <std::size_t I, std::size_t... Js>
+    struct Bound<I, std::index_sequence<Js...>> {
+        using type = rebind_t<typename std::tuple_element_t<I, std::tuple<Ss...>>::Type, typename Bound<Js>::type...>;
+    };
+
+public:
+    /**
+     * @brief Type of the instance of the given index, as named by the topology.
+     */
+    template <std::size_t I>
+    using Declared = typename std::tuple_element_t<I, std::tuple<Ss...>>::Type;
+
+    /**
+     * @brief Concrete type of the instance of the given index (@see rebind).
+     */
+    template <std::size_t I>
+    using Type = typename Bound<I>::type;
+
+    /**
+     * @brief Construct a SealedBuild object. Instantiate components in order of the topology entries. Ids and configs are moved out of the Topology
+     * object.
+     * @exception SealedTopologyMismatch If the topology entries do not match the types and dependencies of the sealed instances.
+     *
+     * @param topology Topology object defining ids and configs of the instances.
+     */
+    explicit SealedBuild(Topology& topology) : dependencyRegistry_{nullptr}, size_{0u} {
+        if (sizeof...(Ss) != topology.size()) {
+            ErrorHandler::raise(Error{ErrorCode::SEALED_TOPOLOGY_SIZE_MISMATCH, std::to_string(sizeof...(Ss)), std::to_string(topology.size())});
+        }
+
+#if defined(DIFF_NO_EXCEPTIONS)
+        construct(topology, std::index_sequence_for<Ss...>{});
+#else
+        try {
+            construct(topology, std::index_sequence_for<Ss...>{});
+        } catch (...) {
+            destruct();
+            throw;
+        }
+#endif
+    }
+
+    SealedBuild(const SealedBuild&) = delete;
+    SealedBuild(SealedBuild&&) = delete;
+    ~SealedBuild() { destruct(); }
+
+    SealedBuild& operator=(const SealedBuild&) = delete;
+    SealedBuild& operator=(SealedBuild&&) = delete;
+
+    /**
+     * @brief Return the instance of the given index through its concrete type.
+     *
+     * @tparam I Instance index, in order of the topology entries.
+     * @return Instance reference.
+     */
+    template <std::size_t I>
+    Type<I>& get() noexcept {
+#if defined(__cpp_lib_launder)
+        return *std::launder(reinterpret_cast<Type<I>*>(&std::get<I>(storage_)));
+#else
+        return *reinterpret_cast<Type<I>*>(&std::get<I>(storage_));
+#endif
+    }
+
+    /**
+     * @brief @see Build::all
+     */
+    std::vector<std::pair<std::reference_wrapper<const std::string>, std::reference_wrapper<const std::string>>> all() const noexcept {
+        return dependencyRegistry_.all();
+    }
+
+    /**
+     * @brief @see Build::has
+     */
+    template <typename T>
+    bool has(const std::string& id) const noexcept {
+        return dependencyRegistry_.has<T>(id);
+    }
+
+    /**
+     * @brief @see Build::get
+     */
+    template <typename T>
+    std::vector<std::reference_wrapper<T>> get() const noexcept {
+        return dependencyRegistry_.get<T>();
+    }
+
+    /**
+     * @brief @see Build::get
+     */
+    template <typename T>
+    T& get(const std::string& id) const {
+        return dependencyRegistry_.get<T>(id);
+    }
+
+private:
+    template <std::size_t I>
+    using Storage = std::aligned_storage_t<sizeof(Type<I>), alignof(Type<I>)>;
+
+    template <typename Is>
+    struct Storages;
+
+    template <std::size_t... Is>
+    struct Storages<std::index_sequence<Is...>> {
+        using type = std::tuple<Storage<Is>...>;
+    };
+
+    template <std::size_t... Is>
+    void construct(Topology& topology, std::index_sequence<Is...>) {
+        const int sequence[] = {0, (construct<Is>(topology[Is], typename std::tuple_element_t<Is, std::tuple<Ss...>>::Dependencies{}), 0)...};
+        static_cast<void>(sequence);
+    }
+
+    template <std::size_t I, std::size_t... Js>
+    void construct(TopologyEntry& topologyEntry, std::index_sequence<Js...>) {
+        static_assert(std::is_same<std::index_sequence<(Js < I)...>, std::index_sequence<((void)Js, true)...>>::value,
+                      "Sealed instance shall depend on preceding instances only.");
+
+        const std::vector<std::reference_wrapper<const std::string>> dependencyIds{get<Js>().id()...};
+        if ((Demangler::of<Declared<I>>() != topologyEntry.type) || (dependencyIds.size() != topologyEntry.dependencyIds.size()) ||
+            !std::equal(dependencyIds.cbegin(), dependencyIds.cend(), topologyEntry.dependencyIds.cbegin(), std::equal_to<std::string>{})) {
+            ErrorHandler::raise(Error{ErrorCode::SEALED_TOPOLOGY_MISMATCH, topologyEntry.type, topologyEntry.id});
+        }
+
+        instances_[I] = &Factory<Type<I>>::emplace(&std::get<I>(storage_), std::move(topologyEntry.id), std::move(topologyEntry.config),
+                                                   dependencyRegistry_, get<Js>()...);
+        ++size_;
+    }
+
+    void destruct() noexcept {
+        while (0u != size_) {
+            --size_;
+            instances_[size_]->~Component();
+        }
+    }
+
+    DependencyRegistry dependencyRegistry_;
+
+    typename Storages<std::index_sequence_for<Ss...>>::type storage_;
+    std::array<Component<>*, sizeof...(Ss)> instances_;
+    std::size_t size_;
+};
+
+}   // namespace diff
@@ -0,0 +1,81 @@
+#pragma once
+
+/**
+ * @file SealedBuildGenerator.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines SealedBuildGenerator class used to generate the compile time wiring of a fixed topology.
+ * @version 0.1
+ * @date 2025-03-24
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <diff/Exception.h>
+#include <diff/Topology.h>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace diff {
+
+/**
+ * @brief Generates a header defining the SealedBuild type of the given topology (@see SealedBuild). Each dependency of each topology entry is
+ * resolved to the index of the component instance of the same id, preceding the dependent entry. Only dependencies on component instances
+ * themselves (as registered with as<...>) can be sealed - side dependencies and collections are resolved at runtime only.
+ *
+ * Component types are emitted as named by the topology. Those templated on the interface types of their dependencies are constructed on the
+ * concrete types of the dependency instances by the SealedBuild (@see rebind), which devirtualizes calls between them.
+ *
+ * Generated header is intended to be regenerated whenever the topology changes (e.g. as a build step), and compiled together with the headers of
+ * all the component types used by the topology.
+ */
+class SealedBuildGenerator final {
+public:
+    SealedBuildGenerator() = delete;
+
+    /**
+     * @brief Write header defining the SealedBuild type of the given topology.
+     * @exception SealedDependencyUnresolved If a dependency id is not the id of a component instance preceding the dependent one.
+     *
+     * @param os Output stream.
+     * @param topology Topology object to be sealed.
+     * @param name Name of the generated SealedBuild type alias.
+     * @param includes Headers defining the component types, to be included by the generated header.
+     */
+    static void generate(std::ostream &os, const Topology &topology, const std::string &name, const std::vector<std::string> &includes = {}) {
+        std::vector<std::vector<std::size_t>> dependencyIndices(topology.size());
+        for (std::size_t i = 0u; i < topology.size(); ++i) {
+            for (const DependencyId &dependencyId : topology[i].dependencyIds) {
+                dependencyIndices[i].emplace_back(find(topology, i, dependencyId));
+            }
+        }
+
+        os << "#pragma once\n\n";
+        os << "// Generated by diff::SealedBuildGenerator - do not edit.\n\n";
+        os << "#include <diff/SealedBuild.h>\n";
+        for (const std::string &include : includes) {
+            os << "#include <" << include << ">\n";
+        }
+        os << "\nusing " << name << " = diff::SealedBuild<";
+        for (std::size_t i = 0u; i < topology.size(); ++i) {
+            os << ((0u == i) ? "\n    " : ",\n    ") << "diff::sealed<" << topology[i].type;
+            for (const std::size_t dependencyIndex : dependencyIndices[i]) {
+                os << ", " << dependencyIndex << "u";
+            }
+            os << ">";
+        }
+        os << ">;\n";
+    }
+
+private:
+    static std::size_t find(const Topology &topology, std::size_t index, const DependencyId &dependencyId) {
+        for (std::size_t i = 0u; i < index; ++i) {
+            if (topology[i].id == dependencyId) {
+                return i;
+            }
+        }
+
+        ErrorHandler::raise(Error{ErrorCode::SEALED_DEPENDENCY_UNRESOLVED, topology[index].type, topology[index].id, dependencyId});
+    }
+};
+
+}   // namespace diff
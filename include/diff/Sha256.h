@@ -0,0 +1,174 @@
+#pragma once
+
+/**
+ * @file Sha256.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines Sha256 class used to compute content digests (FIPS 180-4).
+ * @version 0.1
+ * @date 2025-04-09
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace diff {
+
+/**
+ * @brief Incremental SHA-256. Used to key cached topologies by the content of their files (@see TopologyCache).
+ */
+class Sha256 final {
+public:
+    using Digest = std::array<std::uint8_t, 32u>;
+
+    Sha256() : state_{0x6a09e667u, 0xbb67ae85u, 0x3c6ef372u, 0xa54ff53au, 0x510e527fu, 0x9b05688cu, 0x1f83d9abu, 0x5be0cd19u}, block_{}, size_{0u} {}
+
+    /**
+     * @brief Append data to the message.
+     *
+     * @param pData Data pointer.
+     * @param size Data size in bytes.
+     * @return Reference to *this.
+     */
+    Sha256 &update(const void *pData, std::size_t size) noexcept {
+        const std::uint8_t *p = static_cast<const std::uint8_t *>(pData);
+        while (0u < size) {
+            const std::size_t offset = size_ % 64u;
+            const std::size_t n = std::min(size, 64u - offset);
+            std::memcpy(block_.data() + offset, p, n);
+            size_ += n;
+            p += n;
+            size -= n;
+            if (0u == size_ % 64u) {
+                transform();
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Append string to the message, preceded by its size - so that consecutive strings are not ambiguous.
+     *
+     * @param text String.
+     * @return Reference to *this.
+     */
+    Sha256 &update(const std::string &text) noexcept {
+        const std::uint64_t size = text.size();
+        return update(&size, sizeof(size)).update(text.data(), text.size());
+    }
+
+    /**
+     * @brief Append digest to the message.
+     *
+     * @param digest Digest.
+     * @return Reference to *this.
+     */
+    Sha256 &update(const Digest &digest) noexcept { return update(digest.data(), digest.size()); }
+
+    /**
+     * @brief Return digest of the message. The object shall not be updated afterwards.
+     *
+     * @return Digest.
+     */
+    Digest digest() noexcept {
+        const std::uint64_t bits = static_cast<std::uint64_t>(size_) * 8u;
+        const std::uint8_t one = 0x80u;
+        const std::uint8_t zero = 0u;
+        update(&one, 1u);
+        while (56u != size_ % 64u) {
+            update(&zero, 1u);
+        }
+        for (std::size_t i = 0u; i < 8u; ++i) {
+            const std::uint8_t byte = static_cast<std::uint8_t>(bits >> (56u - 8u * i));
+            update(&byte, 1u);
+        }
+
+        Digest result;
+        for (std::size_t i = 0u; i < result.size(); ++i) {
+            result[i] = static_cast<std::uint8_t>(state_[i / 4u] >> (24u - 8u * (i % 4u)));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Return digest of the given string.
+     *
+     * @param text String.
+     * @return Digest.
+     */
+    static Digest of(const std::string &text) noexcept { return Sha256{}.update(text.data(), text.size()).digest(); }
+
+    /**
+     * @brief Return hexadecimal representation of the given digest.
+     *
+     * @param digest Digest.
+     * @return Lowercase hexadecimal string.
+     */
+    static std::string toString(const Digest &digest) {
+        static const char digits[] = "0123456789abcdef";
+        std::string result;
+        result.reserve(2u * digest.size());
+        for (const std::uint8_t byte : digest) {
+            result.push_back(digits[byte >> 4u]);
+            result.push_back(digits[byte & 0xfu]);
+        }
+        return result;
+    }
+
+private:
+    static std::uint32_t rotate(std::uint32_t value, unsigned bits) noexcept { return (value >> bits) | (value << (32u - bits)); }
+
+    void transform() noexcept {
+        static const std::uint32_t k[64] = {
+            0x428a2f98u, 0x71374491u, 0xb5c0fbcfu, 0xe9b5dba5u, 0x3956c25bu, 0x59f111f1u, 0x923f82a4u, 0xab1c5ed5u, 0xd807aa98u, 0x12835b01u, 0x243185beu,
+            0x550c7dc3u, 0x72be5d74u, 0x80deb1feu, 0x9bdc06a7u, 0xc19bf174u, 0xe49b69c1u, 0xefbe4786u, 0x0fc19dc6u, 0x240ca1ccu, 0x2de92c6fu, 0x4a7484aau,
+            0x5cb0a9dcu, 0x76f988dau, 0x983e5152u, 0xa831c66du, 0xb00327c8u, 0xbf597fc7u, 0xc6e00bf3u, 0xd5a79147u, 0x06ca6351u, 0x14292967u, 0x27b70a85u,
+            0x2e1b2138u, 0x4d2c6dfcu, 0x53380d13u, 0x650a7354u, 0x766a0abbu, 0x81c2c92eu, 0x92722c85u, 0xa2bfe8a1u, 0xa81a664bu, 0xc24b8b70u, 0xc76c51a3u,
+            0xd192e819u, 0xd6990624u, 0xf40e3585u, 0x106aa070u, 0x19a4c116u, 0x1e376c08u, 0x2748774cu, 0x34b0bcb5u, 0x391c0cb3u, 0x4ed8aa4au, 0x5b9cca4fu,
+            0x682e6ff3u, 0x748f82eeu, 0x78a5636fu, 0x84c87814u, 0x8cc70208u, 0x90befffau, 0xa4506cebu, 0xbef9a3f7u, 0xc67178f2u};
+
+        std::uint32_t w[64];
+        for (std::size_t i = 0u; i < 16u; ++i) {
+            w[i] = (static_cast<std::uint32_t>(block_[4u * i]) << 24u) | (static_cast<std::uint32_t>(block_[4u * i + 1u]) << 16u) |
+                   (static_cast<std::uint32_t>(block_[4u * i + 2u]) << 8u) | static_cast<std::uint32_t>(block_[4u * i + 3u]);
+        }
+        for (std::size_t i = 16u; i < 64u; ++i) {
+            const std::uint32_t s0 = rotate(w[i - 15u], 7u) ^ rotate(w[i - 15u], 18u) ^ (w[i - 15u] >> 3u);
+            const std::uint32_t s1 = rotate(w[i - 2u], 17u) ^ rotate(w[i - 2u], 19u) ^ (w[i - 2u] >> 10u);
+            w[i] = w[i - 16u] + s0 + w[i - 7u] + s1;
+        }
+
+        std::uint32_t a = state_[0], b = state_[1], c = state_[2], d = state_[3], e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+        for (std::size_t i = 0u; i < 64u; ++i) {
+            const std::uint32_t t1 = h + (rotate(e, 6u) ^ rotate(e, 11u) ^ rotate(e, 25u)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+            const std::uint32_t t2 = (rotate(a, 2u) ^ rotate(a, 13u) ^ rotate(a, 22u)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state_[0] += a;
+        state_[1] += b;
+        state_[2] += c;
+        state_[3] += d;
+        state_[4] += e;
+        state_[5] += f;
+        state_[6] += g;
+        state_[7] += h;
+    }
+
+    std::array<std::uint32_t, 8u> state_;
+    std::array<std::uint8_t, 64u> block_;
+    std::size_t size_;
+};
+
+}   // namespace diff
@@ -0,0 +1,125 @@
+#pragma once
+
+/**
+ * @file Span.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines Span class used to access a contiguous array of objects through their common interface.
+ * @version 0.1
+ * @date 2025-03-17
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace diff {
+
+/**
+ * @brief Non-owning view of a contiguous array of objects, accessed through the type T. Array elements may be of any type derived from T - the
+ * distance between consecutive elements is the size of the actual element type, not the size of T.
+ *
+ * @tparam T Element access type (typically an abstract interface).
+ */
+template <typename T>
+class Span final {
+public:
+    /**
+     * @brief Random access iterator over Span elements.
+     */
+    class Iterator final {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T *;
+        using reference = T &;
+
+        Iterator(const Span &span, std::size_t index) noexcept : pSpan_{&span}, index_{index} {}
+
+        T &operator*() const noexcept { return (*pSpan_)[index_]; }
+        T *operator->() const noexcept { return &(*pSpan_)[index_]; }
+        T &operator[](difference_type n) const noexcept { return (*pSpan_)[index_ + n]; }
+
+        Iterator &operator++() noexcept { return ++index_, *this; }
+        Iterator operator++(int) noexcept { return Iterator{*pSpan_, index_++}; }
+        Iterator &operator--() noexcept { return --index_, *this; }
+        Iterator operator--(int) noexcept { return Iterator{*pSpan_, index_--}; }
+        Iterator &operator+=(difference_type n) noexcept { return index_ += n, *this; }
+        Iterator &operator-=(difference_type n) noexcept { return index_ -= n, *this; }
+
+        friend Iterator operator+(Iterator it, difference_type n) noexcept { return it += n; }
+        friend Iterator operator-(Iterator it, difference_type n) noexcept { return it -= n; }
+        friend difference_type operator-(const Iterator &first, const Iterator &second) noexcept {
+            return static_cast<difference_type>(first.index_) - static_cast<difference_type>(second.index_);
+        }
+
+        friend bool operator==(const Iterator &first, const Iterator &second) noexcept { return first.index_ == second.index_; }
+        friend bool operator!=(const Iterator &first, const Iterator &second) noexcept { return first.index_ != second.index_; }
+        friend bool operator<(const Iterator &first, const Iterator &second) noexcept { return first.index_ < second.index_; }
+
+    private:
+        const Span *pSpan_;
+        std::size_t index_;
+    };
+
+    /**
+     * @brief Construct empty Span.
+     */
+    Span() noexcept : pFirst_{nullptr}, stride_{sizeof(T)}, size_{0u} {}
+
+    /**
+     * @brief Construct Span over the given array.
+     *
+     * @tparam U Actual array element type.
+     * @param pFirst Pointer to the first array element.
+     * @param size Number of array elements.
+     */
+    template <typename U, std::enable_if_t<std::is_base_of<T, U>::value || std::is_same<T, U>::value, bool> = true>
+    Span(U *pFirst, std::size_t size) noexcept : pFirst_{pFirst}, stride_{sizeof(U)}, size_{size} {}
+
+    /**
+     * @brief Construct Span over the given array.
+     *
+     * @tparam U Actual array element type.
+     * @tparam N Number of array elements.
+     * @param array Array reference.
+     */
+    template <typename U, std::size_t N, std::enable_if_t<std::is_base_of<T, U>::value || std::is_same<T, U>::value, bool> = true>
+    Span(U (&array)[N]) noexcept : Span(&array[0], N) {}
+
+    /**
+     * @brief Return number of elements.
+     *
+     * @return Number of elements.
+     */
+    std::size_t size() const noexcept { return size_; }
+
+    /**
+     * @brief Indicate whether the Span has no elements.
+     *
+     * @return True if empty, false otherwise.
+     */
+    bool empty() const noexcept { return (0u == size_); }
+
+    /**
+     * @brief Return element of the given index. Index is not checked.
+     *
+     * @param index Element index.
+     * @return Element reference.
+     */
+    T &operator[](std::size_t index) const noexcept {
+        using Byte = std::conditional_t<std::is_const<T>::value, const unsigned char, unsigned char>;
+        return *reinterpret_cast<T *>(reinterpret_cast<Byte *>(pFirst_) + (index * stride_));
+    }
+
+    Iterator begin() const noexcept { return Iterator{*this, 0u}; }
+    Iterator end() const noexcept { return Iterator{*this, size_}; }
+
+private:
+    T *pFirst_;
+    std::size_t stride_;
+    std::size_t size_;
+};
+
+}   // namespace diff
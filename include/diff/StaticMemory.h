@@ -0,0 +1,491 @@
+#pragma once
+
+/**
+ * @file StaticMemory.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines StaticMemory and StaticCapacity classes used to run the framework in fixed, statically allocated memory.
+ * @version 0.1
+ * @date 2025-04-10
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <diff/Config.h>
+#include <diff/Error.h>
+#include <diff/Footprint.h>
+#include <diff/Topology.h>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+/**
+ * @brief Static memory mode, for targets which shall not allocate the structures of the topology on the heap (e.g. bare-metal). Enabled explicitly,
+ * in all the translation units of the application. In this mode Build::create checks the topology against the static capacities before anything is
+ * instantiated (@see StaticCapacity). Once the application defines its allocation functions (@see DIFF_STATIC_MEMORY_OPERATORS), Build objects
+ * allocate from StaticMemory - when constructed, reset and warmed up.
+ *
+ * Other allocations of the application are served from the heap - including the Topology object with its configs, the factory registry, and
+ * anything TopologyLoader or TopologyBuilder creates - unless made within a Scope opened by the application itself. For targets without a heap,
+ * DIFF_STATIC_MEMORY_EXCLUSIVE shall be defined as well - all the allocations are served from StaticMemory then, regardless of scopes and threads.
+ *
+ * Capacities are configured at compile time and shall be the same in all the translation units:
+ * - DIFF_STATIC_MEMORY_SIZE - bytes of the static memory, for the components and framework structures of all the builds alive at a time (and for
+ *   everything else in the exclusive mode),
+ * - DIFF_STATIC_MAX_COMPONENTS - number of component instances of a build,
+ * - DIFF_STATIC_MAX_DEPENDENCIES - number of dependency ids of all the component instances of a build,
+ * - DIFF_STATIC_STRING_POOL - bytes of the strings identifying component instances (types, ids, dependency ids, config keys - with terminators),
+ * - DIFF_STATIC_CONFIG_BYTES - bytes of the config values of all the component instances (@see ConfigEntry<>::size).
+ */
+#if !defined(DIFF_STATIC_MEMORY_SIZE)
+#define DIFF_STATIC_MEMORY_SIZE 262144u
+#endif
+#if !defined(DIFF_STATIC_MAX_COMPONENTS)
+#define DIFF_STATIC_MAX_COMPONENTS 64u
+#endif
+#if !defined(DIFF_STATIC_MAX_DEPENDENCIES)
+#define DIFF_STATIC_MAX_DEPENDENCIES 256u
+#endif
+#if !defined(DIFF_STATIC_STRING_POOL)
+#define DIFF_STATIC_STRING_POOL 8192u
+#endif
+#if !defined(DIFF_STATIC_CONFIG_BYTES)
+#define DIFF_STATIC_CONFIG_BYTES 4096u
+#endif
+
+namespace diff {
+
+/**
+ * @brief Fixed block of statically allocated memory, DIFF_STATIC_MEMORY_SIZE bytes. Blocks are served first-fit from the blocks freed so far
+ * (adjacent ones merged) or from the unused end of the memory, so the memory used by a given sequence of allocations is the same on every run and
+ * builds created and destroyed repeatedly take the same memory each time.
+ *
+ * The allocation functions replaced by DIFF_STATIC_MEMORY_OPERATORS serve a thread from StaticMemory while a Scope is open on it - within the
+ * Build operations - and from the heap otherwise (unless DIFF_STATIC_MEMORY_EXCLUSIVE is defined). Running out of the memory raises std::bad_alloc,
+ * or aborts in exception-free mode - the failure can not be described with an Error object, which allocates itsself.
+ */
+class StaticMemory final {
+public:
+    StaticMemory() = delete;
+
+    /**
+     * @brief Routes the allocations of the calling thread to StaticMemory while alive. Scopes may be nested. Has no effect in the exclusive mode.
+     */
+    class Scope final {
+    public:
+#if defined(DIFF_STATIC_MEMORY_EXCLUSIVE)
+        Scope() noexcept {}
+        ~Scope() {}
+#else
+        Scope() noexcept { ++depth(); }
+        ~Scope() { --depth(); }
+#endif
+        Scope(const Scope &) = delete;
+        Scope(Scope &&) = delete;
+
+        Scope &operator=(const Scope &) = delete;
+        Scope &operator=(Scope &&) = delete;
+    };
+
+    /**
+     * @brief Indicate whether a Scope is open on the calling thread. Always true in the exclusive mode.
+     */
+    static bool active() noexcept {
+#if defined(DIFF_STATIC_MEMORY_EXCLUSIVE)
+        return true;
+#else
+        return 0u != depth();
+#endif
+    }
+
+    /**
+     * @brief Allocate memory block.
+     *
+     * @param size Block size in bytes.
+     * @param alignment Block alignment, a power of two.
+     * @return Block pointer, or nullptr if the memory is exhausted.
+     */
+    static void *allocate(std::size_t size, std::size_t alignment = UNIT) noexcept {
+        alignment = std::max(alignment, UNIT);
+        if ((capacity() < size) || (capacity() < alignment)) {
+            return nullptr;
+        }
+        const std::size_t need = round(HEADER + (alignment - UNIT) + std::max(size, std::size_t{1u}));
+
+        std::size_t block = NONE;
+        {
+            const Lock lock;
+            std::size_t *pLink = &Storage<>::free;
+            while ((NONE != *pLink) && (word(*pLink) < need)) {
+                pLink = &link(*pLink);
+            }
+            if (NONE != *pLink) {
+                block = *pLink;
+                const std::size_t rest = word(block) - need;
+                if (HEADER <= rest) {   // Split - the rest stays free.
+                    word(block + need) = rest;
+                    link(block + need) = link(block);
+                    *pLink = block + need;
+                    word(block) = need;
+                } else {
+                    *pLink = link(block);
+                }
+            } else if (need <= (capacity() - Storage<>::top)) {
+                block = Storage<>::top;
+                Storage<>::top += need;
+                word(block) = need;
+            } else {
+                return nullptr;
+            }
+            Storage<>::used.fetch_add(word(block), std::memory_order_relaxed);
+        }
+
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(Storage<>::memory);
+        const std::size_t offset = static_cast<std::size_t>(((base + block + HEADER + alignment - 1u) & ~(static_cast<std::uintptr_t>(alignment) - 1u)) - base);
+        word(offset - sizeof(std::size_t)) = offset - block;
+        return Storage<>::memory + offset;
+    }
+
+    /**
+     * @brief @see allocate. Raise std::bad_alloc if the memory is exhausted (abort in exception-free mode).
+     */
+    static void *acquire(std::size_t size, std::size_t alignment = UNIT) { return check(allocate(size, alignment)); }
+
+    /**
+     * @brief Deallocate memory block, making it available to the subsequent allocations. Has no effect on blocks not allocated from StaticMemory.
+     *
+     * @param pMemory Block pointer.
+     */
+    static void deallocate(void *pMemory) noexcept {
+        if (!owns(pMemory)) {
+            return;
+        }
+        const std::size_t offset = static_cast<std::size_t>(static_cast<unsigned char *>(pMemory) - Storage<>::memory);
+        std::size_t block = offset - word(offset - sizeof(std::size_t));
+
+        const Lock lock;
+        Storage<>::used.fetch_sub(word(block), std::memory_order_relaxed);
+
+        // Free blocks are ordered by address - find the neighbours and merge with the adjacent ones.
+        std::size_t before = NONE, previous = NONE, next = Storage<>::free;
+        while ((NONE != next) && (next < block)) {
+            before = previous;
+            previous = next;
+            next = link(next);
+        }
+        if ((NONE != next) && ((block + word(block)) == next)) {
+            word(block) += word(next);
+            next = link(next);
+        }
+        link(block) = next;
+        if ((NONE != previous) && ((previous + word(previous)) == block)) {
+            word(previous) += word(block);
+            link(previous) = next;
+            block = previous;
+            previous = before;
+        } else {
+            ((NONE != previous) ? link(previous) : Storage<>::free) = block;
+        }
+
+        if ((block + word(block)) == Storage<>::top) {   // Last block - returned to the unused end.
+            Storage<>::top = block;
+            ((NONE != previous) ? link(previous) : Storage<>::free) = NONE;
+        }
+    }
+
+    /**
+     * @brief Indicate whether the block was allocated from StaticMemory.
+     *
+     * @param pMemory Block pointer.
+     */
+    static bool owns(const void *pMemory) noexcept {
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(pMemory);
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(Storage<>::memory);
+        return (base <= address) && (address < (base + capacity()));
+    }
+
+    /**
+     * @brief Return number of bytes of the blocks allocated and not deallocated, including their headers and alignment padding.
+     *
+     * @return Used bytes.
+     */
+    static std::size_t used() noexcept { return Storage<>::used.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Return number of bytes not used. The largest block available may be smaller, if the free memory is fragmented.
+     *
+     * @return Available bytes.
+     */
+    static std::size_t available() noexcept { return capacity() - used(); }
+
+    /**
+     * @brief Return size of the static memory.
+     *
+     * @return DIFF_STATIC_MEMORY_SIZE.
+     */
+    static constexpr std::size_t capacity() noexcept { return DIFF_STATIC_MEMORY_SIZE; }
+
+    /**
+     * @brief Return maximal number of bytes taken by a block of the default alignment beyond its size - header and padding.
+     *
+     * @return Overhead bytes.
+     */
+    static constexpr std::size_t overhead() noexcept { return HEADER + UNIT - 1u; }
+
+    /**
+     * @brief For the allocation functions of the application only (@see DIFF_STATIC_MEMORY_OPERATORS). Allocate memory block from StaticMemory
+     * while a Scope is open on the calling thread, from the heap otherwise. The heap is never used in the exclusive mode.
+     *
+     * @return Block pointer, or nullptr if the memory is exhausted.
+     */
+    static void *allocateRouted(std::size_t size, std::size_t alignment) noexcept {
+#if defined(DIFF_STATIC_MEMORY_EXCLUSIVE)
+        return allocate(size, alignment);
+#else
+        if (active()) {
+            return allocate(size, alignment);
+        }
+        if (alignment <= UNIT) {
+            return std::malloc(std::max(size, std::size_t{1u}));
+        }
+        // Over-aligned - the pointer returned by malloc stored just before the block.
+        void *const pMemory = std::malloc(size + alignment + sizeof(void *));
+        if (nullptr == pMemory) {
+            return nullptr;
+        }
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(pMemory) + sizeof(void *);
+        void **const pBlock = reinterpret_cast<void **>((address + alignment - 1u) & ~(static_cast<std::uintptr_t>(alignment) - 1u));
+        pBlock[-1] = pMemory;
+        return pBlock;
+#endif
+    }
+
+    /**
+     * @brief @see allocateRouted. Raise std::bad_alloc if the memory is exhausted (abort in exception-free mode).
+     */
+    static void *acquireRouted(std::size_t size, std::size_t alignment) { return check(allocateRouted(size, alignment)); }
+
+    /**
+     * @brief For the allocation functions of the application only (@see DIFF_STATIC_MEMORY_OPERATORS). Deallocate memory block - wherever it was
+     * allocated from, regardless of the Scope.
+     */
+    static void deallocateRouted(void *pMemory, std::size_t alignment) noexcept {
+#if defined(DIFF_STATIC_MEMORY_EXCLUSIVE)
+        static_cast<void>(alignment);
+        deallocate(pMemory);
+#else
+        if (owns(pMemory)) {
+            deallocate(pMemory);
+        } else if ((nullptr != pMemory) && (UNIT < alignment)) {
+            std::free(static_cast<void **>(pMemory)[-1]);
+        } else {
+            std::free(pMemory);
+        }
+#endif
+    }
+
+private:
+    static constexpr std::size_t UNIT = alignof(std::max_align_t);
+    static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+
+    // Block header - size of the block and, while the block is free, offset of the next free one. Offset of the block from the pointer returned is
+    // stored just before the pointer (within the header, unless over-aligned).
+    static constexpr std::size_t HEADER = ((2u * sizeof(std::size_t) + UNIT - 1u) / UNIT) * UNIT;
+
+    // Template, so that the storage is defined in the header once for the whole application. Constant-initialized - usable by static constructors.
+    template <typename = void>
+    struct Storage {
+        alignas(std::max_align_t) static unsigned char memory[DIFF_STATIC_MEMORY_SIZE];
+        static std::atomic_flag lock;
+        static std::size_t top;    // Offset of the unused end.
+        static std::size_t free;   // Offset of the first free block.
+        static std::atomic<std::size_t> used;
+    };
+
+    struct Lock {
+        Lock() noexcept {
+            while (Storage<>::lock.test_and_set(std::memory_order_acquire)) {
+            }
+        }
+        ~Lock() { Storage<>::lock.clear(std::memory_order_release); }
+    };
+
+    static std::size_t &depth() noexcept {
+        static thread_local std::size_t depth = 0u;
+        return depth;
+    }
+
+    static constexpr std::size_t round(std::size_t size) noexcept { return ((size + UNIT - 1u) / UNIT) * UNIT; }
+
+    static std::size_t &word(std::size_t offset) noexcept { return *reinterpret_cast<std::size_t *>(Storage<>::memory + offset); }
+    static std::size_t &link(std::size_t block) noexcept { return word(block + sizeof(std::size_t)); }
+
+    static void *check(void *pMemory) {
+        if (nullptr == pMemory) {
+#if defined(DIFF_NO_EXCEPTIONS)
+            std::abort();
+#else
+            throw std::bad_alloc{};
+#endif
+        }
+        return pMemory;
+    }
+};
+
+constexpr std::size_t StaticMemory::UNIT;
+constexpr std::size_t StaticMemory::NONE;
+constexpr std::size_t StaticMemory::HEADER;
+
+template <typename T>
+alignas(std::max_align_t) unsigned char StaticMemory::Storage<T>::memory[DIFF_STATIC_MEMORY_SIZE];
+
+template <typename T>
+std::atomic_flag StaticMemory::Storage<T>::lock = ATOMIC_FLAG_INIT;
+
+template <typename T>
+std::size_t StaticMemory::Storage<T>::top = 0u;
+
+template <typename T>
+std::size_t StaticMemory::Storage<T>::free = StaticMemory::NONE;
+
+template <typename T>
+std::atomic<std::size_t> StaticMemory::Storage<T>::used{0u};
+
+/**
+ * @brief Capacities a topology shall fit in to be built in the static memory mode. Checked up front, so a topology exceeding them is reported with
+ * an error before any component is instantiated, instead of running out of memory half way through the startup.
+ *
+ * The memory capacity defaults to the bytes of StaticMemory available at the time. A build is expected to take the bytes estimated by Footprint,
+ * the Build object along with its tables, and the worst case block overhead of each of its allocations (@see StaticMemory::overhead) - an estimate
+ * meant to err on the safe side, not a bound.
+ */
+struct StaticCapacity {
+    // Build object, its tables and registry - fixed part of every build, in bytes and blocks.
+    static constexpr std::size_t BUILD_BYTES = 1024u;
+    static constexpr std::size_t BUILD_BLOCKS = 16u;
+
+    // Blocks per component instance - storage, config array, registry and id table nodes, id strings, injected dependencies.
+    static constexpr std::size_t COMPONENT_BLOCKS = 10u;
+
+    std::size_t memory = StaticMemory::available();
+    std::size_t components = DIFF_STATIC_MAX_COMPONENTS;
+    std::size_t dependencies = DIFF_STATIC_MAX_DEPENDENCIES;
+    std::size_t strings = DIFF_STATIC_STRING_POOL;
+    std::size_t config = DIFF_STATIC_CONFIG_BYTES;
+
+    /**
+     * @brief Check whether the topology fits in the capacities. Values shared by multiple entries (@see SharedConfigEntry) are counted for each of
+     * them. Memory is checked for topologies of registered component types only - others fail to build anyway.
+     *
+     * @param topology Topology object to be checked.
+     * @return Nothing or CapacityExceeded description of the first capacity exceeded.
+     */
+    Result<> check(const Topology &topology) const {
+        std::size_t dependencyCount = 0u;
+        std::size_t stringBytes = 0u;
+        std::size_t configBytes = 0u;
+        std::size_t allocations = 0u;   // Blocks of the component instances.
+        for (const TopologyEntry &topologyEntry : topology) {
+            dependencyCount += topologyEntry.dependencyIds.size();
+            stringBytes += topologyEntry.type.size() + topologyEntry.id.size() + 2u;
+            for (const DependencyId &dependencyId : topologyEntry.dependencyIds) {
+                stringBytes += dependencyId.size() + 1u;
+            }
+            for (const std::unique_ptr<const ConfigEntry<>> &pConfigEntry : topologyEntry.config) {
+                stringBytes += pConfigEntry->key().size() + 1u;
+                configBytes += pConfigEntry->size();
+            }
+            allocations += COMPONENT_BLOCKS + topologyEntry.config.size() + topologyEntry.dependencyIds.size();
+        }
+
+        const Result<Footprint> footprint = Footprint::estimate(topology);
+        const std::size_t memoryBytes =
+            footprint ? (footprint.value().total() + BUILD_BYTES + (BUILD_BLOCKS + allocations) * StaticMemory::overhead()) : 0u;
+        if (memory < memoryBytes) {
+            return Error{ErrorCode::CAPACITY_EXCEEDED, "memory"s, std::to_string(memory), std::to_string(memoryBytes)};
+        }
+        if (components < topology.size()) {
+            return Error{ErrorCode::CAPACITY_EXCEEDED, "components"s, std::to_string(components), std::to_string(topology.size())};
+        }
+        if (dependencies < dependencyCount) {
+            return Error{ErrorCode::CAPACITY_EXCEEDED, "dependencies"s, std::to_string(dependencies), std::to_string(dependencyCount)};
+        }
+        if (strings < stringBytes) {
+            return Error{ErrorCode::CAPACITY_EXCEEDED, "strings"s, std::to_string(strings), std::to_string(stringBytes)};
+        }
+        if (config < configBytes) {
+            return Error{ErrorCode::CAPACITY_EXCEEDED, "config"s, std::to_string(config), std::to_string(configBytes)};
+        }
+        return {};
+    }
+};
+
+constexpr std::size_t StaticCapacity::BUILD_BYTES;
+constexpr std::size_t StaticCapacity::BUILD_BLOCKS;
+constexpr std::size_t StaticCapacity::COMPONENT_BLOCKS;
+
+}   // namespace diff
+
+#if defined(__cpp_aligned_new)
+#define DIFF_STATIC_MEMORY_ALIGNED_OPERATORS()                                                                                                      \
+    void *operator new(std::size_t size, std::align_val_t alignment) {                                                                              \
+        return ::diff::StaticMemory::acquireRouted(size, static_cast<std::size_t>(alignment));                                                      \
+    }                                                                                                                                               \
+    void *operator new[](std::size_t size, std::align_val_t alignment) {                                                                            \
+        return ::diff::StaticMemory::acquireRouted(size, static_cast<std::size_t>(alignment));                                                      \
+    }                                                                                                                                               \
+    void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {                                             \
+        return ::diff::StaticMemory::allocateRouted(size, static_cast<std::size_t>(alignment));                                                     \
+    }                                                                                                                                               \
+    void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {                                           \
+        return ::diff::StaticMemory::allocateRouted(size, static_cast<std::size_t>(alignment));                                                     \
+    }                                                                                                                                               \
+    void operator delete(void *pMemory, std::align_val_t alignment) noexcept {                                                                      \
+        ::diff::StaticMemory::deallocateRouted(pMemory, static_cast<std::size_t>(alignment));                                                       \
+    }                                                                                                                                               \
+    void operator delete[](void *pMemory, std::align_val_t alignment) noexcept {                                                                    \
+        ::diff::StaticMemory::deallocateRouted(pMemory, static_cast<std::size_t>(alignment));                                                       \
+    }                                                                                                                                               \
+    void operator delete(void *pMemory, std::size_t, std::align_val_t alignment) noexcept {                                                         \
+        ::diff::StaticMemory::deallocateRouted(pMemory, static_cast<std::size_t>(alignment));                                                       \
+    }                                                                                                                                               \
+    void operator delete[](void *pMemory, std::size_t, std::align_val_t alignment) noexcept {                                                       \
+        ::diff::StaticMemory::deallocateRouted(pMemory, static_cast<std::size_t>(alignment));                                                       \
+    }                                                                                                                                               \
+    void operator delete(void *pMemory, std::align_val_t alignment, const std::nothrow_t &) noexcept {                                              \
+        ::diff::StaticMemory::deallocateRouted(pMemory, static_cast<std::size_t>(alignment));                                                       \
+    }                                                                                                                                               \
+    void operator delete[](void *pMemory, std::align_val_t alignment, const std::nothrow_t &) noexcept {                                            \
+        ::diff::StaticMemory::deallocateRouted(pMemory, static_cast<std::size_t>(alignment));                                                       \
+    }
+#else
+#define DIFF_STATIC_MEMORY_ALIGNED_OPERATORS()
+#endif
+
+/**
+ * @brief Replace the allocation functions of the application with ones using StaticMemory within a Scope (or always, in the exclusive mode) and the
+ * heap otherwise (@see StaticMemory).
+ * Shall be used exactly once within the application, at global scope of one of its translation units.
+ */
+#define DIFF_STATIC_MEMORY_OPERATORS()                                                                                                              \
+    void *operator new(std::size_t size) { return ::diff::StaticMemory::acquireRouted(size, alignof(std::max_align_t)); }                           \
+    void *operator new[](std::size_t size) { return ::diff::StaticMemory::acquireRouted(size, alignof(std::max_align_t)); }                         \
+    void *operator new(std::size_t size, const std::nothrow_t &) noexcept {                                                                         \
+        return ::diff::StaticMemory::allocateRouted(size, alignof(std::max_align_t));                                                               \
+    }                                                                                                                                               \
+    void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {                                                                       \
+        return ::diff::StaticMemory::allocateRouted(size, alignof(std::max_align_t));                                                               \
+    }                                                                                                                                               \
+    void operator delete(void *pMemory) noexcept { ::diff::StaticMemory::deallocateRouted(pMemory, alignof(std::max_align_t)); }                    \
+    void operator delete[](void *pMemory) noexcept { ::diff::StaticMemory::deallocateRouted(pMemory, alignof(std::max_align_t)); }                  \
+    void operator delete(void *pMemory, std::size_t) noexcept { ::diff::StaticMemory::deallocateRouted(pMemory, alignof(std::max_align_t)); }       \
+    void operator delete[](void *pMemory, std::size_t) noexcept { ::diff::StaticMemory::deallocateRouted(pMemory, alignof(std::max_align_t)); }     \
+    void operator delete(void *pMemory, const std::nothrow_t &) noexcept {                                                                          \
+        ::diff::StaticMemory::deallocateRouted(pMemory, alignof(std::max_align_t));                                                                 \
+    }                                                                                                                                               \
+    void operator delete[](void *pMemory, const std::nothrow_t &) noexcept {                                                                        \
+        ::diff::StaticMemory::deallocateRouted(pMemory, alignof(std::max_align_t));                                                                 \
+    }                                                                                                                                               \
+    DIFF_STATIC_MEMORY_ALIGNED_OPERATORS()
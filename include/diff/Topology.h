@@ -41,6 +41,11 @@ struct TopologyEntry {
      * @brief Component instance configuration.
      */
     Config config;
+
+    /**
+     * @brief Slots of dependencyIds, assigned when the topology is finalized (@see DependencyIdTable). Empty if not assigned.
+     */
+    DependencySlots dependencySlots;
 };
 
 /**
@@ -55,7 +60,7 @@ using Topology = std::vector<TopologyEntry>;
  * @param topology Topology to be printed out.
  * @return Reference to os.
  */
-std::ostream &operator<<(std::ostream &os, const Topology &topology) {
+inline std::ostream &operator<<(std::ostream &os, const Topology &topology) {
     for (const TopologyEntry &topologyEntry : topology) {
         os << "topologyBuilder //\n    .component(\""s << topologyEntry.type << "\"s, \""s << topologyEntry.id << "\"s)"s;
 
@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 
 namespace diff {
 
@@ -63,7 +64,7 @@ public:
         template <typename T>
         TopologyEntryBuilder &config(const std::string &key, const T &value) {
             if (0 != topologyEntry_.config.count(key)) {
-                throw ConfigEntryKeyDuplicated(key);
+                ErrorHandler::raise(Error{ErrorCode::CONFIG_ENTRY_KEY_DUPLICATED, key});
             }
 
             std::unique_ptr<ConfigEntry<>> pEntry = std::make_unique<ConfigEntry<T>>(key, value);
@@ -72,6 +73,23 @@ public:
             return *this;
         }
 
+        /**
+         * @brief Add the given ConfigEntry.
+         * @exception ConfigEntryKeyDuplicated If ConfigEntry with the same key is already defined.
+         *
+         * @param pEntry ConfigEntry to be added.
+         * @return Reference to *this.
+         */
+        TopologyEntryBuilder &config(std::unique_ptr<const ConfigEntry<>> pEntry) {
+            if (0 != topologyEntry_.config.count(pEntry->key())) {
+                ErrorHandler::raise(Error{ErrorCode::CONFIG_ENTRY_KEY_DUPLICATED, pEntry->key()});
+            }
+
+            topologyEntry_.config.emplace(std::move(pEntry));
+
+            return *this;
+        }
+
     private:
         friend class TopologyBuilder;
 
@@ -81,11 +99,12 @@ public:
     };
 
     /**
-     * @brief Construct TopologyBuilder object. Topology object is cleared if not empty.
+     * @brief Construct TopologyBuilder object. Topology object is cleared if not empty. Entries shall be added with the builder only - ids are
+     * indexed for duplicate detection and lookup.
      *
      * @param topology Topology object to be configured.
      */
-    TopologyBuilder(Topology &topology) : topology_{topology} { topology_.clear(); }
+    TopologyBuilder(Topology &topology) : topology_{topology}, index_{} { topology_.clear(); }
     ~TopologyBuilder() = default;
 
     /**
@@ -97,17 +116,34 @@ public:
      * @return TopologyEntryBuilder object.
      */
     TopologyEntryBuilder component(const std::string &type, const std::string &id) {
-        if (std::any_of(topology_.cbegin(), topology_.cend(), [&id](const TopologyEntry &topologyEntry) { return topologyEntry.id == id; })) {
-            throw ComponentIdDuplicated(type, id);
+        if (!index_.emplace(id, topology_.size()).second) {
+            ErrorHandler::raise(Error{ErrorCode::COMPONENT_ID_DUPLICATED, type, id});
         }
 
-        topology_.emplace_back(TopologyEntry{type, id, {}, {}});
+        topology_.emplace_back(TopologyEntry{type, id, {}, {}, {}});
 
         return TopologyEntryBuilder{topology_.back()};
     }
 
+    /**
+     * @brief Check whether component with the given instance id is already defined.
+     *
+     * @param id Component instance id.
+     * @return True if defined, false otherwise.
+     */
+    bool has(const std::string &id) const { return index_.cend() != index_.find(id); }
+
+    /**
+     * @brief Return TopologyEntry of the component with the given instance id. Valid only if has(id).
+     *
+     * @param id Component instance id.
+     * @return TopologyEntry reference.
+     */
+    TopologyEntry &get(const std::string &id) { return topology_[index_.find(id)->second]; }
+
 private:
     Topology &topology_;
+    std::unordered_map<std::string, std::size_t> index_;
 };
 
 }   // namespace diff
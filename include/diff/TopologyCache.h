@@ -0,0 +1,474 @@
+#pragma once
+
+/**
+ * @file TopologyCache.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines TopologyCache class used to keep loaded topologies in binary images, to be reused by consecutive runs.
+ * @version 0.1
+ * @date 2025-04-09
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <diff/ComponentMetadata.h>
+#include <diff/FactoryRegistry.h>
+#include <diff/Sha256.h>
+#include <diff/TopologyLoader.h>
+#include <diff/TopologyValidator.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace diff {
+
+/**
+ * @brief Cache of loaded topologies, kept in a directory as binary images. An image is keyed by the digest of the topology files given (their paths
+ * and content) and of the factories available in the binary (@see fingerprint), so it is not reused once any component type is added, removed or
+ * changes its constructor, dependencies or config schema. Files included by the topology are recorded in the image, with digests of their content.
+ *
+ * On a hit the topology is read from the image - with no Json parsing and no type checking. On a miss it is loaded with TopologyLoader, type checked
+ * with TopologyValidator and written to the cache. Images are written to a temporary file first and renamed, so a concurrent reader never sees an
+ * incomplete one. Each image ends with a digest of its content, verified when it is read. Images failing verification are treated as a miss and
+ * overwritten.
+ *
+ * The directory shall exist. Failure to write an image is not reported - the cache is skipped.
+ */
+class TopologyCache final {
+public:
+    /**
+     * @brief Construct TopologyCache object.
+     *
+     * @param directory Cache directory path.
+     */
+    TopologyCache(const std::string &directory) : directory_{directory} {}
+    ~TopologyCache() = default;
+
+    /**
+     * @brief Load Topology from a Json file through the cache.
+     * @exception TopologyLoaderException If loading fails (@see TopologyLoader).
+     * @exception FactoryNotFound, DependencyCountMismatch, ... If type checking fails (@see TopologyValidator).
+     *
+     * @param path Json file path.
+     * @param topology Topology object to be initialized.
+     * @return True if loaded from the cache, false if loaded from the Json file (and cached).
+     */
+    bool load(const std::string &path, Topology &topology) const { return load(std::vector<std::string>{path}, topology); }
+
+    /**
+     * @brief @see load. Load Topology from multiple Json files (@see TopologyLoader::TopologyLoader(const std::vector<std::string> &)).
+     */
+    bool load(const std::vector<std::string> &paths, Topology &topology) const {
+        const Result<bool> result = tryLoad(paths, topology);
+        if (!result) {
+            ErrorHandler::raise(result.error());
+        }
+        return result.value();
+    }
+
+    /**
+     * @brief @see load. Report failure with the returned object instead of raising an error. Failures to read or parse the given files are raised
+     * nevertheless, unless in exception-free mode (@see TopologyLoader::TopologyLoader).
+     */
+    Result<bool> tryLoad(const std::vector<std::string> &paths, Topology &topology) const {
+        const Sha256::Digest factories = fingerprint();
+
+        std::map<std::string, Sha256::Digest> files;
+        for (const std::string &path : paths) {
+            std::string text;
+            if (!read(path, text)) {
+                files.clear();
+                break;
+            }
+            files.emplace(path, Sha256::of(text));
+        }
+        if (!files.empty() && readImage(image(key(paths, files, factories)), topology)) {
+            return true;
+        }
+
+        TopologyLoader topologyLoader{paths};
+        const Result<> loaded = topologyLoader.tryLoad(topology);
+        if (!loaded) {
+            return loaded.error();
+        }
+        const std::vector<Error> errors = TopologyValidator::validate(topology);
+        if (!errors.empty()) {
+            return errors.front();
+        }
+
+        // Keyed by the content actually loaded - the files may have changed in the meantime.
+        files = topologyLoader.files();
+        writeImage(image(key(paths, files, factories)), files, topology);
+        return false;
+    }
+
+    /**
+     * @brief Return digest of the factories available in the binary - component types along with their metadata (@see ComponentMetadata).
+     *
+     * @return Factory set digest.
+     */
+    static Sha256::Digest fingerprint() {
+        const FactoryRegistry &factoryRegistry = FactoryRegistry::getInstance();
+
+        std::vector<std::string> types;
+        for (const std::string &type : factoryRegistry.all()) {
+            types.emplace_back(type);
+        }
+        std::sort(types.begin(), types.end());
+
+        Sha256 result;
+        for (const std::string &type : types) {
+            const ComponentMetadata &metadata = factoryRegistry.get(type).metadata();
+            result.update(type);
+            update(result, metadata.arity);
+            for (const ComponentMetadata::Parameter &parameter : metadata.parameters) {
+                update(result, static_cast<std::uint64_t>(parameter.injection));
+                result.update((nullptr != parameter.pType) ? *parameter.pType : ""s);
+            }
+            for (const std::vector<const std::string *> *pTypes : {&metadata.provides, &metadata.sides, &metadata.indexedSides}) {
+                update(result, pTypes->size());
+                for (const std::string *pType : *pTypes) {
+                    result.update(*pType);
+                }
+            }
+            update(result, metadata.config.entries().size());
+            for (const auto &keyEntry : metadata.config.entries()) {
+                result.update(keyEntry.first).update(*keyEntry.second.pType).update(keyEntry.second.range);
+                update(result, keyEntry.second.required);
+            }
+        }
+        return result.digest();
+    }
+
+private:
+    static constexpr char MAGIC[8] = {'d', 'i', 'f', 'f', 't', 'o', 'p', 'o'};
+    static constexpr std::uint32_t VERSION = 1u;
+
+    /**
+     * @brief Type tag of a config entry in the image.
+     */
+    enum class Tag : std::uint8_t { BOOL, UINT8, UINT16, UINT32, UINT64, INT8, INT16, INT32, INT64, STRING, SHARED };
+
+    /**
+     * @brief Appends fixed-size little-endian integers and size-prefixed strings.
+     */
+    class Writer final {
+    public:
+        void integer(std::uint64_t value, std::size_t size = 8u) {
+            for (std::size_t i = 0u; i < size; ++i) {
+                data_.push_back(static_cast<char>(value >> (8u * i)));
+            }
+        }
+
+        void string(const std::string &value) {
+            integer(value.size());
+            data_.append(value);
+        }
+
+        void bytes(const void *pData, std::size_t size) { data_.append(static_cast<const char *>(pData), size); }
+
+        std::string &data() noexcept { return data_; }
+
+    private:
+        std::string data_;
+    };
+
+    /**
+     * @brief Reads what Writer wrote. Once reading goes out of bounds, ok() is false and all the values read are zero or empty.
+     */
+    class Reader final {
+    public:
+        Reader(const char *p, const char *end) : p_{p}, end_{end}, ok_{true} {}
+
+        std::uint64_t integer(std::size_t size = 8u) {
+            if (!check(size)) {
+                return 0u;
+            }
+            std::uint64_t result = 0u;
+            for (std::size_t i = 0u; i < size; ++i) {
+                result |= static_cast<std::uint64_t>(static_cast<unsigned char>(*p_++)) << (8u * i);
+            }
+            return result;
+        }
+
+        std::string string() {
+            const std::uint64_t size = integer();
+            if (!check(size)) {
+                return {};
+            }
+            std::string result{p_, static_cast<std::size_t>(size)};
+            p_ += size;
+            return result;
+        }
+
+        bool bytes(void *pData, std::size_t size) {
+            if (!check(size)) {
+                return false;
+            }
+            std::copy(p_, p_ + size, static_cast<char *>(pData));
+            p_ += size;
+            return true;
+        }
+
+        // Number of items to be read - each one takes at least a byte, which bounds memory reserved for corrupted counts.
+        std::size_t count() {
+            const std::uint64_t result = integer();
+            return check(result) ? static_cast<std::size_t>(result) : 0u;
+        }
+
+        bool ok() const noexcept { return ok_; }
+        bool done() const noexcept { return ok_ && (p_ == end_); }
+
+    private:
+        bool check(std::uint64_t size) {
+            ok_ = ok_ && (size <= static_cast<std::uint64_t>(end_ - p_));
+            return ok_;
+        }
+
+        const char *p_;
+        const char *const end_;
+        bool ok_;
+    };
+
+    static Sha256::Digest key(const std::vector<std::string> &paths, const std::map<std::string, Sha256::Digest> &files,
+                              const Sha256::Digest &factories) {
+        Sha256 result;
+        result.update(MAGIC, sizeof(MAGIC));
+        update(result, VERSION);
+        result.update(factories);
+        for (const std::string &path : paths) {
+            result.update(path).update(files.find(path)->second);
+        }
+        return result.digest();
+    }
+
+    template <typename T>
+    static void update(Sha256 &sha256, const T &value) {
+        const std::uint64_t integer = static_cast<std::uint64_t>(value);
+        sha256.update(&integer, sizeof(integer));
+    }
+
+    std::string image(const Sha256::Digest &key) const { return directory_ + "/"s + Sha256::toString(key) + ".topology"s; }
+
+    static bool read(const std::string &path, std::string &text) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        text.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+        return !file.bad();
+    }
+
+    static bool readImage(const std::string &path, Topology &topology) {
+        std::string data;
+        if (!read(path, data) || (data.size() < sizeof(MAGIC) + sizeof(Sha256::Digest))) {
+            return false;
+        }
+
+        const std::size_t size = data.size() - sizeof(Sha256::Digest);
+        const Sha256::Digest digest = Sha256{}.update(data.data(), size).digest();
+        if ((0 != std::memcmp(data.data(), MAGIC, sizeof(MAGIC))) || (0 != std::memcmp(data.data() + size, digest.data(), digest.size()))) {
+            return false;
+        }
+
+        Reader reader{data.data() + sizeof(MAGIC), data.data() + size};
+        if (VERSION != reader.integer(sizeof(VERSION))) {
+            return false;
+        }
+
+        for (std::size_t i = reader.count(); 0u < i; --i) {   // Included files - shall not have changed.
+            const std::string file = reader.string();
+            Sha256::Digest digest;
+            std::string text;
+            if (!reader.bytes(digest.data(), digest.size()) || !read(file, text) || (Sha256::of(text) != digest)) {
+                return false;
+            }
+        }
+
+        std::vector<std::shared_ptr<const ConfigEntry<>>> shared(reader.count());
+        for (std::shared_ptr<const ConfigEntry<>> &pShared : shared) {
+            const std::string key = reader.string();
+            std::unique_ptr<const ConfigEntry<>> pConfigEntry = readConfigEntry(reader, key, shared);
+            if (nullptr == pConfigEntry) {
+                return false;
+            }
+            pShared = std::move(pConfigEntry);
+        }
+
+        Topology result;
+        result.reserve(reader.count());
+        for (std::size_t i = result.capacity(); reader.ok() && (0u < i); --i) {
+            TopologyEntry topologyEntry;
+            topologyEntry.type = reader.string();
+            topologyEntry.id = reader.string();
+            topologyEntry.dependencyIds.resize(reader.count());
+            for (DependencyId &dependencyId : topologyEntry.dependencyIds) {
+                dependencyId = reader.string();
+            }
+            for (std::size_t j = reader.count(); 0u < j; --j) {
+                const std::string key = reader.string();
+                std::unique_ptr<const ConfigEntry<>> pConfigEntry = readConfigEntry(reader, key, shared);
+                if ((nullptr == pConfigEntry) || !topologyEntry.config.emplace(std::move(pConfigEntry)).second) {
+                    return false;
+                }
+            }
+            result.emplace_back(std::move(topologyEntry));
+        }
+
+        if (!reader.done()) {
+            return false;
+        }
+        topology = std::move(result);
+        return true;
+    }
+
+    static std::unique_ptr<const ConfigEntry<>> readConfigEntry(Reader &reader, const std::string &key,
+                                                               const std::vector<std::shared_ptr<const ConfigEntry<>>> &shared) {
+        const std::uint64_t tag = reader.integer(1u);
+        const std::uint64_t value = (static_cast<std::uint64_t>(Tag::STRING) == tag) ? 0u : reader.integer();
+        if (!reader.ok()) {
+            return nullptr;
+        }
+
+        switch (static_cast<Tag>(tag)) {
+            case Tag::BOOL:
+                return std::make_unique<ConfigEntry<bool>>(key, 0u != value);
+            case Tag::UINT8:
+                return std::make_unique<ConfigEntry<uint8_t>>(key, static_cast<uint8_t>(value));
+            case Tag::UINT16:
+                return std::make_unique<ConfigEntry<uint16_t>>(key, static_cast<uint16_t>(value));
+            case Tag::UINT32:
+                return std::make_unique<ConfigEntry<uint32_t>>(key, static_cast<uint32_t>(value));
+            case Tag::UINT64:
+                return std::make_unique<ConfigEntry<uint64_t>>(key, value);
+            case Tag::INT8:
+                return std::make_unique<ConfigEntry<int8_t>>(key, static_cast<int8_t>(value));
+            case Tag::INT16:
+                return std::make_unique<ConfigEntry<int16_t>>(key, static_cast<int16_t>(value));
+            case Tag::INT32:
+                return std::make_unique<ConfigEntry<int32_t>>(key, static_cast<int32_t>(value));
+            case Tag::INT64:
+                return std::make_unique<ConfigEntry<int64_t>>(key, static_cast<int64_t>(value));
+            case Tag::STRING: {
+                std::string string = reader.string();
+                return reader.ok() ? std::make_unique<ConfigEntry<std::string>>(key, string) : nullptr;
+            }
+            case Tag::SHARED:
+                return ((value < shared.size()) && (nullptr != shared[value])) ? std::make_unique<SharedConfigEntry>(key, shared[value]) : nullptr;
+        }
+        return nullptr;
+    }
+
+    static void writeImage(const std::string &path, const std::map<std::string, Sha256::Digest> &files, const Topology &topology) {
+        Writer writer;
+        writer.bytes(MAGIC, sizeof(MAGIC));
+        writer.integer(VERSION, sizeof(VERSION));
+
+        writer.integer(files.size());
+        for (const auto &pathDigest : files) {
+            writer.string(pathDigest.first);
+            writer.bytes(pathDigest.second.data(), pathDigest.second.size());
+        }
+
+        // Values shared by multiple entries (@see SharedConfigEntry) are written once, and referenced by index.
+        std::map<const ConfigEntry<> *, std::size_t> indices;
+        Writer shared;
+        for (const TopologyEntry &topologyEntry : topology) {
+            for (const std::unique_ptr<const ConfigEntry<>> &pConfigEntry : topologyEntry.config) {
+                const SharedConfigEntry *const pSharedEntry = dynamic_cast<const SharedConfigEntry *>(pConfigEntry.get());
+                if ((nullptr != pSharedEntry) && indices.emplace(pSharedEntry->shared().get(), indices.size()).second) {
+                    shared.string(pSharedEntry->shared()->key());
+                    if (!writeConfigEntry(shared, *pSharedEntry->shared(), indices)) {
+                        return;
+                    }
+                }
+            }
+        }
+        writer.integer(indices.size());
+        writer.data().append(shared.data());
+
+        writer.integer(topology.size());
+        for (const TopologyEntry &topologyEntry : topology) {
+            writer.string(topologyEntry.type);
+            writer.string(topologyEntry.id);
+            writer.integer(topologyEntry.dependencyIds.size());
+            for (const DependencyId &dependencyId : topologyEntry.dependencyIds) {
+                writer.string(dependencyId);
+            }
+            writer.integer(topologyEntry.config.size());
+            for (const std::unique_ptr<const ConfigEntry<>> &pConfigEntry : topologyEntry.config) {
+                writer.string(pConfigEntry->key());
+                if (!writeConfigEntry(writer, *pConfigEntry, indices)) {
+                    return;   // Not representable in the image - not cached.
+                }
+            }
+        }
+
+        const Sha256::Digest digest = Sha256{}.update(writer.data().data(), writer.data().size()).digest();
+        writer.bytes(digest.data(), digest.size());
+
+        // Unique across processes (by pid) and across threads of the process (by counter).
+        static std::atomic<unsigned> counter{0u};
+        const std::string temporary = path + "."s + std::to_string(::getpid()) + "."s + std::to_string(counter++);
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            if (!file.write(writer.data().data(), static_cast<std::streamsize>(writer.data().size())) || !file.flush()) {
+                file.close();
+                std::remove(temporary.c_str());
+                return;
+            }
+        }
+        if (0 != std::rename(temporary.c_str(), path.c_str())) {
+            std::remove(temporary.c_str());
+        }
+    }
+
+    static bool writeConfigEntry(Writer &writer, const ConfigEntry<> &configEntry, const std::map<const ConfigEntry<> *, std::size_t> &indices) {
+        const SharedConfigEntry *const pSharedEntry = dynamic_cast<const SharedConfigEntry *>(&configEntry);
+        if (nullptr != pSharedEntry) {
+            const auto it = indices.find(pSharedEntry->shared().get());
+            if (indices.cend() == it) {
+                return false;
+            }
+            writer.integer(static_cast<std::uint64_t>(Tag::SHARED), 1u);
+            writer.integer(it->second);
+            return true;
+        }
+
+        const std::string &type = configEntry.type();
+        if (Demangler::of<std::string>() == type) {
+            writer.integer(static_cast<std::uint64_t>(Tag::STRING), 1u);
+            writer.string(configEntry.value<std::string>());
+            return true;
+        }
+        return writeInteger<bool>(writer, configEntry, Tag::BOOL) || writeInteger<uint8_t>(writer, configEntry, Tag::UINT8) ||
+               writeInteger<uint16_t>(writer, configEntry, Tag::UINT16) || writeInteger<uint32_t>(writer, configEntry, Tag::UINT32) ||
+               writeInteger<uint64_t>(writer, configEntry, Tag::UINT64) || writeInteger<int8_t>(writer, configEntry, Tag::INT8) ||
+               writeInteger<int16_t>(writer, configEntry, Tag::INT16) || writeInteger<int32_t>(writer, configEntry, Tag::INT32) ||
+               writeInteger<int64_t>(writer, configEntry, Tag::INT64);
+    }
+
+    template <typename T>
+    static bool writeInteger(Writer &writer, const ConfigEntry<> &configEntry, Tag tag) {
+        if (Demangler::of<T>() != configEntry.type()) {
+            return false;
+        }
+        writer.integer(static_cast<std::uint64_t>(tag), 1u);
+        writer.integer(static_cast<std::uint64_t>(configEntry.value<T>()));
+        return true;
+    }
+
+    const std::string directory_;
+};
+
+constexpr char TopologyCache::MAGIC[8];
+constexpr std::uint32_t TopologyCache::VERSION;
+
+}   // namespace diff
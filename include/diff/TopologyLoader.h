@@ -10,9 +10,20 @@
  */
 
 #include <diff/Exception.h>
+#include <diff/Sha256.h>
 #include <diff/TopologyBuilder.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
 #include <nlohmann/json.hpp>
 
 namespace diff {
@@ -21,6 +32,27 @@ using namespace std::string_literals;
 
 /**
  * @brief Allows to initialize Topology object from Json.
+ *
+ * Besides components, the topology array may consist of templates - named sub-topologies with parameters, and their instances:
+ *     { "template" : "card", "parameters" : [ "card", "port" ], "components" : [
+ *         { "type" : "Phy", "id" : "${card}_phy", "config" : { "port" : "${port}" } },
+ *         { "type" : "Link", "id" : "${card}_link", "dependencies" : [ "${card}_phy" ] } ] },
+ *     { "instantiate" : "card", "arguments" : { "card" : "card0", "port" : { "uint16_t" : 1 } } }
+ * Parameters are referenced in ids, dependency ids and string config values. A config value consisting of a single reference takes the type of the
+ * argument. A template is validated and compiled once, then expanded into the Topology object for each of its instances, in order.
+ *
+ * A topology may also be composed of multiple files - included ones, and overlays adjusting the components defined so far:
+ *     { "include" : "common/board.json" },
+ *     { "overlay" : "card0_phy", "config" : { "port" : { "uint16_t" : 2 } } }
+ * An included file is loaded in place of the directive, its path is relative to the including file. A file included more than once (e.g. by two
+ * files sharing it) is loaded at its first include only. An overlay replaces the type and dependencies of the component if given, and the config
+ * entries given (the remaining ones are kept). All the files are read and parsed up front, in parallel. Entry index of a failure refers to the file
+ * consisting of the entry, named by the failure (@see Error::path).
+ *
+ * Values repeated across many components may be defined once, as variables, and referenced from config entries and template arguments:
+ *     { "variables" : { "broker" : "tcp://10.0.0.1:1883", "bufferSize" : { "uint32_t" : 65536 } } },
+ *     { "type" : "Client", "id" : "client0", "config" : { "address" : { "variable" : "broker" } } }
+ * A variable is loaded and type checked once, all the entries referencing it share its value (@see SharedConfigEntry).
  */
 class TopologyLoader final {
 public:
@@ -29,19 +61,43 @@ public:
     TopologyLoader(TopologyLoader&&) = delete;
 
     /**
-     * @brief Construct TopologyLoader object. Load Topology metadata from a Json file.
-     * @exception TopologyLoaderException If loading fails.
+     * @brief Construct TopologyLoader object. Load Topology metadata from a Json file, along with the files it includes.
+     * @exception TopologyLoaderException If loading fails. In exception-free mode the failure is reported by tryLoad instead.
      *
      * @param path Json file path.
      */
-    TopologyLoader(const std::string& path) : json_(loadFile(path)) {}
+    TopologyLoader(const std::string& path) : TopologyLoader{std::vector<std::string>{path}} {}
+
+    /**
+     * @brief Construct TopologyLoader object. Load Topology metadata from multiple Json files, along with the files they include. Files are loaded
+     * as if concatenated in the given order - typically a base topology followed by its overlays. Independent files are parsed in parallel.
+     * @exception TopologyLoaderException If loading of any of the given files fails. In exception-free mode the failure is reported by tryLoad
+     * instead, as are failures of the included files in both modes.
+     *
+     * @param paths Json file paths.
+     */
+    TopologyLoader(const std::vector<std::string>& paths) : documents_{}, roots_{paths} {
+        preload(paths);
+#if !defined(DIFF_NO_EXCEPTIONS)
+        for (const std::string& path : roots_) {
+            const Error& error = documents_.find(path)->second.error;
+            if (ErrorCode::NONE != error.code()) {
+                ErrorHandler::raise(error);
+            }
+        }
+#endif
+    }
 
     /**
-     * @brief Construct TopologyLoader object. Load Topology metadata from Json object.
+     * @brief Construct TopologyLoader object. Load Topology metadata from Json object, along with the files it includes (relative to the working
+     * directory).
      *
      * @param jsonTopology Json object.
      */
-    TopologyLoader(const nlohmann::json& jsonTopology) : json_(jsonTopology) {}
+    TopologyLoader(const nlohmann::json& jsonTopology) : documents_{}, roots_{""s} {
+        documents_.emplace(""s, Document{Error{}, jsonTopology, {}});
+        preload(includes(""s, jsonTopology));
+    }
 
     ~TopologyLoader() = default;
 
@@ -51,32 +107,82 @@ public:
     /**
      * @brief Load Json data into Topology object.
      * @exception TopologyLoaderException If loading fails.
+     * @exception ComponentIdDuplicated If component instance ids are not unique.
      *
      * @param topology Topology object to be initialized.
      */
     void load(Topology& topology) {
-        TopologyBuilder topologyBuilder{topology};
-
-        if (!json_.is_array()) {
-            throw TopologyLoaderException{"Topology json shall be an array."s};
+        const Result<> result = tryLoad(topology);
+        if (!result) {
+            ErrorHandler::raise(result.error());
         }
+    }
 
-        for (const auto& kv : json_.items()) {
-            const std::string componentIndex = kv.key();
-            const nlohmann::json componentJson = kv.value();
+    /**
+     * @brief @see load. Report failure with the returned object instead of raising an error. Never throws on malformed input - suitable for
+     * exception-free mode. The failure is described by structured fields (e.g. entry index, config key) and formatted only on request, so a
+     * successful load makes no diagnostics related allocations.
+     *
+     * @param topology Topology object to be initialized.
+     * @return Result object, describing TopologyLoaderException/ComponentIdDuplicated failure if loading fails.
+     */
+    Result<> tryLoad(Topology& topology) {
+        for (const std::string& path : roots_) {
+            const Error& error = documents_.find(path)->second.error;
+            if (ErrorCode::NONE != error.code()) {
+                return error;
+            }
+        }
 
-            if (!componentJson.is_object()) {
-                throw TopologyLoaderException{"Component{#"s + componentIndex + "} - Component shall be an object."s};
+        TopologyBuilder topologyBuilder{topology};
+        Templates templates;
+        Variables variables;
+        std::vector<std::string> includePaths;
+        std::set<std::string> loadedPaths;
+
+        for (const std::string& path : roots_) {
+            if (!loadedPaths.emplace(path).second) {
+                continue;
+            }
+            const Result<> result = loadDocument(path, topology, topologyBuilder, templates, variables, includePaths, loadedPaths);
+            if (!result) {
+                return result;
             }
+        }
 
-            const std::string componentType = loadType(componentIndex, componentJson);
-            const std::string componentId = loadId(componentIndex, componentJson);
+        return {};
+    }
 
-            TopologyBuilder::TopologyEntryBuilder topologyEntryBuilder = topologyBuilder.component(componentType, componentId);
+    /**
+     * @brief Return digest of the content of all the input files combined with their paths. Json objects given directly are hashed in their
+     * serialized form. Computed on each call - loading itsself computes no digests.
+     *
+     * @return Content digest.
+     */
+    Sha256::Digest hash() const {
+        Sha256 result;
+        for (const std::string& path : roots_) {
+            result.update(path);
+        }
+        for (const auto& pathDigest : files()) {
+            result.update(pathDigest.first).update(pathDigest.second);
+        }
+        return result.digest();
+    }
 
-            loadDependencies(componentIndex, componentType, componentId, componentJson, topologyEntryBuilder);
-            loadConfig(componentIndex, componentType, componentId, componentJson, topologyEntryBuilder);
+    /**
+     * @brief Return all the input files - the given ones and the ones they include, with digests of their content as loaded (@see TopologyCache).
+     * Computed on each call.
+     *
+     * @return Content digests by file path.
+     */
+    std::map<std::string, Sha256::Digest> files() const {
+        std::map<std::string, Sha256::Digest> result;
+        for (const auto& pathDocument : documents_) {
+            const Document& document = pathDocument.second;
+            result.emplace(pathDocument.first, Sha256::of(pathDocument.first.empty() ? document.json.dump() : document.text));
         }
+        return result;
     }
 
 private:
@@ -94,100 +200,391 @@ private:
     static const std::string TYPE_INT32;
     static const std::string TYPE_INT64;
 
-    nlohmann::json loadFile(const std::string& path) const {
-        std::ifstream file(path);
+    static const std::string KEY_TEMPLATE;
+    static const std::string KEY_PARAMETERS;
+    static const std::string KEY_COMPONENTS;
+    static const std::string KEY_INSTANTIATE;
+    static const std::string KEY_ARGUMENTS;
+    static const std::string KEY_INCLUDE;
+    static const std::string KEY_OVERLAY;
+    static const std::string KEY_VARIABLES;
+    static const std::string KEY_VARIABLE;
+
+    /**
+     * @brief String referencing template parameters as ${parameter}. Compiled once per template, expanded once per instance.
+     */
+    struct Pattern {
+        enum : std::size_t { NONE = static_cast<std::size_t>(-1) };
+
+        /**
+         * @brief Literal segments, each followed by the value of the parameter of the given index (NONE for no parameter).
+         */
+        std::vector<std::pair<std::string, std::size_t>> segments;
+
+        bool literal() const noexcept { return (1u == segments.size()) && (NONE == segments[0].second); }
+
+        /**
+         * @brief Return index of the parameter, if the pattern consists of a single parameter reference only. NONE otherwise.
+         */
+        std::size_t parameter() const noexcept {
+            return ((2u == segments.size()) && segments[0].first.empty() && segments[1].first.empty()) ? segments[0].second : NONE;
+        }
+
+        std::string expand(const std::vector<std::string>& arguments) const {
+            std::string result;
+            for (const std::pair<std::string, std::size_t>& segment : segments) {
+                result += segment.first;
+                if (NONE != segment.second) {
+                    result += arguments[segment.second];
+                }
+            }
+            return result;
+        }
+    };
+
+    /**
+     * @brief Component of a template. Config entries referencing parameters are kept apart from the literal ones.
+     */
+    struct TemplateComponent {
+        std::string type;
+        Pattern id;
+        std::vector<Pattern> dependencies;
+        Config config;
+        std::vector<std::pair<std::string /* key */, Pattern>> parameterizedConfig;
+    };
+
+    /**
+     * @brief Sub-topology, instantiated any number of times with different arguments.
+     */
+    struct Template {
+        std::vector<std::string> parameters;
+        std::vector<TemplateComponent> components;
+    };
+
+    using Templates = std::map<std::string, Template>;
+
+    using Variables = std::map<std::string, std::shared_ptr<const ConfigEntry<>>>;
+
+    /**
+     * @brief Input file - parsed Json data or the failure of loading it.
+     */
+    struct Document {
+        Error error;
+        nlohmann::json json;
+        std::string text;   // File content - hashed on request only.
+    };
+
+    static Document loadFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
         if (!file) {
-            throw TopologyLoaderException{"Topology file not accessible. Path: \""s + path + "\"."s};
+            return Document{Error{ErrorCode::TOPOLOGY_FILE_NOT_ACCESSIBLE, path}, nullptr, {}};
         }
+        std::string text{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
 
+#if defined(DIFF_NO_EXCEPTIONS)
+        nlohmann::json json = nlohmann::json::parse(text, nullptr, false, true);
+        if (json.is_discarded()) {
+            return Document{Error{ErrorCode::TOPOLOGY_SYNTAX_ERROR}, nullptr, {}};
+        }
+        return Document{Error{}, std::move(json), std::move(text)};
+#else
         try {
-            return nlohmann::json::parse(file, nullptr, true, true);
+            nlohmann::json json = nlohmann::json::parse(text, nullptr, true, true);
+            return Document{Error{}, std::move(json), std::move(text)};
         } catch (const nlohmann::json::parse_error& e) {
-            throw TopologyLoaderException{"Topology json syntax error. Details: \n"s + e.what()};
+            return Document{Error{ErrorCode::TOPOLOGY_SYNTAX_ERROR, e.what()}, nullptr, {}};
         }
+#endif
     }
 
-    std::string loadType(const std::string& componentIndex, const nlohmann::json& componentJson) {
-        const nlohmann::json::const_iterator it = componentJson.find(KEY_TYPE);
-        if (it == componentJson.cend()) {
-            throw TopologyLoaderException{"Component{#"s + componentIndex + "} - Component type shall be specified."s};
+    /**
+     * @brief Load the given files and the files they include, breadth first. Files of each level are parsed in parallel, by at most as many threads
+     * as the hardware runs concurrently.
+     */
+    void preload(std::vector<std::string> paths) {
+        while (!paths.empty()) {
+            std::vector<std::string> level;
+            for (std::string& path : paths) {
+                if ((0u == documents_.count(path)) && (level.cend() == std::find(level.cbegin(), level.cend(), path))) {
+                    level.emplace_back(std::move(path));
+                }
+            }
+
+            std::vector<Document> documents(level.size());
+            if (1u == level.size()) {
+                documents[0] = loadFile(level[0]);
+            } else if (!level.empty()) {
+                std::atomic<std::size_t> next{0u};
+                const auto work = [&documents, &level, &next]() {
+                    for (std::size_t i = next++; i < level.size(); i = next++) {
+                        documents[i] = loadFile(level[i]);
+                    }
+                };
+
+                const std::size_t workers = std::min<std::size_t>(level.size(), std::max(1u, std::thread::hardware_concurrency()));
+                std::vector<std::thread> threads;
+                threads.reserve(workers - 1u);
+                for (std::size_t i = 1u; i < workers; ++i) {
+                    threads.emplace_back(work);
+                }
+                work();   // The calling thread is one of the workers.
+                for (std::thread& thread : threads) {
+                    thread.join();
+                }
+            }
+
+            paths.clear();
+            for (std::size_t i = 0u; i < level.size(); ++i) {
+                const std::vector<std::string> includePaths = includes(level[i], documents[i].json);
+                paths.insert(paths.end(), includePaths.cbegin(), includePaths.cend());
+                documents_.emplace(std::move(level[i]), std::move(documents[i]));
+            }
         }
+    }
 
-        const nlohmann::json& json = *it;
-        if (!json.is_string()) {
-            throw TopologyLoaderException{"Component{#"s + componentIndex + "} - Component type shall be a string."s};
+    /**
+     * @brief Return resolved paths of the files included by the given Json data. Invalid include directives are skipped - reported by tryLoad.
+     */
+    static std::vector<std::string> includes(const std::string& path, const nlohmann::json& json) {
+        std::vector<std::string> result;
+        if (json.is_array()) {
+            for (const nlohmann::json& componentJson : json) {
+                const nlohmann::json::const_iterator it = componentJson.is_object() ? componentJson.find(KEY_INCLUDE) : componentJson.cend();
+                if ((it != componentJson.cend()) && it->is_string() && !it->get_ref<const std::string&>().empty()) {
+                    result.emplace_back(resolve(path, it->get_ref<const std::string&>()));
+                }
+            }
         }
+        return result;
+    }
 
-        const std::string result = json.get<std::string>();
-        if (result.empty()) {
-            throw TopologyLoaderException{"Component{#"s + componentIndex + "} - Component type shall not be empty."s};
+    /**
+     * @brief Return path of the included file, relative to the directory of the including file unless absolute.
+     */
+    static std::string resolve(const std::string& path, const std::string& includePath) {
+        const std::size_t separator = path.find_last_of('/');
+        return (('/' == includePath.front()) || (std::string::npos == separator)) ? includePath : (path.substr(0u, separator + 1u) + includePath);
+    }
+
+    /**
+     * @brief Load entries of the given file. Failures located in the file (or in the files it includes) name the file they are located in.
+     */
+    Result<> loadDocument(const std::string& path, Topology& topology, TopologyBuilder& topologyBuilder, Templates& templates, Variables& variables,
+                          std::vector<std::string>& includePaths, std::set<std::string>& loadedPaths) const {
+        const Document& document = documents_.find(path)->second;
+        if (ErrorCode::NONE != document.error.code()) {
+            return document.error;
         }
 
+        const Result<> result = loadEntries(path, document.json, topology, topologyBuilder, templates, variables, includePaths, loadedPaths);
+        if (!result && !path.empty() && result.error().path().empty()) {
+            return Error{result.error()}.in(path);
+        }
         return result;
     }
 
-    std::string loadId(const std::string& componentIndex, const nlohmann::json& componentJson) {
-        const nlohmann::json::const_iterator it = componentJson.find(KEY_ID);
+    Result<> loadEntries(const std::string& path, const nlohmann::json& json, Topology& topology, TopologyBuilder& topologyBuilder,
+                         Templates& templates, Variables& variables, std::vector<std::string>& includePaths, std::set<std::string>& loadedPaths) const {
+        if (!json.is_array()) {
+            return Error{ErrorCode::TOPOLOGY_NOT_AN_ARRAY};
+        }
+
+        includePaths.emplace_back(path);
+        topology.reserve(topology.size() + json.size());
+        for (std::size_t componentIndex = 0u; componentIndex < json.size(); ++componentIndex) {
+            const nlohmann::json& componentJson = json[componentIndex];
+
+            if (!componentJson.is_object()) {
+                return Error{ErrorCode::COMPONENT_NOT_AN_OBJECT}.at(componentIndex);
+            }
+
+            Result<> result;
+            if (componentJson.cend() != componentJson.find(KEY_INCLUDE)) {
+                result = include(componentIndex, componentJson, path, topology, topologyBuilder, templates, variables, includePaths, loadedPaths);
+            } else if (componentJson.cend() != componentJson.find(KEY_VARIABLES)) {
+                result = loadVariables(componentIndex, componentJson, variables);
+            } else if (componentJson.cend() != componentJson.find(KEY_OVERLAY)) {
+                result = overlay(componentIndex, componentJson, variables, topologyBuilder);
+            } else if (componentJson.cend() != componentJson.find(KEY_TEMPLATE)) {
+                result = loadTemplate(componentIndex, componentJson, variables, templates);
+            } else if (componentJson.cend() != componentJson.find(KEY_INSTANTIATE)) {
+                result = instantiate(componentIndex, componentJson, templates, variables, topologyBuilder);
+            } else {
+                result = loadComponent(componentIndex, componentJson, variables, topologyBuilder);
+            }
+            if (!result) {
+                return result;
+            }
+        }
+        includePaths.pop_back();
+
+        return {};
+    }
+
+    /**
+     * @brief Load the included file in place of the directive, unless already loaded - then the directive is skipped.
+     */
+    Result<> include(std::size_t componentIndex, const nlohmann::json& includeJson, const std::string& path, Topology& topology,
+                     TopologyBuilder& topologyBuilder, Templates& templates, Variables& variables, std::vector<std::string>& includePaths,
+                     std::set<std::string>& loadedPaths) const {
+        const Result<const std::string&> includePath = loadString(componentIndex, includeJson, KEY_INCLUDE, ErrorCode::INCLUDE_PATH_INVALID,
+                                                                  ErrorCode::INCLUDE_PATH_INVALID, ErrorCode::INCLUDE_PATH_INVALID);
+        if (!includePath) {
+            return includePath.error();
+        }
+
+        const std::string resolved = resolve(path, includePath.value());
+        if (includePaths.cend() != std::find(includePaths.cbegin(), includePaths.cend(), resolved)) {
+            return Error{ErrorCode::INCLUDE_CYCLE, resolved}.at(componentIndex);
+        }
+        if (!loadedPaths.emplace(resolved).second) {
+            return {};
+        }
+
+        return loadDocument(resolved, topology, topologyBuilder, templates, variables, includePaths, loadedPaths);
+    }
+
+    /**
+     * @brief Override the definition of an already defined component - its type if given, dependencies if given (replaced as a whole) and config
+     * entries given (replaced one by one, the remaining ones are kept).
+     */
+    static Result<> overlay(std::size_t componentIndex, const nlohmann::json& overlayJson, const Variables& variables, TopologyBuilder& topologyBuilder) {
+        const Result<const std::string&> componentId = loadString(componentIndex, overlayJson, KEY_OVERLAY, ErrorCode::OVERLAY_ID_INVALID,
+                                                                  ErrorCode::OVERLAY_ID_INVALID, ErrorCode::OVERLAY_ID_INVALID);
+        if (!componentId) {
+            return componentId.error();
+        }
+        if (!topologyBuilder.has(componentId.value())) {
+            return Error{ErrorCode::OVERLAY_TARGET_NOT_FOUND, componentId.value()}.at(componentIndex);
+        }
+        TopologyEntry& topologyEntry = topologyBuilder.get(componentId.value());
+
+        std::string componentType = topologyEntry.type;
+        if (overlayJson.cend() != overlayJson.find(KEY_TYPE)) {
+            const Result<const std::string&> type =
+                loadString(componentIndex, overlayJson, KEY_TYPE, ErrorCode::COMPONENT_TYPE_MISSING, ErrorCode::COMPONENT_TYPE_NOT_A_STRING,
+                           ErrorCode::COMPONENT_TYPE_EMPTY);
+            if (!type) {
+                return type.error();
+            }
+            componentType = type.value();
+        }
+
+        // Loaded and validated just like a component, then merged into the original one.
+        Topology topology;
+        TopologyBuilder overlayBuilder{topology};
+        TopologyBuilder::TopologyEntryBuilder topologyEntryBuilder = overlayBuilder.component(componentType, topologyEntry.id);
+
+        const Result<> dependencies = loadDependencies(componentIndex, componentType, topologyEntry.id, overlayJson, topologyEntryBuilder);
+        if (!dependencies) {
+            return dependencies;
+        }
+        const Result<> config = loadConfig(componentIndex, componentType, topologyEntry.id, overlayJson, variables, topologyEntryBuilder);
+        if (!config) {
+            return config;
+        }
+
+        TopologyEntry& overlayEntry = topology.front();
+        topologyEntry.type = std::move(componentType);
+        if (overlayJson.cend() != overlayJson.find(KEY_DEPENDENCIES)) {
+            topologyEntry.dependencyIds = std::move(overlayEntry.dependencyIds);
+        }
+        for (const std::unique_ptr<const ConfigEntry<>>& pConfigEntry : overlayEntry.config) {
+            const Config::const_iterator it = topologyEntry.config.find(pConfigEntry->key());
+            topologyEntry.config.emplace_hint((topologyEntry.config.cend() == it) ? it : topologyEntry.config.erase(it), pConfigEntry->clone());
+        }
+
+        return {};
+    }
+
+    static Result<> loadComponent(std::size_t componentIndex, const nlohmann::json& componentJson, const Variables& variables,
+                                  TopologyBuilder& topologyBuilder) {
+        const Result<const std::string&> componentType =
+            loadString(componentIndex, componentJson, KEY_TYPE, ErrorCode::COMPONENT_TYPE_MISSING, ErrorCode::COMPONENT_TYPE_NOT_A_STRING,
+                       ErrorCode::COMPONENT_TYPE_EMPTY);
+        if (!componentType) {
+            return componentType.error();
+        }
+        const Result<const std::string&> componentId =
+            loadString(componentIndex, componentJson, KEY_ID, ErrorCode::COMPONENT_ID_MISSING, ErrorCode::COMPONENT_ID_NOT_A_STRING,
+                       ErrorCode::COMPONENT_ID_EMPTY);
+        if (!componentId) {
+            return componentId.error();
+        }
+
+        if (topologyBuilder.has(componentId.value())) {
+            return Error{ErrorCode::COMPONENT_ID_DUPLICATED, componentType.value(), componentId.value()}.at(componentIndex);
+        }
+
+        TopologyBuilder::TopologyEntryBuilder topologyEntryBuilder = topologyBuilder.component(componentType.value(), componentId.value());
+
+        const Result<> dependencies = loadDependencies(componentIndex, componentType.value(), componentId.value(), componentJson, topologyEntryBuilder);
+        if (!dependencies) {
+            return dependencies;
+        }
+        const Result<> config = loadConfig(componentIndex, componentType.value(), componentId.value(), componentJson, variables, topologyEntryBuilder);
+        if (!config) {
+            return config;
+        }
+
+        return {};
+    }
+
+    static Result<const std::string&> loadString(std::size_t componentIndex, const nlohmann::json& componentJson, const std::string& key,
+                                                 ErrorCode missing, ErrorCode notAString, ErrorCode empty) {
+        const nlohmann::json::const_iterator it = componentJson.find(key);
         if (it == componentJson.cend()) {
-            throw TopologyLoaderException{"Component{#"s + componentIndex + "} - Component id shall be specified."s};
+            return Error{missing}.at(componentIndex);
         }
 
         const nlohmann::json& json = *it;
         if (!json.is_string()) {
-            throw TopologyLoaderException{"Component{#"s + componentIndex + "} - Component id shall be a string."s};
+            return Error{notAString}.at(componentIndex);
         }
 
-        const std::string result = json.get<std::string>();
+        const std::string& result = json.get_ref<const std::string&>();
         if (result.empty()) {
-            throw TopologyLoaderException{"Component{#"s + componentIndex + "} - Component id shall not be empty."s};
+            return Error{empty}.at(componentIndex);
         }
 
         return result;
     }
 
-    void loadDependencies(const std::string& componentIndex, const std::string& componentType, const std::string& componentId,
-                          const nlohmann::json& componentJson, TopologyBuilder::TopologyEntryBuilder& topologyEntryBuilder) {
+    static Result<> loadDependencies(std::size_t componentIndex, const std::string& componentType, const std::string& componentId,
+                                     const nlohmann::json& componentJson, TopologyBuilder::TopologyEntryBuilder& topologyEntryBuilder) {
         const nlohmann::json::const_iterator it = componentJson.find(KEY_DEPENDENCIES);
         if (it != componentJson.cend()) {
             const nlohmann::json& json = *it;
             if (!json.is_array()) {
-                throw TopologyLoaderException{"Component{#"s + componentIndex + ", \""s + componentType + "\" : \""s + componentId +
-                                              "\"} - Dependencies shall be an array."s};
+                return Error{ErrorCode::DEPENDENCIES_NOT_AN_ARRAY, componentType, componentId}.at(componentIndex);
             }
 
-            for (const auto& kv : json.items()) {
-                const std::string& dependencyIndex = kv.key();
-                const nlohmann::json& dependencyJson = kv.value();
+            for (std::size_t dependencyIndex = 0u; dependencyIndex < json.size(); ++dependencyIndex) {
+                const nlohmann::json& dependencyJson = json[dependencyIndex];
 
-                loadDependency(componentIndex, componentType, componentId, dependencyIndex, dependencyJson, topologyEntryBuilder);
-            }
-        }
-    }
+                if (!dependencyJson.is_string()) {
+                    return Error{ErrorCode::DEPENDENCY_NOT_A_STRING, componentType, componentId}.at(componentIndex, dependencyIndex);
+                }
 
-    void loadDependency(const std::string& componentIndex, const std::string& componentType, const std::string& componentId, const std::string& dependencyIndex,
-                        const nlohmann::json& dependencyJson, TopologyBuilder::TopologyEntryBuilder& topologyEntryBuilder) {
-        if (dependencyJson.is_string()) {
-            const std::string id = dependencyJson.get<std::string>();
-            if (id.empty()) {
-                throw TopologyLoaderException{"Component{#"s + componentIndex + ", \""s + componentType + "\" : \""s + componentId + "\"} : Dependency{#"s +
-                                              dependencyIndex + "} - Dependency id shall not be empty."s};
+                const std::string& id = dependencyJson.get_ref<const std::string&>();
+                if (id.empty()) {
+                    return Error{ErrorCode::DEPENDENCY_ID_EMPTY, componentType, componentId}.at(componentIndex, dependencyIndex);
+                }
+                topologyEntryBuilder.dependency(id);
             }
-            topologyEntryBuilder.dependency(id);
-
-        } else {
-            throw TopologyLoaderException{"Component{#"s + componentIndex + ", \""s + componentType + "\" : \""s + componentId + "\"} : Dependency{#"s +
-                                          dependencyIndex + "} - Dependency type shall be a string."s};
         }
+
+        return {};
     }
 
-    void loadConfig(const std::string& componentIndex, const std::string& componentType, const std::string& componentId, const nlohmann::json& componentJson,
-                    TopologyBuilder::TopologyEntryBuilder& topologyEntryBuilder) {
+    static Result<> loadConfig(std::size_t componentIndex, const std::string& componentType, const std::string& componentId,
+                               const nlohmann::json& componentJson, const Variables& variables,
+                               TopologyBuilder::TopologyEntryBuilder& topologyEntryBuilder) {
         const nlohmann::json::const_iterator it = componentJson.find(KEY_CONFIG);
         if (it != componentJson.cend()) {
             const nlohmann::json& json = *it;
             if (!json.is_object()) {
-                throw TopologyLoaderException{"Component{#"s + componentIndex + ", \""s + componentType + "\" : \""s + componentId +
-                                              "\"} - Config shall be an object."s};
+                return Error{ErrorCode::CONFIG_NOT_AN_OBJECT, componentType, componentId}.at(componentIndex);
             }
 
             for (const auto& kv : json.items()) {
@@ -195,91 +592,101 @@ private:
                 const nlohmann::json& entryJson = kv.value();
 
                 if (entryKey.empty()) {
-                    throw TopologyLoaderException{"Component{#"s + componentIndex + ", \""s + componentType + "\" : \""s + componentId +
-                                                  "\"} - Config shall not consist of empty keys."s};
+                    return Error{ErrorCode::CONFIG_KEY_EMPTY, componentType, componentId}.at(componentIndex);
                 }
 
-                loadConfigEntry(componentIndex, componentType, componentId, entryKey, entryJson, topologyEntryBuilder);
+                Result<std::unique_ptr<const ConfigEntry<>>> entry =
+                    loadConfigEntry(componentIndex, componentType, componentId, entryKey, entryJson, variables);
+                if (!entry) {
+                    return entry.error();
+                }
+                topologyEntryBuilder.config(std::move(entry.value()));
             }
         }
+
+        return {};
     }
 
-    void loadConfigEntry(const std::string& componentIndex, const std::string& componentType, const std::string& componentId, const std::string& entryKey,
-                         const nlohmann::json& entryJson, TopologyBuilder::TopologyEntryBuilder& topologyEntryBuilder) {
+    static Result<std::unique_ptr<const ConfigEntry<>>> loadConfigEntry(std::size_t componentIndex, const std::string& componentType,
+                                                                         const std::string& componentId, const std::string& entryKey,
+                                                                         const nlohmann::json& entryJson, const Variables& variables) {
         if (entryJson.is_boolean()) {
-            topologyEntryBuilder.config<bool>(entryKey, entryJson.get<bool>());
+            return makeConfigEntry<bool>(entryKey, entryJson.get<bool>());
 
         } else if (entryJson.is_number_unsigned()) {
-            topologyEntryBuilder.config<uint64_t>(entryKey, entryJson.get<uint64_t>());
+            return makeConfigEntry<uint64_t>(entryKey, entryJson.get<uint64_t>());
 
         } else if (entryJson.is_number_integer()) {
-            topologyEntryBuilder.config<int64_t>(entryKey, entryJson.get<int64_t>());
+            return makeConfigEntry<int64_t>(entryKey, entryJson.get<int64_t>());
 
         } else if (entryJson.is_string()) {
-            topologyEntryBuilder.config<std::string>(entryKey, entryJson.get<std::string>());
+            return makeConfigEntry<std::string>(entryKey, entryJson.get_ref<const std::string&>());
 
         } else if (entryJson.is_object()) {
             if (1u != entryJson.size()) {
-                throw TopologyLoaderException{"Component{#"s + componentIndex + ", \""s + componentType + "\" : \""s + componentId + "\"} : Config{\""s +
-                                              entryKey + "\"} - Config entry object shall be of size 1."s};
+                return Error{ErrorCode::CONFIG_ENTRY_OBJECT_SIZE, componentType, componentId, entryKey}.at(componentIndex);
             }
 
             const nlohmann::json::const_iterator it = entryJson.cbegin();
-            const std::string type = it.key();
+            const std::string& type = it.key();
             const nlohmann::json& json = it.value();
 
-            if ((TYPE_UINT8 == type) || (TYPE_UINT16 == type) || (TYPE_UINT32 == type) || (TYPE_UINT64 == type)) {
+            if (KEY_VARIABLE == type) {   // Reference to a variable - shares its value.
+                const Variables::const_iterator variableIt = json.is_string() ? variables.find(json.get_ref<const std::string&>()) : variables.cend();
+                if (variables.cend() == variableIt) {
+                    const std::string name = json.is_string() ? json.get<std::string>() : json.dump();
+                    return Error{ErrorCode::VARIABLE_NOT_FOUND, componentType, componentId, entryKey, name}.at(componentIndex);
+                }
+                return Result<std::unique_ptr<const ConfigEntry<>>>{std::make_unique<SharedConfigEntry>(entryKey, variableIt->second)};
+
+            } else if ((TYPE_UINT8 == type) || (TYPE_UINT16 == type) || (TYPE_UINT32 == type) || (TYPE_UINT64 == type)) {
                 if (!json.is_number_unsigned()) {
-                    throw TopologyLoaderException{"Component{#"s + componentIndex + ", \""s + componentType + "\" : \""s + componentId + "\"} : Config{\""s +
-                                                  entryKey + "\", "s + type + "} - Config entry value type shall be unsigned integer."s};
+                    return Error{ErrorCode::CONFIG_ENTRY_NOT_UNSIGNED, componentType, componentId, entryKey, type}.at(componentIndex);
                 }
 
                 const uint64_t value = json.get<uint64_t>();
                 if (TYPE_UINT8 == type) {
-                    loadConfigEntry<uint8_t>(componentIndex, componentType, componentId, entryKey, type, value, topologyEntryBuilder);
+                    return loadConfigEntry<uint8_t>(componentIndex, componentType, componentId, entryKey, type, value);
 
                 } else if (TYPE_UINT16 == type) {
-                    loadConfigEntry<uint16_t>(componentIndex, componentType, componentId, entryKey, type, value, topologyEntryBuilder);
+                    return loadConfigEntry<uint16_t>(componentIndex, componentType, componentId, entryKey, type, value);
 
                 } else if (TYPE_UINT32 == type) {
-                    loadConfigEntry<uint32_t>(componentIndex, componentType, componentId, entryKey, type, value, topologyEntryBuilder);
+                    return loadConfigEntry<uint32_t>(componentIndex, componentType, componentId, entryKey, type, value);
 
                 } else {   // (TYPE_UINT64 == type)
-                    loadConfigEntry<uint64_t>(componentIndex, componentType, componentId, entryKey, type, value, topologyEntryBuilder);
+                    return loadConfigEntry<uint64_t>(componentIndex, componentType, componentId, entryKey, type, value);
                 }
             } else if ((TYPE_INT8 == type) || (TYPE_INT16 == type) || (TYPE_INT32 == type) || (TYPE_INT64 == type)) {
                 if (!json.is_number_integer()) {
-                    throw TopologyLoaderException{"Component{#"s + componentIndex + ", \""s + componentType + "\" : \""s + componentId + "\"} : Config{\""s +
-                                                  entryKey + "\", "s + type + "} - Config entry value type shall be integer."s};
+                    return Error{ErrorCode::CONFIG_ENTRY_NOT_INTEGER, componentType, componentId, entryKey, type}.at(componentIndex);
                 }
 
                 const int64_t value = json.get<uint64_t>();
                 if (TYPE_INT8 == type) {
-                    loadConfigEntry<int8_t>(componentIndex, componentType, componentId, entryKey, type, value, topologyEntryBuilder);
+                    return loadConfigEntry<int8_t>(componentIndex, componentType, componentId, entryKey, type, value);
 
                 } else if (TYPE_INT16 == type) {
-                    loadConfigEntry<int16_t>(componentIndex, componentType, componentId, entryKey, type, value, topologyEntryBuilder);
+                    return loadConfigEntry<int16_t>(componentIndex, componentType, componentId, entryKey, type, value);
 
                 } else if (TYPE_INT32 == type) {
-                    loadConfigEntry<int32_t>(componentIndex, componentType, componentId, entryKey, type, value, topologyEntryBuilder);
+                    return loadConfigEntry<int32_t>(componentIndex, componentType, componentId, entryKey, type, value);
 
                 } else {   // (TYPE_INT64 == type)
-                    loadConfigEntry<int64_t>(componentIndex, componentType, componentId, entryKey, type, value, topologyEntryBuilder);
+                    return loadConfigEntry<int64_t>(componentIndex, componentType, componentId, entryKey, type, value);
                 }
             } else {
-                throw TopologyLoaderException{
-                    "Component{#"s + componentIndex + ", \""s + componentType + "\" : \""s + componentId + "\"} : Config{\""s + entryKey +
-                    "\"} - Config entry object type shall be one of {uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t, uint64_t, int64_t}."s};
+                return Error{ErrorCode::CONFIG_ENTRY_OBJECT_INVALID_TYPE, componentType, componentId, entryKey}.at(componentIndex);
             }
         } else {
-            throw TopologyLoaderException{"Component{#"s + componentIndex + ", \""s + componentType + "\" : \""s + componentId + "\"} : Config{\""s + entryKey +
-                                          "\"} - Config entry type shall be one of {bool, ungigned int, signed int, string, object}."s};
+            return Error{ErrorCode::CONFIG_ENTRY_INVALID_TYPE, componentType, componentId, entryKey}.at(componentIndex);
         }
     }
 
     template <typename T, typename U>
-    void loadConfigEntry(const std::string& componentIndex, const std::string& componentType, const std::string& componentId, const std::string& entryKey,
-                         const std::string& entryType, const U& entryValue, TopologyBuilder::TopologyEntryBuilder& topologyEntryBuilder) {
+    static Result<std::unique_ptr<const ConfigEntry<>>> loadConfigEntry(std::size_t componentIndex, const std::string& componentType,
+                                                                         const std::string& componentId, const std::string& entryKey,
+                                                                         const std::string& entryType, const U& entryValue) {
         static_assert(std::is_same<T, uint8_t>::value || std::is_same<T, int8_t>::value ||     //
                       std::is_same<T, uint16_t>::value || std::is_same<T, int16_t>::value ||   //
                       std::is_same<T, uint32_t>::value || std::is_same<T, int32_t>::value ||   //
@@ -287,15 +694,240 @@ private:
         static_assert(std::is_same<U, uint64_t>::value || std::is_same<U, int64_t>::value);
 
         if ((entryValue < static_cast<U>(std::numeric_limits<T>::min())) || (static_cast<U>(std::numeric_limits<T>::max()) < entryValue)) {
-            throw TopologyLoaderException{"Component{#"s + componentIndex + ", \""s + componentType + "\" : \""s + componentId + "\"} : Config{\""s + entryKey +
-                                          "\", "s + entryType + "{"s + std::to_string(entryValue) +
-                                          "}} - Config entry value shall be in range of its declared type."s};
+            return Error{ErrorCode::CONFIG_ENTRY_OUT_OF_RANGE, componentType, componentId, entryKey, entryType, std::to_string(entryValue)}.at(
+                componentIndex);
         }
 
-        topologyEntryBuilder.config<T>(entryKey, entryValue);
+        return makeConfigEntry<T>(entryKey, static_cast<T>(entryValue));
+    }
+
+    template <typename T>
+    static Result<std::unique_ptr<const ConfigEntry<>>> makeConfigEntry(const std::string& key, const T& value) {
+        return Result<std::unique_ptr<const ConfigEntry<>>>{std::make_unique<ConfigEntry<T>>(key, value)};
     }
 
-    const nlohmann::json json_;
+    /**
+     * @brief Define variables - each value is loaded once, then shared by all the config entries referencing it.
+     */
+    static Result<> loadVariables(std::size_t componentIndex, const nlohmann::json& variablesJson, Variables& variables) {
+        const nlohmann::json& json = *variablesJson.find(KEY_VARIABLES);
+        if (!json.is_object()) {
+            return Error{ErrorCode::VARIABLES_INVALID}.at(componentIndex);
+        }
+
+        for (const auto& kv : json.items()) {
+            const std::string& name = kv.key();
+            if (name.empty()) {
+                return Error{ErrorCode::VARIABLES_INVALID}.at(componentIndex);
+            }
+            if (0u != variables.count(name)) {
+                return Error{ErrorCode::VARIABLE_DUPLICATED, name}.at(componentIndex);
+            }
+
+            Result<std::unique_ptr<const ConfigEntry<>>> value = loadConfigEntry(componentIndex, KEY_VARIABLES, name, name, kv.value(), variables);
+            if (!value) {
+                return value.error();
+            }
+            variables.emplace(name, std::move(value.value()));
+        }
+
+        return {};
+    }
+
+    static Result<> loadTemplate(std::size_t componentIndex, const nlohmann::json& templateJson, const Variables& variables, Templates& templates) {
+        const Result<const std::string&> name = loadString(componentIndex, templateJson, KEY_TEMPLATE, ErrorCode::TEMPLATE_NAME_INVALID,
+                                                           ErrorCode::TEMPLATE_NAME_INVALID, ErrorCode::TEMPLATE_NAME_INVALID);
+        if (!name) {
+            return name.error();
+        }
+        if (0u != templates.count(name.value())) {
+            return Error{ErrorCode::TEMPLATE_DUPLICATED, name.value()}.at(componentIndex);
+        }
+
+        Template result;
+
+        const nlohmann::json::const_iterator parametersIt = templateJson.find(KEY_PARAMETERS);
+        if (parametersIt != templateJson.cend()) {
+            if (!parametersIt->is_array()) {
+                return Error{ErrorCode::TEMPLATE_PARAMETERS_INVALID, name.value()}.at(componentIndex);
+            }
+            for (const nlohmann::json& parameterJson : *parametersIt) {
+                if (!parameterJson.is_string()) {
+                    return Error{ErrorCode::TEMPLATE_PARAMETERS_INVALID, name.value()}.at(componentIndex);
+                }
+                const std::string& parameter = parameterJson.get_ref<const std::string&>();
+                if (parameter.empty() || (result.parameters.cend() != std::find(result.parameters.cbegin(), result.parameters.cend(), parameter))) {
+                    return Error{ErrorCode::TEMPLATE_PARAMETERS_INVALID, name.value()}.at(componentIndex);
+                }
+                result.parameters.emplace_back(parameter);
+            }
+        }
+
+        const nlohmann::json::const_iterator componentsIt = templateJson.find(KEY_COMPONENTS);
+        if ((componentsIt == templateJson.cend()) || !componentsIt->is_array()) {
+            return Error{ErrorCode::TEMPLATE_COMPONENTS_NOT_AN_ARRAY, name.value()}.at(componentIndex);
+        }
+
+        // Components are loaded and validated just like the top level ones, with parameter references left unresolved.
+        Topology topology;
+        TopologyBuilder topologyBuilder{topology};
+        for (const nlohmann::json& componentJson : *componentsIt) {
+            if (!componentJson.is_object()) {
+                return Error{ErrorCode::COMPONENT_NOT_AN_OBJECT}.at(componentIndex);
+            }
+            const Result<> component = loadComponent(componentIndex, componentJson, variables, topologyBuilder);
+            if (!component) {
+                return component;
+            }
+        }
+
+        for (TopologyEntry& topologyEntry : topology) {
+            TemplateComponent component{std::move(topologyEntry.type), {}, {}, {}, {}};
+
+            Result<Pattern> id = compile(componentIndex, name.value(), result.parameters, topologyEntry.id);
+            if (!id) {
+                return id.error();
+            }
+            component.id = std::move(id.value());
+
+            for (const DependencyId& dependencyId : topologyEntry.dependencyIds) {
+                Result<Pattern> dependency = compile(componentIndex, name.value(), result.parameters, dependencyId);
+                if (!dependency) {
+                    return dependency.error();
+                }
+                component.dependencies.emplace_back(std::move(dependency.value()));
+            }
+
+            for (Config::const_iterator it = topologyEntry.config.cbegin(); it != topologyEntry.config.cend();) {
+                const ConfigEntry<>& configEntry = **it;
+                if ((Demangler::of<std::string>() != configEntry.type()) || (nullptr != dynamic_cast<const SharedConfigEntry*>(&configEntry))) {
+                    ++it;
+                    continue;
+                }
+
+                Result<Pattern> value = compile(componentIndex, name.value(), result.parameters, configEntry.toString());
+                if (!value) {
+                    return value.error();
+                }
+                if (value.value().literal()) {
+                    ++it;
+                    continue;
+                }
+                component.parameterizedConfig.emplace_back(configEntry.key(), std::move(value.value()));
+                it = topologyEntry.config.erase(it);
+            }
+            component.config = std::move(topologyEntry.config);
+
+            result.components.emplace_back(std::move(component));
+        }
+
+        templates.emplace(name.value(), std::move(result));
+        return {};
+    }
+
+    static Result<Pattern> compile(std::size_t componentIndex, const std::string& templateName, const std::vector<std::string>& parameters,
+                                   const std::string& value) {
+        Pattern result;
+        std::size_t begin = 0u;
+        for (;;) {
+            const std::size_t open = value.find("${", begin);
+            const std::size_t close = (std::string::npos == open) ? std::string::npos : value.find('}', open + 2u);
+            if (std::string::npos == close) {
+                result.segments.emplace_back(value.substr(begin), Pattern::NONE);
+                return result;
+            }
+
+            const std::string parameter = value.substr(open + 2u, close - open - 2u);
+            const std::vector<std::string>::const_iterator it = std::find(parameters.cbegin(), parameters.cend(), parameter);
+            if (parameters.cend() == it) {
+                return Error{ErrorCode::TEMPLATE_PARAMETER_UNKNOWN, templateName, parameter}.at(componentIndex);
+            }
+
+            result.segments.emplace_back(value.substr(begin, open - begin), static_cast<std::size_t>(it - parameters.cbegin()));
+            begin = close + 1u;
+        }
+    }
+
+    static Result<> instantiate(std::size_t componentIndex, const nlohmann::json& instanceJson, const Templates& templates, const Variables& variables,
+                                TopologyBuilder& topologyBuilder) {
+        const Result<const std::string&> name = loadString(componentIndex, instanceJson, KEY_INSTANTIATE, ErrorCode::TEMPLATE_NAME_INVALID,
+                                                           ErrorCode::TEMPLATE_NAME_INVALID, ErrorCode::TEMPLATE_NAME_INVALID);
+        if (!name) {
+            return name.error();
+        }
+        const Templates::const_iterator templateIt = templates.find(name.value());
+        if (templates.cend() == templateIt) {
+            return Error{ErrorCode::TEMPLATE_NOT_FOUND, name.value()}.at(componentIndex);
+        }
+        const Template& instanceTemplate = templateIt->second;
+
+        static const nlohmann::json noArguments = nlohmann::json::object();
+        const nlohmann::json::const_iterator argumentsIt = instanceJson.find(KEY_ARGUMENTS);
+        const nlohmann::json& argumentsJson = (argumentsIt == instanceJson.cend()) ? noArguments : *argumentsIt;
+        if (!argumentsJson.is_object()) {
+            return Error{ErrorCode::TEMPLATE_ARGUMENTS_NOT_AN_OBJECT, name.value()}.at(componentIndex);
+        }
+        for (const auto& kv : argumentsJson.items()) {
+            if (instanceTemplate.parameters.cend() == std::find(instanceTemplate.parameters.cbegin(), instanceTemplate.parameters.cend(), kv.key())) {
+                return Error{ErrorCode::TEMPLATE_ARGUMENT_UNEXPECTED, name.value(), kv.key()}.at(componentIndex);
+            }
+        }
+
+        std::vector<std::unique_ptr<const ConfigEntry<>>> arguments;
+        std::vector<std::string> values;
+        arguments.reserve(instanceTemplate.parameters.size());
+        values.reserve(instanceTemplate.parameters.size());
+        for (const std::string& parameter : instanceTemplate.parameters) {
+            const nlohmann::json::const_iterator it = argumentsJson.find(parameter);
+            if (it == argumentsJson.cend()) {
+                return Error{ErrorCode::TEMPLATE_ARGUMENT_MISSING, name.value(), parameter}.at(componentIndex);
+            }
+
+            Result<std::unique_ptr<const ConfigEntry<>>> argument = loadConfigEntry(componentIndex, name.value(), ""s, parameter, *it, variables);
+            if (!argument) {
+                return argument.error();
+            }
+            values.emplace_back(argument.value()->toString());
+            arguments.emplace_back(std::move(argument.value()));
+        }
+
+        for (const TemplateComponent& component : instanceTemplate.components) {
+            const std::string id = component.id.expand(values);
+            if (id.empty()) {
+                return Error{ErrorCode::COMPONENT_ID_EMPTY}.at(componentIndex);
+            }
+            if (topologyBuilder.has(id)) {
+                return Error{ErrorCode::COMPONENT_ID_DUPLICATED, component.type, id}.at(componentIndex);
+            }
+
+            TopologyBuilder::TopologyEntryBuilder topologyEntryBuilder = topologyBuilder.component(component.type, id);
+
+            for (std::size_t dependencyIndex = 0u; dependencyIndex < component.dependencies.size(); ++dependencyIndex) {
+                const std::string dependencyId = component.dependencies[dependencyIndex].expand(values);
+                if (dependencyId.empty()) {
+                    return Error{ErrorCode::DEPENDENCY_ID_EMPTY, component.type, id}.at(componentIndex, dependencyIndex);
+                }
+                topologyEntryBuilder.dependency(dependencyId);
+            }
+
+            for (const std::unique_ptr<const ConfigEntry<>>& pConfigEntry : component.config) {
+                topologyEntryBuilder.config(pConfigEntry->clone());
+            }
+            for (const std::pair<std::string, Pattern>& keyPattern : component.parameterizedConfig) {
+                const std::size_t parameter = keyPattern.second.parameter();
+                if (Pattern::NONE != parameter) {   // The whole value - keeps the argument type.
+                    topologyEntryBuilder.config(arguments[parameter]->clone(keyPattern.first));
+                } else {
+                    topologyEntryBuilder.config(std::make_unique<ConfigEntry<std::string>>(keyPattern.first, keyPattern.second.expand(values)));
+                }
+            }
+        }
+
+        return {};
+    }
+
+    std::map<std::string /* path */, Document> documents_;
+    const std::vector<std::string> roots_;
 };
 
 const std::string TopologyLoader::KEY_TYPE{"type"s};
@@ -313,4 +945,14 @@ const std::string TopologyLoader::TYPE_INT16{"int16_t"s};
 const std::string TopologyLoader::TYPE_INT32{"int32_t"s};
 const std::string TopologyLoader::TYPE_INT64{"int64_t"s};
 
+const std::string TopologyLoader::KEY_TEMPLATE{"template"s};
+const std::string TopologyLoader::KEY_PARAMETERS{"parameters"s};
+const std::string TopologyLoader::KEY_COMPONENTS{"components"s};
+const std::string TopologyLoader::KEY_INSTANTIATE{"instantiate"s};
+const std::string TopologyLoader::KEY_ARGUMENTS{"arguments"s};
+const std::string TopologyLoader::KEY_INCLUDE{"include"s};
+const std::string TopologyLoader::KEY_OVERLAY{"overlay"s};
+const std::string TopologyLoader::KEY_VARIABLES{"variables"s};
+const std::string TopologyLoader::KEY_VARIABLE{"variable"s};
+
 }   // namespace diff
\ No newline at end of file
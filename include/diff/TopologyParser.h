@@ -0,0 +1,571 @@
+#pragma once
+
+/**
+ * @file TopologyParser.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines TopologyParser class used to load Topology from Json text without building a Json value tree.
+ * @version 0.1
+ * @date 2025-04-07
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <diff/TopologyLoader.h>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__GNUC__)
+#include <arm_neon.h>
+#endif
+
+namespace diff {
+
+/**
+ * @brief Fast path of TopologyLoader for Json text. Parses a topology of plain components - objects consisting of type, id, dependencies and config -
+ * straight into TopologyBuilder, with no Json value tree in between. Whitespace and string contents are scanned a block at a time (AVX2, SSE2 or NEON
+ * where available, scalar otherwise).
+ *
+ * Anything beyond that - templates, includes, overlays, variables, comments, unknown keys, escaped unicode or non-ASCII characters, as well as any
+ * invalid input - is handed over to TopologyLoader as is. Accepted topologies and reported failures are therefore the same as those of TopologyLoader.
+ */
+class TopologyParser final {
+public:
+    TopologyParser() = delete;
+
+    /**
+     * @brief Load Topology from Json text.
+     * @exception TopologyLoaderException If loading fails (@see TopologyLoader::load).
+     *
+     * @param text Json text.
+     * @param topology Topology object to be initialized.
+     */
+    static void load(const std::string &text, Topology &topology) {
+        const Result<> result = tryLoad(text, topology);
+        if (!result) {
+            ErrorHandler::raise(result.error());
+        }
+    }
+
+    /**
+     * @brief @see load. Report failure with the returned object instead of raising an error.
+     *
+     * @param text Json text.
+     * @param topology Topology object to be initialized.
+     * @return Failure description, if any.
+     */
+    static Result<> tryLoad(const std::string &text, Topology &topology) {
+        if (tryParse(text, topology)) {
+            return {};
+        }
+
+#if defined(DIFF_NO_EXCEPTIONS)
+        const nlohmann::json json = nlohmann::json::parse(text, nullptr, false, true);
+        if (json.is_discarded()) {
+            return Error{ErrorCode::TOPOLOGY_SYNTAX_ERROR};
+        }
+#else
+        nlohmann::json json;
+        try {
+            json = nlohmann::json::parse(text, nullptr, true, true);
+        } catch (const nlohmann::json::parse_error &e) {
+            return Error{ErrorCode::TOPOLOGY_SYNTAX_ERROR, e.what()};
+        }
+#endif
+        return TopologyLoader{json}.tryLoad(topology);
+    }
+
+    /**
+     * @brief Load Topology from Json text with the fast path only.
+     *
+     * @param text Json text.
+     * @param topology Topology object to be initialized. Its content is unspecified if the text is not accepted.
+     * @return True if the text is a valid topology of plain components, false if it is to be handed over to TopologyLoader.
+     */
+    static bool tryParse(const std::string &text, Topology &topology) {
+        TopologyBuilder topologyBuilder{topology};
+        Parser parser{text.data(), text.data() + text.size()};
+        return parser.topology(topologyBuilder);
+    }
+
+private:
+    using ConfigEntries = std::vector<std::unique_ptr<const ConfigEntry<>>>;
+
+    /**
+     * @brief Block scanning kernels. Both return the end of the range if no byte is found.
+     */
+    struct Scanner {
+        // First byte which is not Json whitespace.
+        static const char *skipWhitespace(const char *p, const char *end) noexcept {
+#if defined(__AVX2__)
+            for (; p + 32 <= end; p += 32) {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+                const __m256i ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'))),
+                                                   _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'))));
+                const std::uint32_t mask = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(ws));
+                if (0u != mask) {
+                    return p + firstSet(mask);
+                }
+            }
+#elif defined(__SSE2__) || defined(_M_X64)
+            for (; p + 16 <= end; p += 16) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+                const __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))),
+                                                _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\t')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+                const std::uint32_t mask = ~static_cast<std::uint32_t>(_mm_movemask_epi8(ws)) & 0xffffu;
+                if (0u != mask) {
+                    return p + firstSet(mask);
+                }
+            }
+#elif defined(__ARM_NEON) && defined(__GNUC__)
+            for (; p + 16 <= end; p += 16) {
+                const uint8x16_t v = vld1q_u8(reinterpret_cast<const std::uint8_t *>(p));
+                const uint8x16_t ws = vorrq_u8(vorrq_u8(vceqq_u8(v, vdupq_n_u8(' ')), vceqq_u8(v, vdupq_n_u8('\n'))),
+                                               vorrq_u8(vceqq_u8(v, vdupq_n_u8('\t')), vceqq_u8(v, vdupq_n_u8('\r'))));
+                const std::uint64_t mask = ~nibbleMask(ws);
+                if (0u != mask) {
+                    return p + (__builtin_ctzll(mask) >> 2);
+                }
+            }
+#endif
+            for (; (p < end) && isWhitespace(*p); ++p) {
+            }
+            return p;
+        }
+
+        // First byte which ends a plain run of string characters - quote, backslash, control or non-ASCII character.
+        static const char *findSpecial(const char *p, const char *end) noexcept {
+#if defined(__AVX2__)
+            for (; p + 32 <= end; p += 32) {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+                const __m256i quote = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+                const __m256i special = _mm256_or_si256(quote, _mm256_cmpgt_epi8(_mm256_set1_epi8(0x20), v));   // Signed - includes bytes >= 0x80.
+                const std::uint32_t mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(special));
+                if (0u != mask) {
+                    return p + firstSet(mask);
+                }
+            }
+#elif defined(__SSE2__) || defined(_M_X64)
+            for (; p + 16 <= end; p += 16) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+                const __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))),
+                                                     _mm_cmplt_epi8(v, _mm_set1_epi8(0x20)));   // Signed - includes bytes >= 0x80.
+                const std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(special));
+                if (0u != mask) {
+                    return p + firstSet(mask);
+                }
+            }
+#elif defined(__ARM_NEON) && defined(__GNUC__)
+            for (; p + 16 <= end; p += 16) {
+                const uint8x16_t v = vld1q_u8(reinterpret_cast<const std::uint8_t *>(p));
+                const uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(v, vdupq_n_u8('"')), vceqq_u8(v, vdupq_n_u8('\\'))),
+                                                    vorrq_u8(vcltq_u8(v, vdupq_n_u8(0x20)), vcgeq_u8(v, vdupq_n_u8(0x80))));
+                const std::uint64_t mask = nibbleMask(special);
+                if (0u != mask) {
+                    return p + (__builtin_ctzll(mask) >> 2);
+                }
+            }
+#endif
+            for (; (p < end) && !isSpecial(*p); ++p) {
+            }
+            return p;
+        }
+
+        static bool isWhitespace(char c) noexcept { return (' ' == c) || ('\n' == c) || ('\t' == c) || ('\r' == c); }
+
+        static bool isSpecial(char c) noexcept {
+            return ('"' == c) || ('\\' == c) || (static_cast<unsigned char>(c) < 0x20u) || (0x80u <= static_cast<unsigned char>(c));
+        }
+
+    private:
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+        static unsigned firstSet(std::uint32_t mask) noexcept {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+        }
+#elif defined(__ARM_NEON) && defined(__GNUC__)
+        // 4 bits per byte of the comparison result.
+        static std::uint64_t nibbleMask(uint8x16_t comparison) noexcept {
+            return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(comparison), 4)), 0);
+        }
+#endif
+    };
+
+    /**
+     * @brief Recursive descent over the topology schema. Each method returns false as soon as the input is not accepted.
+     */
+    class Parser final {
+    public:
+        Parser(const char *p, const char *end) : p_{p}, end_{end} {}
+
+        bool topology(TopologyBuilder &topologyBuilder) {
+            skipWhitespace();
+            if (!consume('[')) {
+                return false;
+            }
+
+            skipWhitespace();
+            if (!consume(']')) {
+                do {
+                    skipWhitespace();
+                    if (!component(topologyBuilder)) {
+                        return false;
+                    }
+                    skipWhitespace();
+                } while (consume(','));
+
+                if (!consume(']')) {
+                    return false;
+                }
+            }
+
+            skipWhitespace();
+            return p_ == end_;
+        }
+
+    private:
+        bool component(TopologyBuilder &topologyBuilder) {
+            if (!consume('{')) {
+                return false;
+            }
+
+            std::string type;
+            std::string id;
+            std::vector<std::string> dependencyIds;
+            ConfigEntries config;
+            bool hasType = false;
+            bool hasId = false;
+            bool hasDependencies = false;
+            bool hasConfig = false;
+
+            do {
+                skipWhitespace();
+                const char *key = nullptr;
+                std::size_t size = 0u;
+                if (!rawString(key, size) || !separator()) {
+                    return false;
+                }
+
+                if (equals(key, size, "type")) {
+                    if (hasType || !string(type)) {
+                        return false;
+                    }
+                    hasType = true;
+                } else if (equals(key, size, "id")) {
+                    if (hasId || !string(id)) {
+                        return false;
+                    }
+                    hasId = true;
+                } else if (equals(key, size, "dependencies")) {
+                    if (hasDependencies || !dependencies(dependencyIds)) {
+                        return false;
+                    }
+                    hasDependencies = true;
+                } else if (equals(key, size, "config")) {
+                    if (hasConfig || !configObject(config)) {
+                        return false;
+                    }
+                    hasConfig = true;
+                } else {
+                    return false;
+                }
+                skipWhitespace();
+            } while (consume(','));
+
+            if (!consume('}') || type.empty() || id.empty() || topologyBuilder.has(id)) {
+                return false;
+            }
+
+            TopologyBuilder::TopologyEntryBuilder topologyEntryBuilder = topologyBuilder.component(type, id);
+            for (const std::string &dependencyId : dependencyIds) {
+                topologyEntryBuilder.dependency(dependencyId);
+            }
+            for (std::unique_ptr<const ConfigEntry<>> &pConfigEntry : config) {
+                topologyEntryBuilder.config(std::move(pConfigEntry));
+            }
+            return true;
+        }
+
+        bool dependencies(std::vector<std::string> &dependencyIds) {
+            if (!consume('[')) {
+                return false;
+            }
+            skipWhitespace();
+            if (consume(']')) {
+                return true;
+            }
+
+            do {
+                skipWhitespace();
+                std::string dependencyId;
+                if (!string(dependencyId) || dependencyId.empty()) {
+                    return false;
+                }
+                dependencyIds.emplace_back(std::move(dependencyId));
+                skipWhitespace();
+            } while (consume(','));
+
+            return consume(']');
+        }
+
+        bool configObject(ConfigEntries &config) {
+            if (!consume('{')) {
+                return false;
+            }
+            skipWhitespace();
+            if (consume('}')) {
+                return true;
+            }
+
+            do {
+                skipWhitespace();
+                std::string key;
+                if (!string(key) || key.empty() || !separator()) {
+                    return false;
+                }
+                for (const std::unique_ptr<const ConfigEntry<>> &pConfigEntry : config) {
+                    if (pConfigEntry->key() == key) {
+                        return false;
+                    }
+                }
+                if (!configEntry(key, config)) {
+                    return false;
+                }
+                skipWhitespace();
+            } while (consume(','));
+
+            return consume('}');
+        }
+
+        bool configEntry(const std::string &key, ConfigEntries &config) {
+            if (p_ == end_) {
+                return false;
+            }
+
+            switch (*p_) {
+                case '"': {
+                    std::string value;
+                    if (!string(value)) {
+                        return false;
+                    }
+                    config.emplace_back(std::make_unique<ConfigEntry<std::string>>(key, value));
+                    return true;
+                }
+                case 't':
+                    return literal("true") && add<bool>(key, true, config);
+                case 'f':
+                    return literal("false") && add<bool>(key, false, config);
+                case '{':
+                    return typedConfigEntry(key, config);
+                default: {
+                    bool negative = false;
+                    std::uint64_t magnitude = 0u;
+                    if (!number(negative, magnitude)) {
+                        return false;
+                    }
+                    return negative ? add<int64_t>(key, negate<int64_t>(magnitude), config) : add<uint64_t>(key, magnitude, config);
+                }
+            }
+        }
+
+        // { "<type>" : <integer> }
+        bool typedConfigEntry(const std::string &key, ConfigEntries &config) {
+            ++p_;
+            skipWhitespace();
+            const char *type = nullptr;
+            std::size_t size = 0u;
+            bool negative = false;
+            std::uint64_t magnitude = 0u;
+            if (!rawString(type, size) || !separator() || !number(negative, magnitude)) {
+                return false;
+            }
+            skipWhitespace();
+            if (!consume('}')) {
+                return false;
+            }
+
+            if (equals(type, size, "uint8_t")) {
+                return add<uint8_t>(key, negative, magnitude, config);
+            } else if (equals(type, size, "uint16_t")) {
+                return add<uint16_t>(key, negative, magnitude, config);
+            } else if (equals(type, size, "uint32_t")) {
+                return add<uint32_t>(key, negative, magnitude, config);
+            } else if (equals(type, size, "uint64_t")) {
+                return add<uint64_t>(key, negative, magnitude, config);
+            } else if (equals(type, size, "int8_t")) {
+                return add<int8_t>(key, negative, magnitude, config);
+            } else if (equals(type, size, "int16_t")) {
+                return add<int16_t>(key, negative, magnitude, config);
+            } else if (equals(type, size, "int32_t")) {
+                return add<int32_t>(key, negative, magnitude, config);
+            } else if (equals(type, size, "int64_t")) {
+                return add<int64_t>(key, negative, magnitude, config);
+            }
+            return false;
+        }
+
+        template <typename T>
+        static bool add(const std::string &key, const T &value, ConfigEntries &config) {
+            config.emplace_back(std::make_unique<ConfigEntry<T>>(key, value));
+            return true;
+        }
+
+        // Values out of range of T are left for TopologyLoader to report.
+        template <typename T>
+        static bool add(const std::string &key, bool negative, std::uint64_t magnitude, ConfigEntries &config) {
+            if (negative) {
+                const std::uint64_t limit = static_cast<std::uint64_t>(std::numeric_limits<T>::max()) + 1u;
+                return std::is_signed<T>::value && (magnitude <= limit) && add<T>(key, negate<T>(magnitude), config);
+            }
+            return (magnitude <= static_cast<std::uint64_t>(std::numeric_limits<T>::max())) && add<T>(key, static_cast<T>(magnitude), config);
+        }
+
+        template <typename T>
+        static T negate(std::uint64_t magnitude) noexcept {
+            return (0u == magnitude) ? static_cast<T>(0) : static_cast<T>(-static_cast<std::int64_t>(magnitude - 1u) - 1);
+        }
+
+        // Integer within the range of int64_t (if negative) or uint64_t. Fractions and exponents are not accepted.
+        bool number(bool &negative, std::uint64_t &magnitude) {
+            negative = consume('-');
+            if ((p_ == end_) || (*p_ < '0') || ('9' < *p_)) {
+                return false;
+            }
+
+            magnitude = 0u;
+            if ('0' == *p_) {
+                ++p_;
+            } else {
+                for (; (p_ < end_) && ('0' <= *p_) && (*p_ <= '9'); ++p_) {
+                    const std::uint64_t digit = static_cast<std::uint64_t>(*p_ - '0');
+                    if (magnitude > (std::numeric_limits<std::uint64_t>::max() - digit) / 10u) {
+                        return false;
+                    }
+                    magnitude = magnitude * 10u + digit;
+                }
+            }
+
+            if ((p_ < end_) && ((('0' <= *p_) && (*p_ <= '9')) || ('.' == *p_) || ('e' == *p_) || ('E' == *p_))) {
+                return false;
+            }
+            return !negative || (magnitude <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()) + 1u);
+        }
+
+        // String with escape sequences other than \uXXXX decoded.
+        bool string(std::string &value) {
+            if (!consume('"')) {
+                return false;
+            }
+
+            for (;;) {
+                const char *const begin = p_;
+                p_ = Scanner::findSpecial(p_, end_);
+                value.append(begin, p_);
+                if (p_ == end_) {
+                    return false;
+                }
+
+                const char c = *p_++;
+                if ('"' == c) {
+                    return true;
+                }
+                if (('\\' != c) || (p_ == end_)) {   // Control or non-ASCII character.
+                    return false;
+                }
+
+                switch (*p_++) {
+                    case '"':
+                        value.push_back('"');
+                        break;
+                    case '\\':
+                        value.push_back('\\');
+                        break;
+                    case '/':
+                        value.push_back('/');
+                        break;
+                    case 'b':
+                        value.push_back('\b');
+                        break;
+                    case 'f':
+                        value.push_back('\f');
+                        break;
+                    case 'n':
+                        value.push_back('\n');
+                        break;
+                    case 'r':
+                        value.push_back('\r');
+                        break;
+                    case 't':
+                        value.push_back('\t');
+                        break;
+                    default:
+                        return false;
+                }
+            }
+        }
+
+        // String referenced in place - with no escape sequences.
+        bool rawString(const char *&value, std::size_t &size) {
+            if (!consume('"')) {
+                return false;
+            }
+            value = p_;
+            p_ = Scanner::findSpecial(p_, end_);
+            size = static_cast<std::size_t>(p_ - value);
+            return consume('"');
+        }
+
+        bool literal(const char *text) {
+            for (; '\0' != *text; ++text, ++p_) {
+                if ((p_ == end_) || (*p_ != *text)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool separator() {
+            skipWhitespace();
+            if (!consume(':')) {
+                return false;
+            }
+            skipWhitespace();
+            return true;
+        }
+
+        bool consume(char c) {
+            if ((p_ == end_) || (*p_ != c)) {
+                return false;
+            }
+            ++p_;
+            return true;
+        }
+
+        void skipWhitespace() {
+            if ((p_ < end_) && Scanner::isWhitespace(*p_)) {
+                p_ = Scanner::skipWhitespace(p_ + 1, end_);
+            }
+        }
+
+        static bool equals(const char *value, std::size_t size, const char *text) {
+            return (std::char_traits<char>::length(text) == size) && (0 == std::char_traits<char>::compare(value, text, size));
+        }
+
+        const char *p_;
+        const char *const end_;
+    };
+};
+
+}   // namespace diff
@@ -0,0 +1,177 @@
+#pragma once
+
+/**
+ * @file TopologyValidator.h
+ * @author Slawomir Niespodziany (sniespod@gmail.com, slawomir.niespodziany@pw.edu.pl)
+ * @brief Defines TopologyValidator class used to type check a Topology without instantiating any component.
+ * @version 0.1
+ * @date 2025-04-01
+ * @copyright Copyright (c) 2025 Slawomir Niespodziany
+ */
+
+#include <diff/ComponentMetadata.h>
+#include <diff/DependencyId.h>
+#include <diff/Error.h>
+#include <diff/FactoryRegistry.h>
+#include <diff/Topology.h>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace diff {
+
+using namespace std::string_literals;
+
+/**
+ * @brief Dry run of a Build. Walks the topology in order of construction and checks every dependency edge against the metadata published by the
+ * factories (@see ComponentMetadata) - constructor parameter types on one side, types registered by the preceding components (as<...>, side<...>)
+ * on the other. No component is instantiated and no constructor is run.
+ *
+ * Config of each component declaring a config schema is checked against it as well (@see ConfigSchema).
+ *
+ * Side dependency ids are chosen by the component instances at runtime, so a dependency on a side dependency is accepted if its id is prefixed with
+ * the id of a preceding component exposing side dependencies of the required type. Collections selected by an identifier pattern may be empty, so
+ * they are not checked.
+ */
+class TopologyValidator final {
+public:
+    TopologyValidator() = delete;
+
+    /**
+     * @brief Type check the given topology. Report all the failures found, not just the first one.
+     *
+     * @param topology Topology object to be checked.
+     * @return Failures found, empty if the topology is valid. Each failure is located with the index of the topology entry and of its dependency
+     * (@see Error::at). Failures are the ones Build would raise: FactoryNotFound, DependencyCountMismatch, DependencyRegisterNotFound,
+     * DependencyNotFound, and config schema violations (@see ConfigSchema::check). Besides, DependencyTypeUnknown if the type of a constructor
+     * parameter is not known (@see ComponentMetadata::Parameter) - the dependency can not be verified, so it is not accepted either.
+     */
+    static std::vector<Error> validate(const Topology &topology) {
+        const FactoryRegistry &factoryRegistry = FactoryRegistry::getInstance();
+
+        std::vector<Error> errors;
+        Registry registry;
+
+        for (std::size_t i = 0u; i < topology.size(); ++i) {
+            const TopologyEntry &topologyEntry = topology[i];
+
+            if (!factoryRegistry.has(topologyEntry.type)) {
+                errors.emplace_back(Error{ErrorCode::FACTORY_NOT_FOUND, topologyEntry.type}.at(i));
+                registry.addUnknown(topologyEntry.id);
+                continue;
+            }
+
+            const ComponentMetadata &metadata = factoryRegistry.get(topologyEntry.type).metadata();
+            const DependencyIds &dependencyIds = topologyEntry.dependencyIds;
+
+            if (dependencyIds.size() < metadata.arity) {
+                errors.emplace_back(Error{ErrorCode::DEPENDENCY_COUNT_MISMATCH, topologyEntry.type, topologyEntry.id, std::to_string(metadata.arity),
+                                          std::to_string(dependencyIds.size())}
+                                        .at(i));
+            }
+
+            for (std::size_t d = 0u; d < std::min(metadata.arity, dependencyIds.size()); ++d) {
+                if (nullptr == metadata.parameters[d].pType) {
+                    errors.emplace_back(Error{ErrorCode::DEPENDENCY_TYPE_UNKNOWN, topologyEntry.type, topologyEntry.id, dependencyIds[d]}.at(i, d));
+                    continue;
+                }
+                const ErrorCode errorCode = registry.check(metadata.parameters[d], dependencyIds[d]);
+                if (ErrorCode::NONE != errorCode) {
+                    errors.emplace_back(Error{errorCode, registry.typeOf(metadata.parameters[d]), dependencyIds[d]}.at(i, d));
+                }
+            }
+
+            const std::size_t n = errors.size();
+            metadata.config.check(topologyEntry.type, topologyEntry.id, topologyEntry.config, errors);
+            for (auto it = errors.begin() + n; it != errors.end(); ++it) {
+                it->at(i);
+            }
+
+            registry.add(metadata, topologyEntry.id);
+        }
+
+        return errors;
+    }
+
+private:
+    /**
+     * @brief Dependencies registered so far - by type name only, nothing is instantiated.
+     */
+    class Registry final {
+    public:
+        void add(const ComponentMetadata &metadata, const std::string &id) {
+            for (const std::string *pType : metadata.provides) {
+                ids_[*pType].emplace(id);
+            }
+            for (const std::string *pType : metadata.sides) {
+                sidePrefixes_[*pType].emplace_back(id + "_"s);
+            }
+            for (const std::string *pType : metadata.indexedSides) {
+                indexedSidePrefixes_[*pType].emplace_back(id + "_"s);
+            }
+        }
+
+        void addUnknown(const std::string &id) { unknownPrefixes_.emplace_back(id); }
+
+        std::string typeOf(const ComponentMetadata::Parameter &parameter) const {
+            return (ComponentMetadata::Injection::SPAN == parameter.injection) ? ("diff::Span<"s + *parameter.pType + ">"s) : *parameter.pType;
+        }
+
+        ErrorCode check(const ComponentMetadata::Parameter &parameter, const DependencyId &id) const {
+            if (matches(unknownPrefixes_, id)) {   // not verifiable
+                return ErrorCode::NONE;
+            }
+
+            const std::string &type = *parameter.pType;
+            switch (parameter.injection) {
+                case ComponentMetadata::Injection::SPAN:
+                    if (matches(find(indexedSidePrefixes_, type), id)) {
+                        return ErrorCode::NONE;
+                    }
+                    return (indexedSidePrefixes_.count(type) == 0u) ? ErrorCode::DEPENDENCY_REGISTER_NOT_FOUND : ErrorCode::DEPENDENCY_NOT_FOUND;
+
+                case ComponentMetadata::Injection::DEPENDENCIES:
+                    if (DependencyIdPattern::isType(id) || DependencyIdPattern::isWildcard(id)) {
+                        return ErrorCode::NONE;
+                    }
+                    break;
+
+                case ComponentMetadata::Injection::REFERENCE:
+                    break;
+            }
+
+            const auto it = ids_.find(type);
+            if (((ids_.cend() != it) && (0u != it->second.count(id))) || matches(find(sidePrefixes_, type), id) ||
+                (isIndexed(id) && matches(find(indexedSidePrefixes_, type), id))) {
+                return ErrorCode::NONE;
+            }
+
+            const bool registered = (ids_.cend() != it) || (0u != sidePrefixes_.count(type)) || (0u != indexedSidePrefixes_.count(type));
+            return registered ? ErrorCode::DEPENDENCY_NOT_FOUND : ErrorCode::DEPENDENCY_REGISTER_NOT_FOUND;
+        }
+
+    private:
+        using Prefixes = std::vector<std::string>;
+
+        static const Prefixes &find(const std::map<std::string, Prefixes> &prefixes, const std::string &type) {
+            static const Prefixes empty;
+            const auto it = prefixes.find(type);
+            return (prefixes.cend() == it) ? empty : it->second;
+        }
+
+        static bool matches(const Prefixes &prefixes, const std::string &id) {
+            return std::any_of(prefixes.cbegin(), prefixes.cend(), [&id](const std::string &prefix) { return 0u == id.compare(0u, prefix.size(), prefix); });
+        }
+
+        static bool isIndexed(const std::string &id) { return (std::string::npos != id.rfind('[')) && (']' == id.back()); }
+
+        std::map<std::string /* type */, std::set<std::string> /* ids */> ids_;
+        std::map<std::string /* type */, Prefixes> sidePrefixes_;
+        std::map<std::string /* type */, Prefixes> indexedSidePrefixes_;
+        Prefixes unknownPrefixes_;
+    };
+};
+
+}   // namespace diff
@@ -0,0 +1,120 @@
+#include <diff/Build.h>
+#include <diff/FactoryRegisterer.h>
+#include <diff/SealedBuild.h>
+#include <diff/TopologyBuilder.h>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <type_traits>
+
+using namespace diff;
+
+namespace bench {
+
+class IStage {
+public:
+    virtual ~IStage() = default;
+    virtual std::uint32_t process(std::uint32_t sample) = 0;
+};
+
+class Sink final : public Component<Sink, as<IStage>> {
+public:
+    Sink() = default;
+
+    std::uint32_t process(std::uint32_t sample) override { return sample ^ 0x5a5a5a5au; }
+};
+
+/**
+ * @brief Processing stage forwarding to the next one. The dynamic build injects the next stage through its interface (Next = IStage). A sealed
+ * build rebinds it to the concrete type of the next stage instead (@see rebind), which allows the whole chain to be inlined.
+ */
+template <typename Next = IStage>
+class Stage final : public Component<Stage<Next>, as<IStage>> {
+public:
+    Stage(Next &next) : next_{next} {}
+
+    std::uint32_t process(std::uint32_t sample) override { return next_.process((sample * 3u) + 1u); }
+
+private:
+    Next &next_;
+};
+
+FactoryRegisterer<Sink> sinkFactoryRegisterer;
+FactoryRegisterer<Stage<>> stageFactoryRegisterer;
+
+}   // namespace bench
+
+using namespace bench;
+
+namespace {
+
+constexpr std::uint32_t ITERATIONS = 100000000u;
+
+template <typename... Ts>
+struct Chain;
+
+template <typename T>
+struct Chain<T> {
+    static void add(TopologyBuilder &topologyBuilder, std::size_t index) {
+        topologyBuilder.component(Demangler::of<T>(), "stage"s + std::to_string(index)).dependency("stage"s + std::to_string(index - 1u));
+    }
+};
+
+template <typename T, typename... Ts>
+struct Chain<T, Ts...> {
+    static void add(TopologyBuilder &topologyBuilder, std::size_t index) {
+        Chain<T>::add(topologyBuilder, index);
+        Chain<Ts...>::add(topologyBuilder, index + 1u);
+    }
+};
+
+template <typename... Ts>
+Topology chain() {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("bench::Sink"s, "stage0"s);
+    Chain<Ts...>::add(topologyBuilder, 1u);
+    return topology;
+}
+
+template <typename F>
+void measure(const char *name, F &&f) {
+    std::uint32_t result = 0u;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::uint32_t i = 0u; i < ITERATIONS; ++i) {
+        result += f(i);
+    }
+    const auto stop = std::chrono::steady_clock::now();
+
+    const double ns = std::chrono::duration<double, std::nano>(stop - start).count() / ITERATIONS;
+    std::cout << std::left << std::setw(32) << name << std::fixed << std::setprecision(3) << ns << " ns/call (" << result << ")" << std::endl;
+}
+
+}   // namespace
+
+int main() {
+    {
+        Topology topology = chain<Stage<>, Stage<>, Stage<>, Stage<>>();
+        Build build{topology};
+        IStage &stage = build.get<IStage>("stage4"s);
+        measure("dynamic", [&stage](std::uint32_t sample) { return stage.process(sample); });
+    }
+
+    {
+        Topology topology = chain<Stage<>, Stage<>, Stage<>, Stage<>>();
+        // As generated by SealedBuildGenerator for the topology.
+        using Sealed = SealedBuild<sealed<Sink>, sealed<Stage<>, 0u>, sealed<Stage<>, 1u>, sealed<Stage<>, 2u>, sealed<Stage<>, 3u>>;
+        static_assert(std::is_same<Sealed::Type<4u>, Stage<Stage<Stage<Stage<Sink>>>>>::value, "Sealed stages shall be rebound to concrete types.");
+
+        Sealed build{topology};
+        IStage &stage = build.get<4u>();
+        measure("sealed (through interface)", [&stage](std::uint32_t sample) { return stage.process(sample); });
+
+        Sealed::Type<4u> &concrete = build.get<4u>();
+        measure("sealed", [&concrete](std::uint32_t sample) { return concrete.process(sample); });
+    }
+
+    return 0;
+}
@@ -0,0 +1,214 @@
+#include <diff/TopologyLoader.h>
+#include <diff/TopologyParser.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+using namespace diff;
+
+namespace {
+
+std::size_t allocations = 0u;
+
+constexpr std::size_t ENTRIES = 1000u;
+constexpr std::size_t ITERATIONS = 200u;
+
+nlohmann::json topologyJson() {
+    nlohmann::json result = nlohmann::json::array();
+    for (std::size_t i = 0u; i < ENTRIES; ++i) {
+        nlohmann::json componentJson = {{"type", "bench::Stage"}, {"id", "stage" + std::to_string(i)}};
+        if (0u < i) {
+            componentJson["dependencies"] = {"stage" + std::to_string(i - 1u)};
+        }
+        componentJson["config"] = {{"gain", {{"uint16_t", i % 1000u}}}, {"name", "stage"}, {"enabled", true}};
+        result.push_back(std::move(componentJson));
+    }
+    return result;
+}
+
+// The same topology built directly, step by step as loaded - the allocations of loading, with no diagnostics involved.
+void build(const nlohmann::json &json, Topology &topology) {
+    TopologyBuilder topologyBuilder{topology};
+    topology.reserve(json.size());
+    for (const nlohmann::json &componentJson : json) {
+        TopologyBuilder::TopologyEntryBuilder topologyEntryBuilder =
+            topologyBuilder.component(componentJson["type"].get_ref<const std::string &>(), componentJson["id"].get_ref<const std::string &>());
+        const nlohmann::json::const_iterator it = componentJson.find("dependencies");
+        if (componentJson.cend() != it) {
+            for (const nlohmann::json &dependencyJson : *it) {
+                topologyEntryBuilder.dependency(dependencyJson.get_ref<const std::string &>());
+            }
+        }
+        for (const auto &kv : componentJson["config"].items()) {
+            const nlohmann::json &entryJson = kv.value();
+            if (entryJson.is_object()) {
+                topologyEntryBuilder.config(std::make_unique<ConfigEntry<uint16_t>>(kv.key(), entryJson["uint16_t"].get<uint16_t>()));
+            } else if (entryJson.is_boolean()) {
+                topologyEntryBuilder.config(std::make_unique<ConfigEntry<bool>>(kv.key(), entryJson.get<bool>()));
+            } else {
+                topologyEntryBuilder.config(std::make_unique<ConfigEntry<std::string>>(kv.key(), entryJson.get_ref<const std::string &>()));
+            }
+        }
+    }
+}
+
+constexpr std::size_t CARDS = 64u;
+constexpr std::size_t CARD_COMPONENTS = 12u;
+
+nlohmann::json cardComponentJson(std::size_t i, const std::string &card, const nlohmann::json &port) {
+    nlohmann::json componentJson = {{"type", "bench::Stage"}, {"id", card + "_stage" + std::to_string(i)}};
+    if (0u < i) {
+        componentJson["dependencies"] = {card + "_stage" + std::to_string(i - 1u)};
+    }
+    componentJson["config"] = {{"port", port}, {"name", "stage"}, {"enabled", true}};
+    return componentJson;
+}
+
+// The same topology of CARDS sub-graphs - spelled out, and instantiated from a template.
+std::string cardsJson(bool templated) {
+    nlohmann::json result = nlohmann::json::array();
+    if (templated) {
+        nlohmann::json templateJson = {{"template", "card"}, {"parameters", {"card", "port"}}, {"components", nlohmann::json::array()}};
+        for (std::size_t i = 0u; i < CARD_COMPONENTS; ++i) {
+            templateJson["components"].push_back(cardComponentJson(i, "${card}", "${port}"));
+        }
+        result.push_back(std::move(templateJson));
+    }
+    for (std::size_t card = 0u; card < CARDS; ++card) {
+        const nlohmann::json port = {{"uint16_t", card}};
+        if (templated) {
+            result.push_back({{"instantiate", "card"}, {"arguments", {{"card", "card" + std::to_string(card)}, {"port", port}}}});
+        } else {
+            for (std::size_t i = 0u; i < CARD_COMPONENTS; ++i) {
+                result.push_back(cardComponentJson(i, "card" + std::to_string(card), port));
+            }
+        }
+    }
+    return result.dump(4);
+}
+
+void benchmarkCards(bool templated) {
+    const std::string text = cardsJson(templated);
+
+    std::size_t total = 0u;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0u; i < ITERATIONS; ++i) {
+        TopologyLoader topologyLoader{nlohmann::json::parse(text)};
+        Topology topology;
+        topologyLoader.load(topology);
+        total += topology.size();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+
+    const double us = std::chrono::duration<double, std::micro>(stop - start).count() / ITERATIONS;
+    std::cout << std::fixed << std::setprecision(3) << (templated ? "cards, templated: " : "cards, flat: ") << text.size() << " bytes, " << us
+              << " us/parse+load (" << total << ")" << std::endl;
+}
+
+// A long value repeated by every component - spelled out, and defined once as a variable.
+std::string brokersJson(bool shared) {
+    const std::string broker = "tcp://broker.example.com:1883/telemetry/raw?qos=1&retain=false";
+    nlohmann::json result = nlohmann::json::array();
+    if (shared) {
+        result.push_back({{"variables", {{"broker", broker}}}});
+    }
+    for (std::size_t i = 0u; i < ENTRIES; ++i) {
+        const nlohmann::json address = shared ? nlohmann::json{{"variable", "broker"}} : nlohmann::json(broker);
+        result.push_back({{"type", "bench::Client"}, {"id", "client" + std::to_string(i)}, {"config", {{"address", address}}}});
+    }
+    return result.dump(4);
+}
+
+void benchmarkBrokers(bool shared) {
+    const std::string text = brokersJson(shared);
+    TopologyLoader topologyLoader{nlohmann::json::parse(text)};
+
+    Topology topology;
+    const std::size_t before = allocations;
+    topologyLoader.load(topology);
+    const std::size_t after = allocations;
+
+    const double perEntry = static_cast<double>(after - before) / ENTRIES;
+    std::cout << std::fixed << std::setprecision(3) << (shared ? "brokers, variable: " : "brokers, literal: ") << text.size() << " bytes, "
+              << perEntry << " allocations/entry (" << topology.size() << ")" << std::endl;
+}
+
+// The same text loaded through a Json value tree, and parsed straight into the topology.
+void benchmarkText(bool parser) {
+    const std::string text = topologyJson().dump(4);
+
+    std::size_t total = 0u;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0u; i < ITERATIONS; ++i) {
+        Topology topology;
+        if (parser) {
+            TopologyParser::load(text, topology);
+        } else {
+            TopologyLoader{nlohmann::json::parse(text)}.load(topology);
+        }
+        total += topology.size();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+
+    const double us = std::chrono::duration<double, std::micro>(stop - start).count() / ITERATIONS;
+    std::cout << std::fixed << std::setprecision(3) << (parser ? "text, parser: " : "text, json: ") << text.size() << " bytes, " << us
+              << " us/parse+load (" << total << ")" << std::endl;
+}
+
+}   // namespace
+
+// Allocation and deallocation functions replaced as a pair. Kept out of line - inlined into callers, malloc/free would be reported as mismatched
+// with new/delete (-Wmismatched-new-delete).
+__attribute__((noinline)) void *operator new(std::size_t size) {
+    ++allocations;
+    void *const pMemory = std::malloc(size);
+    if (nullptr == pMemory) {
+        throw std::bad_alloc{};
+    }
+    return pMemory;
+}
+
+__attribute__((noinline)) void operator delete(void *pMemory) noexcept { std::free(pMemory); }
+__attribute__((noinline)) void operator delete(void *pMemory, std::size_t) noexcept { std::free(pMemory); }
+
+int main() {
+    const nlohmann::json json = topologyJson();
+    TopologyLoader topologyLoader{json};
+
+    std::size_t total = 0u;
+    const std::size_t before = allocations;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0u; i < ITERATIONS; ++i) {
+        Topology topology;
+        topologyLoader.load(topology);
+        total += topology.size();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    const std::size_t after = allocations;
+
+    // Whatever the loader allocates beyond the baseline is its own overhead - diagnostics included.
+    const std::size_t baselineBefore = allocations;
+    for (std::size_t i = 0u; i < ITERATIONS; ++i) {
+        Topology topology;
+        build(json, topology);
+    }
+    const std::size_t baselineAfter = allocations;
+
+    const double ns = std::chrono::duration<double, std::nano>(stop - start).count() / (ITERATIONS * ENTRIES);
+    const double perEntry = static_cast<double>(after - before) / (ITERATIONS * ENTRIES);
+    const double baselinePerEntry = static_cast<double>(baselineAfter - baselineBefore) / (ITERATIONS * ENTRIES);
+    std::cout << std::fixed << std::setprecision(3) << "load: " << ns << " ns/entry, " << perEntry << " allocations/entry, " << baselinePerEntry
+              << " without diagnostics (" << total << ")" << std::endl;
+
+    benchmarkCards(false);
+    benchmarkCards(true);
+    benchmarkBrokers(false);
+    benchmarkBrokers(true);
+    benchmarkText(false);
+    benchmarkText(true);
+
+    return 0;
+}
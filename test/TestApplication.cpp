@@ -0,0 +1,22 @@
+#include <application/Components.h>
+#include <diff/Build.h>
+#include <diff/FactoryRegistry.h>
+#include <diff/TopologyLoader.h>
+#include <gtest/gtest.h>
+
+using namespace diff;
+
+TEST(TestApplication, FactoriesOfTopologyOnly) {
+    EXPECT_TRUE(FactoryRegistry::getInstance().has("application::Generator"s));
+    EXPECT_TRUE(FactoryRegistry::getInstance().has("application::Doubler"s));
+    EXPECT_FALSE(FactoryRegistry::getInstance().has("application::Unused"s));
+}
+
+TEST(TestApplication, Build) {
+    Topology topology;
+    TopologyLoader{std::string{DIFF_TEST_TOPOLOGY}}.load(topology);
+
+    Build build{topology};
+    EXPECT_EQ(build.get<application::IGenerator>("doubler0"s).generate(), 2);
+    EXPECT_EQ(build.get<application::IGenerator>("generator0"s).generate(), 2);
+}
@@ -0,0 +1,1341 @@
+#include <diff/Build.h>
+#include <diff/BuildPool.h>
+#include <diff/FactoryDescriptor.h>
+#include <diff/FactoryRegisterer.h>
+#include <diff/Footprint.h>
+#include <diff/Inspect.h>
+#include <diff/ModuleLoader.h>
+#include <diff/RealTime.h>
+#include <diff/SealedBuild.h>
+#include <diff/SealedBuildGenerator.h>
+#include <diff/TopologyCache.h>
+#include <diff/TopologyBuilder.h>
+#include <diff/TopologyValidator.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace diff;
+
+namespace test {
+
+class ICounter {
+public:
+    virtual ~ICounter() = default;
+    virtual int next() = 0;
+};
+
+class ISession {
+public:
+    virtual ~ISession() = default;
+    virtual int request() = 0;
+};
+
+class Counter : public Component<Counter, as<ICounter>> {
+public:
+    Counter() : value_{config<int64_t>("initial"s)} { ++constructed; }
+    ~Counter() { ++destructed; }
+
+    int next() override { return static_cast<int>(value_++); }
+
+    static int constructed;
+    static int destructed;
+
+private:
+    int64_t value_;
+};
+
+int Counter::constructed = 0;
+int Counter::destructed = 0;
+
+class alignas(128) AlignedCounter : public Component<AlignedCounter, as<ICounter>> {
+public:
+    int next() override { return static_cast<int>(value_++); }
+
+private:
+    int64_t value_ = 0;
+};
+
+class Session : public Component<Session, as<ISession>> {
+public:
+    Session(ICounter &counter) : counter_{counter} {}
+
+    int request() override { return counter_.next(); }
+
+private:
+    ICounter &counter_;
+};
+
+class ResettableSession : public Component<ResettableSession, as<ISession>, resettable> {
+public:
+    ResettableSession(ICounter &counter) : counter_{counter} { ++constructed; }
+    ~ResettableSession() { ++destructed; }
+
+    int request() override {
+        ++requests_;
+        return counter_.next();
+    }
+
+    int requests() const { return requests_; }
+
+    void reset() {
+        if (failing_) {
+            throw std::runtime_error{"Reset failed."s};
+        }
+        requests_ = 0;
+    }
+
+    void fail() { failing_ = true; }
+
+    static int constructed;
+    static int destructed;
+
+private:
+    ICounter &counter_;
+    int requests_ = 0;
+    bool failing_ = false;
+};
+
+int ResettableSession::constructed = 0;
+int ResettableSession::destructed = 0;
+
+class Tally final : public Component<Tally, as<ICounter>> {
+public:
+    Tally() = default;
+
+    int next() override { return value_++; }
+
+private:
+    int value_ = 0;
+};
+
+template <typename C = ICounter>
+class Relay final : public Component<Relay<C>, as<ISession>> {
+public:
+    Relay(C &counter) : counter_{counter} {}
+
+    int request() override { return counter_.next(); }
+
+private:
+    C &counter_;
+};
+
+class IQueue {
+public:
+    virtual ~IQueue() = default;
+    virtual std::size_t push() = 0;
+};
+
+class Shards : public Component<Shards, side<Span<IQueue>>> {
+public:
+    Shards() = default;
+
+protected:
+    void side(IndexedSideDependencies<IQueue> &indexedSideDependencies) { indexedSideDependencies.emplace("queues"s, queues_); }
+
+private:
+    struct Queue final : public IQueue {
+        std::size_t push() override { return ++size; }
+        std::size_t size = 0u;
+    };
+
+    Queue queues_[16];
+};
+
+class IConsumer {
+public:
+    virtual ~IConsumer() = default;
+    virtual Span<IQueue> queues() = 0;
+    virtual IQueue &queue() = 0;
+};
+
+class ShardsConsumer : public Component<ShardsConsumer, as<IConsumer>> {
+public:
+    ShardsConsumer(Span<IQueue> queues, IQueue &queue) : queues_{queues}, queue_{queue} {}
+
+    Span<IQueue> queues() override { return queues_; }
+    IQueue &queue() override { return queue_; }
+
+private:
+    Span<IQueue> queues_;
+    IQueue &queue_;
+};
+
+class IDispatcher {
+public:
+    virtual ~IDispatcher() = default;
+    virtual int dispatch() = 0;
+};
+
+class Dispatcher : public Component<Dispatcher, as<IDispatcher>> {
+public:
+    Dispatcher(const Dependencies<ICounter> &counters) : counters_{counters} {}
+
+    int dispatch() override {
+        int result = 0;
+        for (ICounter &counter : counters_) {
+            result += counter.next();
+        }
+        return result;
+    }
+
+private:
+    const Dependencies<ICounter> counters_;
+};
+
+class Gauge : public Component<Gauge, as<ICounter>> {
+public:
+    Gauge() = default;
+
+    int next() override { return value_ += 2; }
+
+private:
+    int value_ = 0;
+};
+
+class Probe : public Component<Probe> {
+public:
+    Probe() = default;
+};
+
+class Stepper : public Component<Stepper, as<ICounter>> {
+public:
+    Stepper() : value_{0}, step_{step(tryConfig<int64_t>("step"s))} {}
+
+    int next() override { return value_ += step_; }
+
+private:
+    static int step(const Result<const int64_t &> &result) { return result ? static_cast<int>(result.value()) : 1; }
+
+    int value_;
+    const int step_;
+};
+
+class Limiter : public Component<Limiter, as<ICounter>> {
+public:
+    Limiter() : limit_{config<int64_t>("limit"s)} {}
+
+    static void schema(ConfigSchema &schema) {
+        schema.entry<int64_t>("limit"s).range(1, 100);
+        schema.entry<std::string>("name"s).optional();
+    }
+
+    int next() override { return value_ = std::min(value_ + 1, static_cast<int>(limit_)); }
+
+private:
+    const int64_t limit_;
+    int value_ = 0;
+};
+
+class IPool {
+public:
+    virtual ~IPool() = default;
+    virtual bool ready() const = 0;
+};
+
+class Pool : public Component<Pool, as<IPool>, warmable> {
+public:
+    Pool() = default;
+
+    void warmup() {
+        if (config<bool>("faulty"s)) {
+            throw std::runtime_error{"Pool warm-up failed."};
+        }
+        ready_ = true;
+    }
+
+    bool ready() const override { return ready_; }
+
+private:
+    std::atomic<bool> ready_{false};
+};
+
+class Worker : public Component<Worker, as<IPool>, warmable> {
+public:
+    Worker(IPool &pool) : pool_{pool}, ready_{false} {}
+
+    void warmup() { ready_ = pool_.ready(); }
+
+    bool ready() const override { return ready_; }
+
+private:
+    IPool &pool_;
+    bool ready_;
+};
+
+class IMailbox {
+public:
+    virtual ~IMailbox() = default;
+    virtual void post(std::size_t size) = 0;
+};
+
+class Mailbox : public Component<Mailbox, as<IMailbox>> {
+public:
+    using Message = std::vector<char, ResourceAllocator<char>>;
+
+    Mailbox() : messages_{ResourceAllocator<Message>{memoryResource()}} {}
+
+    void post(std::size_t size) override { messages_.emplace_back(size, 'm', ResourceAllocator<char>{memoryResource()}); }
+
+private:
+    std::vector<Message, ResourceAllocator<Message>> messages_;
+};
+
+class Scaler : public Component<Scaler, as<ICounter>> {
+public:
+    Scaler() = default;
+
+    int next() override { return value_ += static_cast<int>(config<int64_t>(FACTOR)); }
+
+    const ConfigShape &shape() const noexcept { return configShape(); }
+    Result<const std::string &> name() const { return tryConfig<std::string>(NAME); }
+
+    static const ConfigKey FACTOR;
+    static const ConfigKey NAME;
+
+private:
+    int value_ = 0;
+};
+
+const ConfigKey Scaler::FACTOR{"factor"s};
+const ConfigKey Scaler::NAME{"name"s};
+
+FactoryRegisterer<Dispatcher> dispatcherFactoryRegisterer;
+FactoryRegisterer<Shards> shardsFactoryRegisterer;
+FactoryRegisterer<ShardsConsumer> shardsConsumerFactoryRegisterer;
+FactoryRegisterer<Counter> counterFactoryRegisterer;
+FactoryRegisterer<AlignedCounter> alignedCounterFactoryRegisterer;
+FactoryRegisterer<Session> sessionFactoryRegisterer;
+FactoryRegisterer<ResettableSession> resettableSessionFactoryRegisterer;
+FactoryRegisterer<Stepper> stepperFactoryRegisterer;
+FactoryRegisterer<Limiter> limiterFactoryRegisterer;
+FactoryRegisterer<Pool> poolFactoryRegisterer;
+FactoryRegisterer<Worker> workerFactoryRegisterer;
+FactoryRegisterer<Mailbox> mailboxFactoryRegisterer;
+FactoryRegisterer<Scaler> scalerFactoryRegisterer;
+
+}   // namespace test
+
+DIFF_REGISTER_FACTORY(test::Gauge);
+DIFF_REGISTER_FACTORY(test::Gauge);
+
+using namespace test;
+
+namespace {
+
+std::string writeFile(const std::string &path, const std::string &content) {
+    std::ofstream{path} << content;
+    return path;
+}
+
+std::string cacheDirectory(const std::string &name) {
+    const std::filesystem::path path = std::filesystem::path{testing::TempDir()} / name;
+    std::filesystem::remove_all(path);
+    std::filesystem::create_directories(path);
+    return path.string();
+}
+
+std::vector<std::filesystem::path> images(const std::string &directory) {
+    std::vector<std::filesystem::path> result;
+    for (const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator{directory}) {
+        result.emplace_back(entry.path());
+    }
+    return result;
+}
+
+}   // namespace
+
+using SealedSessionBuild = SealedBuild<sealed<Counter>, sealed<Session, 0u>>;
+
+TEST(TestBuild, Build) {
+    Topology topology;
+    TopologyBuilder{topology}.component("test::Counter"s, "counter0"s).config<int64_t>("initial"s, 10);
+
+    Build build{topology};
+    EXPECT_TRUE(build.has<ICounter>("counter0"s));
+    EXPECT_FALSE(build.has<ISession>("session0"s));
+    EXPECT_EQ(build.get<ICounter>("counter0"s).next(), 10);
+    EXPECT_THROW(build.get<ISession>("session0"s), DependencyRegisterNotFound);
+    EXPECT_THROW(build.get<ICounter>("counter1"s), DependencyNotFound);
+}
+
+TEST(TestBuild, FactoryDescriptor) {
+    EXPECT_TRUE(FactoryRegistry::getInstance().has("test::Gauge"s));
+    EXPECT_FALSE(FactoryRegistry::getInstance().has("test::Gauge2"s));
+    EXPECT_EQ(FactoryRegistry::getInstance().get("test::Gauge"s).type(), "test::Gauge"s);
+
+    const auto all = FactoryRegistry::getInstance().all();
+    EXPECT_EQ(std::count_if(all.cbegin(), all.cend(), [](const std::string &type) { return type == "test::Gauge"s; }), 1);
+
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Gauge"s, "gauge0"s);
+    topologyBuilder.component("test::Session"s, "session0"s).dependency("gauge0"s);
+
+    Build build{topology};
+    EXPECT_EQ(build.get<ISession>("session0"s).request(), 2);
+}
+
+TEST(TestBuild, FactoryDescriptorMismatch) {
+    const FactoryDescriptor valid{"test::Gauge", &Demangler::of<Gauge>, &FactoryDescriptor::factory<Gauge>};
+    EXPECT_TRUE(valid.check());
+
+    const FactoryDescriptor unqualified{"Gauge", &Demangler::of<Gauge>, &FactoryDescriptor::factory<Gauge>};
+    const Result<> result = unqualified.check();
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().code(), ErrorCode::FACTORY_TYPE_MISMATCH);
+    EXPECT_EQ(result.error().message(), "Factory of test::Gauge{} registered as \"Gauge\" - the type shall be spelled as reported by Demangler."s);
+    EXPECT_THROW(ErrorHandler::raise(result.error()), FactoryTypeMismatch);
+}
+
+TEST(TestBuild, FactoryRegistryRefreeze) {
+    EXPECT_FALSE(FactoryRegistry::getInstance().has("test::Probe"s));
+    {
+        const FactoryRegisterer<Probe> probeFactoryRegisterer;
+        EXPECT_TRUE(FactoryRegistry::getInstance().has("test::Probe"s));
+        EXPECT_EQ(&FactoryRegistry::getInstance().get(FactoryRegistry::hash("test::Probe"s), "test::Probe"s),
+                  &FactoryRegistry::getInstance().get("test::Probe"s));
+    }
+    EXPECT_FALSE(FactoryRegistry::getInstance().has("test::Probe"s));
+    EXPECT_THROW(FactoryRegistry::getInstance().get("test::Probe"s), FactoryNotFound);
+}
+
+TEST(TestBuild, SameTypeInstancesContiguous) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    for (int64_t i = 0; i < 4; ++i) {
+        topologyBuilder.component("test::Counter"s, "counter"s + std::to_string(i)).config<int64_t>("initial"s, i);
+    }
+    topologyBuilder.component("test::Session"s, "session0"s).dependency("counter3"s);
+
+    Build build{topology};
+
+    Counter *const pCounter0 = &static_cast<Counter &>(build.get<ICounter>("counter0"s));
+    for (int i = 0; i < 4; ++i) {
+        Counter &counter = static_cast<Counter &>(build.get<ICounter>("counter"s + std::to_string(i)));
+        EXPECT_EQ(&counter, pCounter0 + i);
+        EXPECT_EQ(counter.next(), i);
+    }
+    EXPECT_EQ(build.get<ISession>("session0"s).request(), 4);
+}
+
+TEST(TestBuild, SameTypeInstancesOverAligned) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    for (int i = 0; i < 3; ++i) {
+        topologyBuilder.component("test::AlignedCounter"s, "counter"s + std::to_string(i));
+    }
+
+    Build build{topology};
+
+    for (int i = 0; i < 3; ++i) {
+        ICounter &counter = build.get<ICounter>("counter"s + std::to_string(i));
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&static_cast<AlignedCounter &>(counter)) % alignof(AlignedCounter), 0u);
+        EXPECT_EQ(counter.next(), 0);
+    }
+}
+
+TEST(TestBuild, IndexedSideDependencies) {
+    Topology topology;
+    TopologyBuilder{topology}.component("test::Shards"s, "shards0"s);
+
+    Build build{topology};
+
+    EXPECT_EQ(build.all().size(), 1u);
+    EXPECT_EQ(build.get<Span<IQueue>>("shards0_queues"s).size(), 16u);
+    EXPECT_TRUE(build.has<IQueue>("shards0_queues[15]"s));
+    EXPECT_FALSE(build.has<IQueue>("shards0_queues[16]"s));
+    EXPECT_FALSE(build.has<IQueue>("shards0_queues[]"s));
+    EXPECT_FALSE(build.has<IQueue>("shards0_queues"s));
+    EXPECT_FALSE(build.has<IQueue>("shards0_queues[18446744073709551623]"s));   // Wraps around to 7 if not checked for overflow.
+    EXPECT_THROW(build.get<IQueue>("shards0_queues[16]"s), DependencyNotFound);
+
+    IQueue &queue = build.get<IQueue>("shards0_queues[7]"s);
+    EXPECT_EQ(queue.push(), 1u);
+    EXPECT_EQ(&build.get<Span<IQueue>>("shards0_queues"s)[7], &queue);
+}
+
+TEST(TestBuild, IndexedSideDependenciesInjection) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Shards"s, "shards0"s);
+    topologyBuilder.component("test::ShardsConsumer"s, "consumer0"s).dependency("shards0_queues"s).dependency("shards0_queues[3]"s);
+
+    Build build{topology};
+    IConsumer &consumer = build.get<IConsumer>("consumer0"s);
+
+    EXPECT_EQ(consumer.queues().size(), 16u);
+    EXPECT_EQ(&consumer.queue(), &consumer.queues()[3]);
+
+    std::size_t pushed = 0u;
+    for (IQueue &queue : consumer.queues()) {
+        pushed += queue.push();
+    }
+    EXPECT_EQ(pushed, 16u);
+}
+
+TEST(TestBuild, DependencySlots) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Counter"s, "counter0"s).config<int64_t>("initial"s, 0);
+    topologyBuilder.component("test::Counter"s, "counter1"s).config<int64_t>("initial"s, 10);
+    topologyBuilder.component("test::Session"s, "session0"s).dependency("counter1"s);
+    topologyBuilder.component("test::Session"s, "session1"s).dependency("counter0"s);
+
+    Build build{topology};
+
+    EXPECT_EQ(topology[2].dependencySlots, (DependencySlots{1u}));
+    EXPECT_EQ(topology[3].dependencySlots, (DependencySlots{0u}));
+    EXPECT_EQ(build.get<ISession>("session0"s).request(), 10);
+    EXPECT_EQ(build.get<ISession>("session1"s).request(), 0);
+}
+
+TEST(TestBuild, DependencySlotsNotFound) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Counter"s, "counter0"s).config<int64_t>("initial"s, 0);
+    topologyBuilder.component("test::Session"s, "session0"s).dependency("counter1"s);
+
+    EXPECT_THROW(
+        try { Build{topology}; } catch (const DependencyNotFound &e) {
+            EXPECT_STREQ(e.what(), "Dependency test::ICounter{} with id=\"counter1\" not found.");
+            throw;
+        },
+        DependencyNotFound);
+}
+
+TEST(TestBuild, BuildCreate) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Counter"s, "counter0"s).config<int64_t>("initial"s, 5);
+    topologyBuilder.component("test::Session"s, "session0"s).dependency("counter0"s);
+
+    Result<std::unique_ptr<Build>> result = Build::create(topology);
+    ASSERT_TRUE(result.ok());
+    EXPECT_EQ(result.value()->get<ISession>("session0"s).request(), 5);
+}
+
+TEST(TestBuild, BuildCreateFactoryNotFound) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Counter"s, "counter0"s).config<int64_t>("initial"s, 0);
+    topologyBuilder.component("Unknown"s, "unknown0"s);
+
+    const int constructed = Counter::constructed;
+    const Result<std::unique_ptr<Build>> result = Build::create(topology);
+
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(result.error().code(), ErrorCode::FACTORY_NOT_FOUND);
+    EXPECT_EQ(result.error().message(), "Factory of Unknown{} not registered."s);
+    EXPECT_EQ(Counter::constructed, constructed);
+    EXPECT_EQ(topology[0].id, "counter0"s);
+}
+
+TEST(TestBuild, BuildCreateDependencyNotFound) {
+    Topology topology;
+    TopologyBuilder{topology}.component("test::Session"s, "session0"s).dependency("counter0"s);
+
+    const Result<std::unique_ptr<Build>> result = Build::create(topology);
+
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(result.error().code(), ErrorCode::DEPENDENCY_REGISTER_NOT_FOUND);
+    EXPECT_EQ(result.error().argument(1u), "counter0"s);
+}
+
+TEST(TestBuild, DependencyCountMismatch) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Counter"s, "counter0"s).config<int64_t>("initial"s, 0);
+    topologyBuilder.component("test::Session"s, "session0"s);
+
+    EXPECT_THROW(
+        try { Build{topology}; } catch (const DependencyCountMismatch &e) {
+            EXPECT_STREQ(e.what(), "Component test::Session{\"session0\"} requires 1 dependencies, 0 given.");
+            throw;
+        },
+        DependencyCountMismatch);
+}
+
+TEST(TestBuild, TopologyValidator) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Counter"s, "counter0"s);
+    topologyBuilder.component("test::Session"s, "session0"s).dependency("counter0"s);
+    topologyBuilder.component("test::Shards"s, "shards0"s);
+    topologyBuilder.component("test::ShardsConsumer"s, "consumer0"s).dependency("shards0_queues"s).dependency("shards0_queues[3]"s);
+    topologyBuilder.component("test::Dispatcher"s, "dispatcher0"s).dependency("counter*"s);
+
+    const int constructed = Counter::constructed;
+
+    EXPECT_TRUE(TopologyValidator::validate(topology).empty());
+    EXPECT_EQ(Counter::constructed, constructed);
+}
+
+TEST(TestBuild, TopologyValidatorErrors) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Counter"s, "counter0"s).config<int64_t>("initial"s, 0);
+    topologyBuilder.component("Unknown"s, "unknown0"s);
+    topologyBuilder.component("test::Session"s, "session0"s).dependency("unknown0"s);
+    topologyBuilder.component("test::Dispatcher"s, "dispatcher0"s).dependency("counter*"s);
+    topologyBuilder.component("test::Session"s, "session1"s).dependency("dispatcher0"s);
+    topologyBuilder.component("test::Session"s, "session2"s);
+    topologyBuilder.component("test::ShardsConsumer"s, "consumer0"s).dependency("counter0"s).dependency("counter0"s);
+
+    const int constructed = Counter::constructed;
+    const std::vector<Error> errors = TopologyValidator::validate(topology);
+
+    EXPECT_EQ(Counter::constructed, constructed);
+    ASSERT_EQ(errors.size(), 5u);
+
+    EXPECT_EQ(errors[0].code(), ErrorCode::FACTORY_NOT_FOUND);
+    EXPECT_EQ(errors[0].entryIndex(), 1u);
+
+    EXPECT_EQ(errors[1].code(), ErrorCode::DEPENDENCY_NOT_FOUND);
+    EXPECT_EQ(errors[1].message(), "Dependency test::ICounter{} with id=\"dispatcher0\" not found."s);
+    EXPECT_EQ(errors[1].entryIndex(), 4u);
+    EXPECT_EQ(errors[1].itemIndex(), 0u);
+
+    EXPECT_EQ(errors[2].code(), ErrorCode::DEPENDENCY_COUNT_MISMATCH);
+    EXPECT_EQ(errors[2].message(), "Component test::Session{\"session2\"} requires 1 dependencies, 0 given."s);
+    EXPECT_EQ(errors[2].entryIndex(), 5u);
+
+    EXPECT_EQ(errors[3].code(), ErrorCode::DEPENDENCY_REGISTER_NOT_FOUND);
+    EXPECT_EQ(errors[3].argument(0u), "diff::Span<test::IQueue>"s);
+    EXPECT_EQ(errors[3].entryIndex(), 6u);
+    EXPECT_EQ(errors[3].itemIndex(), 0u);
+
+    EXPECT_EQ(errors[4].code(), ErrorCode::DEPENDENCY_REGISTER_NOT_FOUND);
+    EXPECT_EQ(errors[4].argument(0u), "test::IQueue"s);
+    EXPECT_EQ(errors[4].entryIndex(), 6u);
+    EXPECT_EQ(errors[4].itemIndex(), 1u);
+}
+
+TEST(TestBuild, ConfigSchema) {
+    Topology topology;
+    TopologyBuilder{topology}.component("test::Limiter"s, "limiter0"s).config<int8_t>("limit"s, 2);
+
+    Build build{topology};
+    ICounter &limiter = build.get<ICounter>("limiter0"s);
+
+    EXPECT_EQ(limiter.next(), 1);
+    EXPECT_EQ(limiter.next(), 2);
+    EXPECT_EQ(limiter.next(), 2);
+}
+
+TEST(TestBuild, ConfigSchemaRangeError) {
+    Topology topology;
+    TopologyBuilder{topology}.component("test::Limiter"s, "limiter0"s).config<uint64_t>("limit"s, 200u);
+
+    EXPECT_THROW(
+        try { Build{topology}; } catch (const ConfigEntryRangeError &e) {
+            EXPECT_STREQ(e.what(), "Config entry \"limit\" of component test::Limiter{\"limiter0\"} shall be in range [1, 100], 200 given.");
+            throw;
+        },
+        ConfigEntryRangeError);
+}
+
+TEST(TestBuild, TopologyValidatorConfig) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Limiter"s, "limiter0"s).config<std::string>("limit"s, "2"s).config<int64_t>("limt"s, 2);
+    topologyBuilder.component("test::Limiter"s, "limiter1"s).config<std::string>("name"s, "limiter"s);
+    topologyBuilder.component("test::Limiter"s, "limiter2"s).config<int64_t>("limit"s, 100);
+
+    const std::vector<Error> errors = TopologyValidator::validate(topology);
+
+    ASSERT_EQ(errors.size(), 3u);
+
+    EXPECT_EQ(errors[0].code(), ErrorCode::CONFIG_ENTRY_CAST_ERROR);
+    EXPECT_EQ(errors[0].argument(0u), "limit"s);
+    EXPECT_EQ(errors[0].argument(3u), Demangler::of<int64_t>());
+    EXPECT_EQ(errors[0].entryIndex(), 0u);
+
+    EXPECT_EQ(errors[1].code(), ErrorCode::CONFIG_ENTRY_UNEXPECTED);
+    EXPECT_EQ(errors[1].message(), "Config entry \"limt\" not expected by component test::Limiter{\"limiter0\"}."s);
+    EXPECT_EQ(errors[1].entryIndex(), 0u);
+
+    EXPECT_EQ(errors[2].code(), ErrorCode::CONFIG_ENTRY_NOT_FOUND);
+    EXPECT_EQ(errors[2].argument(2u), "limit"s);
+    EXPECT_EQ(errors[2].entryIndex(), 1u);
+}
+
+TEST(TestBuild, TryConfig) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Stepper"s, "stepper0"s);
+    topologyBuilder.component("test::Stepper"s, "stepper1"s).config<int64_t>("step"s, 3);
+    topologyBuilder.component("test::Stepper"s, "stepper2"s).config<std::string>("step"s, "3"s);
+
+    Build build{topology};
+
+    EXPECT_EQ(build.get<ICounter>("stepper0"s).next(), 1);
+    EXPECT_EQ(build.get<ICounter>("stepper1"s).next(), 3);
+    EXPECT_EQ(build.get<ICounter>("stepper2"s).next(), 1);
+}
+
+TEST(TestBuild, ExceptionError) {
+    Topology topology;
+    TopologyBuilder{topology}.component("test::Counter"s, "counter0"s);
+
+    EXPECT_THROW(
+        try { Build{topology}; } catch (const ConfigEntryNotFound &e) {
+            EXPECT_EQ(e.error().code(), ErrorCode::CONFIG_ENTRY_NOT_FOUND);
+            EXPECT_EQ(e.error().argument(2u), "initial"s);
+            EXPECT_EQ(e.error().message(), e.what());
+            EXPECT_STREQ(e.what(), "Config entry \"initial\" of component test::Counter{\"counter0\"} not found.");
+            throw;
+        },
+        ConfigEntryNotFound);
+}
+
+TEST(TestBuild, CollectionInjection) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    for (int64_t i = 0; i < 8; ++i) {
+        topologyBuilder.component("test::Counter"s, "counter"s + std::to_string(i)).config<int64_t>("initial"s, 1);
+    }
+    topologyBuilder.component("test::Counter"s, "other0"s).config<int64_t>("initial"s, 100);
+    topologyBuilder.component("test::Dispatcher"s, "dispatcher0"s).dependency("counter*"s);
+    topologyBuilder.component("test::Dispatcher"s, "dispatcher1"s).dependency("type:ICounter"s);
+    topologyBuilder.component("test::Dispatcher"s, "dispatcher2"s).dependency("*0"s);
+    topologyBuilder.component("test::Dispatcher"s, "dispatcher3"s).dependency("other0"s);
+    topologyBuilder.component("test::Dispatcher"s, "dispatcher4"s).dependency("type:IDispatcher"s);
+
+    Build build{topology};
+
+    EXPECT_EQ(build.get<IDispatcher>("dispatcher0"s).dispatch(), 8);
+    EXPECT_EQ(build.get<IDispatcher>("dispatcher1"s).dispatch(), 8 * 2 + 100);
+    EXPECT_EQ(build.get<IDispatcher>("dispatcher2"s).dispatch(), 3 + 101);
+    EXPECT_EQ(build.get<IDispatcher>("dispatcher3"s).dispatch(), 102);
+    EXPECT_EQ(build.get<IDispatcher>("dispatcher4"s).dispatch(), 0);
+
+    EXPECT_EQ(build.match<ICounter>("counter9*"s).size(), 0u);
+    EXPECT_EQ(build.match<ICounter>("*"s).size(), 9u);
+    EXPECT_EQ(build.match<ICounter>("c*t*r*7"s).size(), 1u);
+    EXPECT_THROW(build.match<ICounter>("counter8"s), DependencyNotFound);
+}
+
+TEST(TestBuild, Scope) {
+    Topology topology;
+    TopologyBuilder{topology}.component("test::Counter"s, "counter0"s).config<int64_t>("initial"s, 0);
+
+    Topology topologyScope;
+    TopologyBuilder{topologyScope}.component("test::Session"s, "session0"s).dependency("counter0"s);
+    const ScopeTopology scopeTopology{std::move(topologyScope)};
+
+    Build build{topology};
+    const int constructed = Counter::constructed;
+
+    {
+        Build scope0{build, scopeTopology};
+        Build scope1{build, scopeTopology};
+
+        EXPECT_EQ(scope0.get<ISession>("session0"s).request(), 0);
+        EXPECT_EQ(scope1.get<ISession>("session0"s).request(), 1);
+        EXPECT_TRUE(scope0.has<ICounter>("counter0"s));
+        EXPECT_EQ(scope0.all().size(), 2u);
+        EXPECT_EQ(scope0.get<ICounter>().size(), 1u);
+    }
+
+    EXPECT_EQ(Counter::constructed, constructed);
+    EXPECT_FALSE(build.has<ISession>("session0"s));
+}
+
+TEST(TestBuild, ScopeShadowsParent) {
+    Topology topology;
+    TopologyBuilder{topology}.component("test::Counter"s, "counter0"s).config<int64_t>("initial"s, 0);
+
+    Topology topologyScope;
+    TopologyBuilder topologyScopeBuilder{topologyScope};
+    topologyScopeBuilder.component("test::Counter"s, "counter0"s).config<int64_t>("initial"s, 100);
+    topologyScopeBuilder.component("test::Session"s, "session0"s).dependency("counter0"s);
+    const ScopeTopology scopeTopology{std::move(topologyScope)};
+
+    Build build{topology};
+    Build scope{build, scopeTopology};
+
+    EXPECT_EQ(scope.get<ISession>("session0"s).request(), 100);
+    EXPECT_EQ(build.get<ICounter>("counter0"s).next(), 0);
+    EXPECT_EQ(scope.get<ICounter>().size(), 2u);
+}
+
+TEST(TestBuild, ScopeFactoryNotFound) {
+    Topology topology;
+    TopologyBuilder{topology}.component("Unknown"s, "unknown0"s);
+
+    EXPECT_THROW(ScopeTopology{std::move(topology)}, FactoryNotFound);
+}
+
+TEST(TestBuild, BuildPool) {
+    Topology topology;
+    TopologyBuilder{topology}.component("test::Counter"s, "counter0"s).config<int64_t>("initial"s, 0);
+
+    Topology topologyScope;
+    TopologyBuilder{topologyScope}.component("test::ResettableSession"s, "session0"s).dependency("counter0"s);
+    const ScopeTopology scopeTopology{std::move(topologyScope)};
+
+    Build build{topology};
+    BuildPool buildPool{build, scopeTopology, 2u};
+    const int constructed = ResettableSession::constructed;
+
+    EXPECT_EQ(buildPool.capacity(), 2u);
+    EXPECT_EQ(buildPool.available(), 2u);
+
+    {
+        BuildPool::Handle pScope = buildPool.acquire();
+        ResettableSession &session = static_cast<ResettableSession &>(pScope->get<ISession>("session0"s));
+        session.request();
+        session.request();
+        EXPECT_EQ(session.requests(), 2);
+        EXPECT_EQ(buildPool.available(), 1u);
+    }
+    EXPECT_EQ(buildPool.available(), 2u);
+
+    {
+        BuildPool::Handle pScope0 = buildPool.acquire();
+        BuildPool::Handle pScope1 = buildPool.acquire();
+        EXPECT_EQ(static_cast<ResettableSession &>(pScope0->get<ISession>("session0"s)).requests(), 0);
+        EXPECT_EQ(static_cast<ResettableSession &>(pScope1->get<ISession>("session0"s)).requests(), 0);
+        EXPECT_EQ(buildPool.misses(), 0u);
+        EXPECT_EQ(ResettableSession::constructed, constructed);
+
+        BuildPool::Handle pScope2 = buildPool.acquire();
+        EXPECT_EQ(buildPool.misses(), 1u);
+        EXPECT_EQ(ResettableSession::constructed, constructed + 1);
+    }
+    EXPECT_EQ(buildPool.available(), 2u);
+
+    const int destructed = ResettableSession::destructed;
+    {
+        BuildPool::Handle pScope = buildPool.acquire();
+        static_cast<ResettableSession &>(pScope->get<ISession>("session0"s)).fail();
+    }
+    EXPECT_EQ(ResettableSession::destructed, destructed + 1);
+    EXPECT_EQ(buildPool.available(), 1u);
+}
+
+TEST(TestBuild, SealedBuild) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Counter"s, "counter0"s).config<int64_t>("initial"s, 7);
+    topologyBuilder.component("test::Session"s, "session0"s).dependency("counter0"s);
+
+    SealedSessionBuild build{topology};
+
+    Session &session = build.get<1u>();
+    EXPECT_EQ(session.request(), 7);
+    EXPECT_EQ(build.get<0u>().next(), 8);
+    EXPECT_EQ(&build.get<ISession>("session0"s), static_cast<ISession *>(&session));
+    EXPECT_EQ(build.all().size(), 2u);
+}
+
+TEST(TestBuild, SealedBuildRebind) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Tally"s, "tally0"s);
+    topologyBuilder.component(Demangler::of<Relay<>>(), "relay0"s).dependency("tally0"s);
+
+    using Sealed = SealedBuild<sealed<Tally>, sealed<Relay<>, 0u>>;
+    static_assert(std::is_same<Sealed::Type<1u>, Relay<Tally>>::value, "Relay shall be rebound to the final dependency type.");
+    static_assert(std::is_same<SealedBuild<sealed<Counter>, sealed<Relay<>, 0u>>::Type<1u>, Relay<>>::value, "Relay shall not be rebound.");
+    static_assert(std::is_same<rebind_t<Relay<>>, Relay<>>::value, "Relay shall not be rebound without dependencies.");
+
+    Sealed build{topology};
+    EXPECT_EQ(build.get<1u>().request(), 0);
+    EXPECT_EQ(build.get<ISession>("relay0"s).request(), 1);
+}
+
+TEST(TestBuild, SealedBuildMismatch) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Counter"s, "counter0"s).config<int64_t>("initial"s, 0);
+    topologyBuilder.component("test::ResettableSession"s, "session0"s).dependency("counter0"s);
+
+    const int destructed = Counter::destructed;
+    EXPECT_THROW(
+        try { SealedSessionBuild{topology}; } catch (const SealedTopologyMismatch &e) {
+            EXPECT_STREQ(e.what(), "Topology entry test::ResettableSession{\"session0\"} does not match the sealed build.");
+            throw;
+        },
+        SealedTopologyMismatch);
+    EXPECT_EQ(Counter::destructed, destructed + 1);
+
+    Topology topologyShort;
+    TopologyBuilder{topologyShort}.component("test::Counter"s, "counter0"s).config<int64_t>("initial"s, 0);
+    EXPECT_THROW(SealedSessionBuild{topologyShort}, SealedTopologyMismatch);
+}
+
+TEST(TestBuild, SealedBuildGenerator) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Counter"s, "counter0"s);
+    topologyBuilder.component("test::Session"s, "session0"s).dependency("counter0"s);
+
+    std::ostringstream oss;
+    SealedBuildGenerator::generate(oss, topology, "Sealed"s, {"test/Components.h"s});
+    EXPECT_EQ(oss.str(),
+              "#pragma once\n\n"
+              "// Generated by diff::SealedBuildGenerator - do not edit.\n\n"
+              "#include <diff/SealedBuild.h>\n"
+              "#include <test/Components.h>\n"
+              "\nusing Sealed = diff::SealedBuild<\n"
+              "    diff::sealed<test::Counter>,\n"
+              "    diff::sealed<test::Session, 0u>>;\n"s);
+
+    Topology topologySide;
+    TopologyBuilder topologySideBuilder{topologySide};
+    topologySideBuilder.component("test::Shards"s, "shards0"s);
+    topologySideBuilder.component("test::ShardsConsumer"s, "consumer0"s).dependency("shards0_queues"s).dependency("shards0_queues[3]"s);
+    EXPECT_THROW(
+        try { SealedBuildGenerator::generate(oss, topologySide, "Sealed"s); } catch (const SealedDependencyUnresolved &e) {
+            EXPECT_STREQ(e.what(), "Dependency \"shards0_queues\" of component test::ShardsConsumer{\"consumer0\"} can not be sealed.");
+            throw;
+        },
+        SealedDependencyUnresolved);
+}
+
+TEST(TestBuild, ModuleLoader) {
+    ModuleManifest moduleManifest{nlohmann::json{{DIFF_TEST_MODULE, {"test::ModuleProbe", "test::ModuleGauge"}}}};
+    ModuleLoader moduleLoader{std::move(moduleManifest)};
+
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Counter"s, "counter0"s).config<int64_t>("initial"s, 0);
+    topologyBuilder.component("test::ModuleProbe"s, "probe0"s);
+    topologyBuilder.component("test::ModuleGauge"s, "gauge0"s);
+
+    Topology topologyStatic;
+    TopologyBuilder{topologyStatic}.component("test::Counter"s, "counter0"s).config<int64_t>("initial"s, 0);
+    EXPECT_TRUE(moduleLoader.load(topologyStatic).empty());
+
+    EXPECT_FALSE(FactoryRegistry::getInstance().has("test::ModuleProbe"s));
+    {
+        Modules modules = moduleLoader.load(topology);
+        ASSERT_EQ(modules.size(), 1u);
+        EXPECT_EQ(modules[0]->path(), DIFF_TEST_MODULE);
+        EXPECT_EQ(moduleLoader.load(topology)[0], modules[0]);
+
+        Build build{topology, std::move(modules)};
+        EXPECT_TRUE(FactoryRegistry::getInstance().has("test::ModuleProbe"s));
+        EXPECT_TRUE(FactoryRegistry::getInstance().has("test::ModuleGauge"s));   // Described in the section of the module.
+    }
+    EXPECT_FALSE(FactoryRegistry::getInstance().has("test::ModuleProbe"s));
+    EXPECT_FALSE(FactoryRegistry::getInstance().has("test::ModuleGauge"s));
+}
+
+TEST(TestBuild, ModuleLoadError) {
+    ModuleManifest moduleManifest;
+    moduleManifest.add("test::Missing"s, "libmissing.so"s);
+    ModuleLoader moduleLoader{std::move(moduleManifest)};
+
+    Topology topology;
+    TopologyBuilder{topology}.component("test::Missing"s, "missing0"s);
+    EXPECT_THROW(moduleLoader.load(topology), ModuleLoadError);
+}
+
+TEST(TestBuild, ModuleManifest) {
+    EXPECT_THROW(
+        try { ModuleManifest{nlohmann::json::array()}; } catch (const ModuleManifestException &e) {
+            EXPECT_STREQ(e.what(), "Module manifest json shall be an object.");
+            throw;
+        },
+        ModuleManifestException);
+    EXPECT_THROW(
+        try { ModuleManifest{nlohmann::json::parse(R"({"liba.so" : ["app::A"], "libb.so" : ["app::A"]})")}; } catch (const ModuleManifestException &e) {
+            EXPECT_STREQ(e.what(), "Component type app::A{} provided by modules \"liba.so\" and \"libb.so\".");
+            throw;
+        },
+        ModuleManifestException);
+}
+
+TEST(TestBuild, TopologyCache) {
+    const std::string directory = cacheDirectory("TestBuild_cache"s);
+    writeFile(directory + "/../TestBuild_board.json"s, R"(
+    [
+        { "variables" : { "limit" : { "int64_t" : 5 } } },
+        { "type" : "test::Counter", "id" : "counter0", "config" : { "initial" : { "int64_t" : 10 } } },
+        { "type" : "test::Limiter", "id" : "limiter0", "config" : { "limit" : { "variable" : "limit" }, "name" : "main" } }
+    ]
+    )"s);
+    const std::string path = writeFile(directory + "/../TestBuild_system.json"s, R"(
+    [
+        { "include" : "TestBuild_board.json" },
+        { "type" : "test::Session", "id" : "session0", "dependencies" : [ "counter0" ] }
+    ]
+    )"s);
+    const TopologyCache topologyCache{directory};
+
+    Topology loaded;
+    EXPECT_FALSE(topologyCache.load(path, loaded));
+    EXPECT_EQ(images(directory).size(), 1u);
+
+    Topology cached;
+    EXPECT_TRUE(topologyCache.load(path, cached));
+    ASSERT_EQ(cached.size(), loaded.size());
+    for (std::size_t i = 0u; i < cached.size(); ++i) {
+        EXPECT_EQ(cached[i].type, loaded[i].type);
+        EXPECT_EQ(cached[i].id, loaded[i].id);
+        EXPECT_EQ(cached[i].dependencyIds, loaded[i].dependencyIds);
+        ASSERT_EQ(cached[i].config.size(), loaded[i].config.size());
+        for (auto it = cached[i].config.cbegin(), jt = loaded[i].config.cbegin(); it != cached[i].config.cend(); ++it, ++jt) {
+            EXPECT_EQ((*it)->key(), (*jt)->key());
+            EXPECT_EQ((*it)->type(), (*jt)->type());
+            EXPECT_EQ((*it)->toString(), (*jt)->toString());
+        }
+    }
+    EXPECT_NE(dynamic_cast<const SharedConfigEntry *>(cached[1].config.find("limit"s)->get()), nullptr);
+
+    Build build{cached};
+    EXPECT_EQ(build.get<ISession>("session0"s).request(), 10);
+    EXPECT_EQ(build.get<ICounter>("limiter0"s).next(), 1);
+}
+
+TEST(TestBuild, TopologyCacheMiss) {
+    const std::string directory = cacheDirectory("TestBuild_cacheMiss"s);
+    const std::string include = writeFile(directory + "/../TestBuild_counter.json"s, R"( [ { "type" : "test::Stepper", "id" : "stepper0" } ] )"s);
+    const std::string path = writeFile(directory + "/../TestBuild_root.json"s, R"( [ { "include" : "TestBuild_counter.json" } ] )"s);
+    const TopologyCache topologyCache{directory};
+    Topology topology;
+
+    EXPECT_FALSE(topologyCache.load(path, topology));
+    EXPECT_TRUE(topologyCache.load(path, topology));
+
+    // Included file changed - recorded digest does not match.
+    writeFile(include, R"( [ { "type" : "test::Stepper", "id" : "stepper1" } ] )"s);
+    EXPECT_FALSE(topologyCache.load(path, topology));
+    ASSERT_EQ(topology.size(), 1u);
+    EXPECT_EQ(topology[0].id, "stepper1"s);
+    EXPECT_TRUE(topologyCache.load(path, topology));
+
+    // Image corrupted - checksum does not match, the image is rewritten.
+    const std::vector<std::filesystem::path> paths = images(directory);
+    ASSERT_EQ(paths.size(), 1u);
+    {
+        std::fstream file{paths[0], std::ios::in | std::ios::out | std::ios::binary};
+        file.seekp(20);
+        file.put('\xff');
+    }
+    EXPECT_FALSE(topologyCache.load(path, topology));
+    EXPECT_TRUE(topologyCache.load(path, topology));
+    EXPECT_EQ(topology[0].id, "stepper1"s);
+
+    // Factories changed - fingerprint does not match.
+    const Sha256::Digest fingerprint = TopologyCache::fingerprint();
+    {
+        const FactoryRegisterer<Probe> probeFactoryRegisterer;
+        EXPECT_NE(TopologyCache::fingerprint(), fingerprint);
+        EXPECT_FALSE(topologyCache.load(path, topology));
+    }
+    EXPECT_EQ(TopologyCache::fingerprint(), fingerprint);
+    EXPECT_TRUE(topologyCache.load(path, topology));
+}
+
+TEST(TestBuild, TopologyCacheInvalid) {
+    const std::string directory = cacheDirectory("TestBuild_cacheInvalid"s);
+    const std::string path = writeFile(directory + "/../TestBuild_invalid.json"s, R"( [ { "type" : "test::Limiter", "id" : "limiter0" } ] )"s);
+    const TopologyCache topologyCache{directory};
+    Topology topology;
+
+    const Result<bool> result = topologyCache.tryLoad({path}, topology);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().code(), ErrorCode::CONFIG_ENTRY_NOT_FOUND);
+    EXPECT_TRUE(images(directory).empty());
+    EXPECT_THROW(topologyCache.load(path, topology), ConfigEntryNotFound);
+}
+
+TEST(TestBuild, Warmup) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Pool"s, "pool0"s).config<bool>("faulty"s, false);
+    topologyBuilder.component("test::Pool"s, "pool1"s).config<bool>("faulty"s, false);
+    topologyBuilder.component("test::Counter"s, "counter0"s).config<int64_t>("initial"s, 0);
+    topologyBuilder.component("test::Worker"s, "worker0"s).dependency("pool0"s);
+    topologyBuilder.component("test::Worker"s, "worker1"s).dependency("worker0"s);
+    topologyBuilder.component("test::Worker"s, "worker2"s).dependency("pool1"s);
+
+    Build build{topology};
+    EXPECT_FALSE(build.get<IPool>("worker1"s).ready());
+
+    const std::vector<WarmupTiming> timings = build.warmup(2u);
+    ASSERT_EQ(timings.size(), 5u);
+    EXPECT_EQ(timings[0].id.get(), "pool0"s);
+    EXPECT_EQ(timings[2].type.get(), "test::Worker"s);
+    EXPECT_EQ(timings[4].id.get(), "worker2"s);
+    for (const std::string &id : {"worker0"s, "worker1"s, "worker2"s}) {
+        EXPECT_TRUE(build.get<IPool>(id).ready()) << id;
+    }
+}
+
+TEST(TestBuild, WarmupSharedId) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Counter"s, "shared0"s).config<int64_t>("initial"s, 0);
+    topologyBuilder.component("test::Pool"s, "pool0"s).config<bool>("faulty"s, false);
+    topologyBuilder.component("test::Worker"s, "worker0"s).dependency("shared0"s);
+    topologyBuilder.component("test::Worker"s, "worker1"s).dependency("worker0"s);
+    topology[1].id = "shared0"s;   // Registered as IPool, besides ICounter of the counter - rejected by the builder.
+
+    const DependencyIdTable dependencyIdTable{topology};
+    EXPECT_EQ(dependencyIdTable.entry(dependencyIdTable.find("shared0"s)), 0u);
+    EXPECT_EQ(dependencyIdTable.entry(dependencyIdTable.find("worker0"s)), 2u);   // Slot 1, shifted by the shared id.
+    EXPECT_EQ(dependencyIdTable.entry(dependencyIdTable.find("worker1"s)), 3u);
+    EXPECT_EQ(dependencyIdTable.entry(DependencyIdTable::NONE), DependencyIdTable::NO_ENTRY);
+
+    Build build{topology};
+    build.warmup(2u);
+    for (const std::string &id : {"shared0"s, "worker0"s, "worker1"s}) {
+        EXPECT_TRUE(build.get<IPool>(id).ready()) << id;
+    }
+}
+
+TEST(TestBuild, WarmupException) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Pool"s, "pool0"s).config<bool>("faulty"s, false);
+    topologyBuilder.component("test::Pool"s, "pool1"s).config<bool>("faulty"s, true);
+    topologyBuilder.component("test::Worker"s, "worker0"s).dependency("pool0"s);
+
+    Build build{topology};
+    EXPECT_THROW(build.warmup(), std::runtime_error);
+    EXPECT_TRUE(build.get<IPool>("pool0"s).ready());
+    EXPECT_FALSE(build.get<IPool>("worker0"s).ready());
+}
+
+TEST(TestBuild, RealTime) {
+    const Result<> result = RealTime::lockMemory();
+    if (result) {
+        RealTime::unlockMemory();
+    } else {
+        EXPECT_EQ(result.error().code(), ErrorCode::MEMORY_LOCK_ERROR);
+        EXPECT_THROW(ErrorHandler::raise(result.error()), MemoryLockError);
+    }
+    RealTime::prefaultStack(256u * 1024u);
+}
+
+TEST(TestBuild, MemoryResource) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Mailbox"s, "mailbox0"s).config<std::string>("memory.resource"s, "monotonic"s);
+    topologyBuilder.component("test::Mailbox"s, "mailbox1"s).config<std::string>("memory.resource"s, "pool"s).config<uint64_t>("memory.size"s, 8192u);
+    topologyBuilder.component("test::Mailbox"s, "mailbox2"s).config<std::string>("memory.resource"s, "bounded"s).config<uint64_t>("memory.limit"s, 256u);
+    topologyBuilder.component("test::Mailbox"s, "mailbox3"s);
+    topologyBuilder.component("test::Limiter"s, "limiter0"s).config<int64_t>("limit"s, 5).config<std::string>("memory.resource"s, "pool"s);
+    EXPECT_TRUE(TopologyValidator::validate(topology).empty());
+
+    Build build{topology};
+    for (const std::string &id : {"mailbox0"s, "mailbox1"s}) {
+        for (std::size_t i = 0u; i < 100u; ++i) {
+            build.get<IMailbox>(id).post(100u);
+        }
+    }
+    build.get<IMailbox>("mailbox2"s).post(16u);
+
+    const std::vector<MemoryUsage> memory = build.memory();
+    ASSERT_EQ(memory.size(), 4u);
+    EXPECT_EQ(memory[0].id.get(), "mailbox0"s);
+    EXPECT_EQ(memory[3].id.get(), "limiter0"s);
+    EXPECT_LE(100u * 100u, memory[0].used);
+    EXPECT_LE(100u * 128u, memory[1].used);
+    EXPECT_LE(memory[2].used, 256u);
+    EXPECT_EQ(memory[2].limit, 256u);
+    EXPECT_EQ(memory[3].used, 0u);
+
+    // Bounded - limit violated.
+    EXPECT_THROW(
+        try { build.get<IMailbox>("mailbox2"s).post(1000u); } catch (const MemoryLimitExceeded &e) {
+            EXPECT_EQ(std::string{e.what()}.find("Memory limit of component test::Mailbox{\"mailbox2\"} exceeded - "s), 0u);
+            throw;
+        },
+        MemoryLimitExceeded);
+    EXPECT_EQ(build.memory()[2].violations, 1u);
+    EXPECT_LE(build.memory()[2].used, build.memory()[2].peak);
+}
+
+TEST(TestBuild, MemoryResourceInvalid) {
+    Topology topology;
+    TopologyBuilder{topology}.component("test::Mailbox"s, "mailbox0"s).config<std::string>("memory.resource"s, "arena"s);
+
+    EXPECT_THROW(
+        try { Build{topology}; } catch (const MemoryResourceInvalid &e) {
+            EXPECT_STREQ(e.what(), "Memory resource config entry \"memory.resource\" of component test::Mailbox{\"mailbox0\"} invalid - arena given.");
+            throw;
+        },
+        MemoryResourceInvalid);
+
+    topology.clear();
+    TopologyBuilder{topology}.component("test::Mailbox"s, "mailbox0"s).config<uint64_t>("memory.limit"s, 1024u);
+    EXPECT_THROW(Build{topology}, MemoryResourceInvalid);
+}
+
+TEST(TestBuild, MemoryResourcePool) {
+    const std::string id = "pool0"s;
+    PoolResource poolResource{id, id, 4096u, 2048u};
+
+    void *const pFirst = poolResource.allocate(24u);
+    poolResource.deallocate(pFirst, 24u);
+    EXPECT_EQ(poolResource.allocate(32u), pFirst);   // Reused - same size class.
+    EXPECT_EQ(poolResource.used(), 2048u);
+
+    void *const pLarge = poolResource.allocate(2000u, 64u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(pLarge) % 64u, 0u);
+    EXPECT_EQ(poolResource.used(), 4048u);
+    poolResource.deallocate(pLarge, 2000u, 64u);
+    EXPECT_EQ(poolResource.used(), 2048u);
+
+#if defined(DIFF_PMR)
+    std::pmr::vector<int> values{&poolResource};
+    values.assign(100u, 1);
+    EXPECT_EQ(poolResource.used(), 4096u);
+#endif
+}
+
+TEST(TestBuild, Footprint) {
+    const std::string name(64u, 'n');
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Counter"s, "counter0"s).config<int64_t>("initial"s, 1);
+    topologyBuilder.component("test::Counter"s, "counter1"s).config<int64_t>("initial"s, 2);
+    topologyBuilder.component("test::Limiter"s, "limiter0"s).config<int64_t>("limit"s, 5).config<std::string>("name"s, name);
+    topologyBuilder.component("test::Session"s, "session0"s).dependency("counter0"s);
+
+    const Result<Footprint> result = Footprint::estimate(topology);
+    ASSERT_TRUE(result);
+    const Footprint &footprint = result.value();
+
+    EXPECT_EQ(FactoryRegistry::getInstance().get("test::Counter"s).metadata().size, sizeof(Counter));
+    EXPECT_EQ(FactoryRegistry::getInstance().get("test::Counter"s).metadata().alignment, alignof(Counter));
+    EXPECT_EQ(footprint.types().size(), 3u);
+    EXPECT_EQ(footprint.types().at("test::Counter"s).instances, 2u);
+    EXPECT_EQ(footprint.types().at("test::Session"s).size, sizeof(Session));
+    EXPECT_EQ(footprint.components(), 2u * sizeof(Counter) + sizeof(Limiter) + sizeof(Session));
+
+    ASSERT_EQ(footprint.entries().size(), 4u);
+    EXPECT_EQ(footprint.entries()[0].strings, 0u);
+    EXPECT_LT(0u, footprint.entries()[0].config);
+    EXPECT_LT(0u, footprint.entries()[0].registry);
+    EXPECT_EQ(footprint.entries()[2].strings, name.size() + 1u);
+    EXPECT_EQ(footprint.entries()[2].stringDominated(), sizeof(Limiter) < name.size() + 1u);
+    EXPECT_EQ(footprint.total(), footprint.components() + footprint.overhead() + footprint.strings());
+
+    std::ostringstream report;
+    footprint.print(report);
+    EXPECT_NE(report.str().find("test::Limiter{\"limiter0\"}"s), std::string::npos);
+    EXPECT_NE(report.str().find("total      "s + std::to_string(footprint.total()) + " B"s), std::string::npos);
+
+    topologyBuilder.component("test::Unregistered"s, "unregistered0"s);
+    EXPECT_EQ(Footprint::estimate(topology).error().code(), ErrorCode::FACTORY_NOT_FOUND);
+}
+
+TEST(TestBuild, Inspect) {
+    const std::string path = writeFile(testing::TempDir() + "/TestBuild_inspect.json"s, R"(
+    [
+        { "type" : "test::Counter", "id" : "counter0", "config" : { "initial" : { "int64_t" : 10 } } },
+        { "type" : "test::Session", "id" : "session0", "dependencies" : [ "counter0" ] }
+    ]
+    )"s);
+
+    std::ostringstream os, es;
+    const char *const within[] = {"diff-inspect", path.c_str(), "--budget", "1000000"};
+    EXPECT_EQ(Inspect::main(4, within, os, es), 0);
+    EXPECT_NE(os.str().find("Totals:"s), std::string::npos);
+    EXPECT_TRUE(es.str().empty());
+
+    const char *const exceeded[] = {"diff-inspect", path.c_str(), "--budget", "1"};
+    EXPECT_EQ(Inspect::main(4, exceeded, os, es), 1);
+    EXPECT_NE(es.str().find("exceeds the budget of 1 B"s), std::string::npos);
+
+    const char *const invalid[] = {"diff-inspect", path.c_str(), "--budget", "many"};
+    EXPECT_EQ(Inspect::main(4, invalid, os, es), 2);
+    const char *const missing[] = {"diff-inspect", "TestBuild_missing.json"};
+    EXPECT_EQ(Inspect::main(2, missing, os, es), 2);
+    const char *const none[] = {"diff-inspect"};
+    EXPECT_EQ(Inspect::main(1, none, os, es), 2);
+}
+
+TEST(TestBuild, ConfigShape) {
+    Config first, second, third;
+    first.emplace(std::make_unique<ConfigEntry<int64_t>>("b"s, 1));
+    first.emplace(std::make_unique<ConfigEntry<std::string>>("a"s, "x"s));
+    second.emplace(std::make_unique<ConfigEntry<std::string>>("a"s, "y"s));
+    second.emplace(std::make_unique<ConfigEntry<int64_t>>("b"s, 2));
+    third.emplace(std::make_unique<ConfigEntry<int64_t>>("b"s, 3));
+
+    const ConfigLayout firstLayout{std::move(first)};
+    const ConfigLayout secondLayout{std::move(second)};
+    const ConfigLayout thirdLayout{std::move(third)};
+    EXPECT_TRUE(first.empty());
+    EXPECT_EQ(&firstLayout.shape(), &secondLayout.shape());
+    EXPECT_NE(&firstLayout.shape(), &thirdLayout.shape());
+    EXPECT_EQ(firstLayout.shape().keys(), (std::vector<std::string>{"a"s, "b"s}));
+
+    EXPECT_EQ(firstLayout.shape().slot("b"s), 1u);
+    EXPECT_EQ(thirdLayout.shape().slot("b"s), 0u);
+    EXPECT_EQ(firstLayout.shape().slot("c"s), ConfigShape::NPOS);
+    EXPECT_EQ(secondLayout.find("a"s)->value<std::string>("a"s), "y"s);
+    EXPECT_EQ(secondLayout.at(1u)->value<int64_t>("b"s), 2);
+    EXPECT_EQ(secondLayout.find("c"s), nullptr);
+
+    const ConfigKey key{"b"s};
+    for (int i = 0; i < 2; ++i) {   // Resolved, then cached - for alternating shapes.
+        EXPECT_EQ(firstLayout.find(key)->value<int64_t>(key.key()), 1);
+        EXPECT_EQ(thirdLayout.find(key)->value<int64_t>(key.key()), 3);
+        EXPECT_EQ(secondLayout.find(key)->value<int64_t>(key.key()), 2);
+    }
+    const ConfigKey missing{"c"s};
+    EXPECT_EQ(firstLayout.find(missing), nullptr);
+    EXPECT_EQ(firstLayout.find(missing), nullptr);
+}
+
+TEST(TestBuild, ConfigLayoutMove) {
+    const std::shared_ptr<const ConfigEntry<>> pShared = std::make_shared<ConfigEntry<int64_t>>("limit"s, 7);
+    const std::string text(64u, 'x');
+    Config config;
+    config.emplace(std::make_unique<SharedConfigEntry>("limit"s, pShared));
+    config.emplace(std::make_unique<ConfigEntry<std::string>>("text"s, text));
+
+    const ConfigEntry<> &textEntry = **config.find("text"s);
+    const char *const pText = textEntry.value<std::string>().data();
+    const ConfigLayout layout{std::move(config)};
+    EXPECT_TRUE(config.empty());
+    EXPECT_EQ(pShared.use_count(), 2);   // Moved along with the value, not copied.
+    EXPECT_EQ(layout.size(), 2u);
+    EXPECT_EQ(layout.key(1u), "text"s);
+    EXPECT_EQ(layout.at(0u)->value<int64_t>("limit"s), 7);
+    EXPECT_EQ(layout.find("text"s)->value<std::string>("text"s), text);
+    EXPECT_EQ(layout.find("text"s)->value<std::string>("text"s).data(), pText);   // Heap buffer taken over, not copied.
+
+    const Result<const int32_t &> result = layout.find("text"s)->tryValue<int32_t>("text"s);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().code(), ErrorCode::CONFIG_ENTRY_CAST_ERROR);
+    EXPECT_EQ(result.error().message(), (ConfigEntryCastError{"text"s, text, Demangler::of<std::string>(), Demangler::of<int32_t>()}.error().message()));
+}
+
+TEST(TestBuild, ConfigShapeShared) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Scaler"s, "scaler0"s).config<int64_t>("factor"s, 2);
+    topologyBuilder.component("test::Scaler"s, "scaler1"s).config<int64_t>("factor"s, 3);
+    topologyBuilder.component("test::Scaler"s, "scaler2"s).config<int64_t>("factor"s, 4).config<std::string>("name"s, "main"s);
+
+    Build build{topology};
+    const Scaler &scaler0 = dynamic_cast<const Scaler &>(build.get<ICounter>("scaler0"s));
+    const Scaler &scaler1 = dynamic_cast<const Scaler &>(build.get<ICounter>("scaler1"s));
+    const Scaler &scaler2 = dynamic_cast<const Scaler &>(build.get<ICounter>("scaler2"s));
+    EXPECT_EQ(&scaler0.shape(), &scaler1.shape());
+    EXPECT_NE(&scaler0.shape(), &scaler2.shape());
+
+    for (int i = 1; i <= 2; ++i) {
+        EXPECT_EQ(build.get<ICounter>("scaler0"s).next(), 2 * i);
+        EXPECT_EQ(build.get<ICounter>("scaler2"s).next(), 4 * i);
+        EXPECT_EQ(build.get<ICounter>("scaler1"s).next(), 3 * i);
+    }
+
+    EXPECT_EQ(scaler2.name().value(), "main"s);
+    EXPECT_EQ(scaler0.name().error().code(), ErrorCode::CONFIG_ENTRY_NOT_FOUND);
+    EXPECT_EQ(scaler0.name().error().message(), (ConfigEntryNotFound{"test::Scaler"s, "scaler0"s, "name"s}.error().message()));
+}
@@ -0,0 +1,22 @@
+#include <diff/FactoryDescriptor.h>
+#include <diff/FactoryRegisterer.h>
+
+using namespace diff;
+
+namespace test {
+
+class ModuleProbe : public Component<ModuleProbe> {
+public:
+    ModuleProbe() = default;
+};
+
+class ModuleGauge : public Component<ModuleGauge> {
+public:
+    ModuleGauge() = default;
+};
+
+FactoryRegisterer<ModuleProbe> moduleProbeFactoryRegisterer;
+
+}   // namespace test
+
+DIFF_REGISTER_FACTORY(test::ModuleGauge);
@@ -0,0 +1,110 @@
+#include <diff/Build.h>
+#include <diff/FactoryRegisterer.h>
+#include <diff/TopologyBuilder.h>
+#include <diff/TopologyLoader.h>
+#include <gtest/gtest.h>
+
+#if !defined(DIFF_NO_EXCEPTIONS)
+#error "test_no_exceptions shall be compiled with exceptions disabled."
+#endif
+
+using namespace diff;
+
+namespace test {
+
+class IValue {
+public:
+    virtual ~IValue() = default;
+    virtual int64_t value() = 0;
+};
+
+class Value : public Component<Value, as<IValue>> {
+public:
+    Value() : value_{config<int64_t>("value"s)} {}
+
+    int64_t value() override { return value_; }
+
+private:
+    const int64_t value_;
+};
+
+class Doubler : public Component<Doubler, as<IValue>> {
+public:
+    Doubler(IValue &value) : value_{value} {}
+
+    int64_t value() override { return 2 * value_.value(); }
+
+private:
+    IValue &value_;
+};
+
+FactoryRegisterer<Value> valueFactoryRegisterer;
+FactoryRegisterer<Doubler> doublerFactoryRegisterer;
+
+}   // namespace test
+
+using namespace test;
+
+TEST(TestNoExceptions, TryLoad) {
+    TopologyLoader topologyLoader{R"( [ { "type" : "test::Value", "id" : "value0", "config" : { "value" : { "uint8_t" : 256 } } } ] )"_json};
+    Topology topology;
+
+    const Result<> result = topologyLoader.tryLoad(topology);
+
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(result.error().message(),
+              "Component{#0, \"test::Value\" : \"value0\"} : Config{\"value\", uint8_t{256}} - Config entry value shall be in range of its declared type."s);
+}
+
+TEST(TestNoExceptions, TryLoadFileNotAccessible) {
+    TopologyLoader topologyLoader{"fake_path"s};
+    Topology topology;
+
+    const Result<> result = topologyLoader.tryLoad(topology);
+
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(result.error().message(), "Topology file not accessible. Path: \"fake_path\"."s);
+}
+
+TEST(TestNoExceptions, BuildCreate) {
+    TopologyLoader topologyLoader{R"( [ { "type" : "test::Value", "id" : "value0", "config" : { "value" : 7 } } ] )"_json};
+    Topology topology;
+    ASSERT_TRUE(topologyLoader.tryLoad(topology).ok());
+
+    Result<std::unique_ptr<Build>> result = Build::create(topology);
+
+    ASSERT_TRUE(result.ok());
+    EXPECT_EQ(result.value()->get<IValue>("value0"s).value(), 7);
+}
+
+TEST(TestNoExceptions, BuildCreateFactoryNotFound) {
+    Topology topology;
+    TopologyBuilder{topology}.component("Unknown"s, "unknown0"s);
+
+    const Result<std::unique_ptr<Build>> result = Build::create(topology);
+
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(result.error().code(), ErrorCode::FACTORY_NOT_FOUND);
+}
+
+TEST(TestNoExceptions, BuildCreateDependencyNotFound) {
+    Topology topology;
+    TopologyBuilder topologyBuilder{topology};
+    topologyBuilder.component("test::Value"s, "value0"s).config<int64_t>("value"s, 7);
+    topologyBuilder.component("test::Doubler"s, "doubler0"s).dependency("value1"s);
+
+    const Result<std::unique_ptr<Build>> result = Build::create(topology);
+
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(result.error().code(), ErrorCode::DEPENDENCY_NOT_FOUND);
+    EXPECT_EQ(result.error().entryIndex(), 1u);
+    EXPECT_EQ(result.error().message(), "Dependency test::IValue{} with id=\"value1\" not found."s);
+}
+
+TEST(TestNoExceptionsDeathTest, ErrorHandler) {
+    Topology topology;
+    TopologyBuilder{topology}.component("test::Value"s, "value0"s);
+
+    ErrorHandler::set([](const Error &error) { std::fprintf(stderr, "handled: %s\n", error.message().c_str()); });
+    EXPECT_DEATH(Build{topology}, "handled: Config entry \"value\" of component test::Value\\{\"value0\"\\} not found\\.");
+}
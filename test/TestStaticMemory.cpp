@@ -0,0 +1,220 @@
+#include <diff/Build.h>
+#include <diff/FactoryRegisterer.h>
+#include <diff/StaticMemory.h>
+#include <diff/TopologyBuilder.h>
+#include <gtest/gtest.h>
+
+#if !defined(DIFF_STATIC_MEMORY)
+#error "test_static_memory shall be compiled in static memory mode."
+#endif
+
+DIFF_STATIC_MEMORY_OPERATORS()
+
+using namespace diff;
+
+namespace test {
+
+class ISensor {
+public:
+    virtual ~ISensor() = default;
+    virtual int64_t read() = 0;
+};
+
+class Sensor : public Component<Sensor, as<ISensor>> {
+public:
+    Sensor() : offset_{config<int64_t>("offset"s)} {}
+
+    int64_t read() override { return offset_; }
+
+private:
+    const int64_t offset_;
+};
+
+class Filter : public Component<Filter, as<ISensor>> {
+public:
+    Filter(ISensor &sensor) : sensor_{sensor} {}
+
+    int64_t read() override { return 2 * sensor_.read(); }
+
+private:
+    ISensor &sensor_;
+};
+
+FactoryRegisterer<Sensor> sensorFactoryRegisterer;
+FactoryRegisterer<Filter> filterFactoryRegisterer;
+
+}   // namespace test
+
+using namespace test;
+
+namespace {
+
+Topology topology(std::size_t filters) {
+    Topology result;
+    TopologyBuilder topologyBuilder{result};
+    topologyBuilder.component("test::Sensor"s, "sensor"s).config<int64_t>("offset"s, 21);
+    for (std::size_t i = 0u; i < filters; ++i) {
+        topologyBuilder.component("test::Filter"s, "filter"s + std::to_string(i)).dependency((0u == i) ? "sensor"s : ("filter"s + std::to_string(i - 1u)));
+    }
+    return result;
+}
+
+/**
+ * @brief Return memory used once the structures the framework creates on first use (e.g. the factory lookup table) are in place - they take the
+ * static memory for good, since they are created within a build (or anywhere, in the exclusive mode).
+ */
+std::size_t settled() {
+    {
+        Topology sensors = topology(1u);
+        static_cast<void>(Build::create(sensors));
+    }
+    return StaticMemory::used();
+}
+
+}   // namespace
+
+TEST(TestStaticMemory, Build) {
+    Topology sensors = topology(1u);
+
+    const std::size_t before = StaticMemory::used();
+    const Result<std::unique_ptr<Build>> result = Build::create(sensors);
+    ASSERT_TRUE(result);
+    EXPECT_LT(before, StaticMemory::used());
+    EXPECT_EQ(result.value()->get<ISensor>("filter0"s).read(), 42);
+}
+
+TEST(TestStaticMemory, Reproducible) {
+    std::size_t used[2];
+    for (std::size_t &u : used) {
+        const std::size_t before = settled();
+        Topology sensors = topology(2u);
+        const Result<std::unique_ptr<Build>> result = Build::create(sensors);
+        ASSERT_TRUE(result);
+        u = StaticMemory::used() - before;
+    }
+    EXPECT_EQ(used[0], used[1]);
+}
+
+TEST(TestStaticMemory, CapacityExceeded) {
+    Topology sensors = topology(DIFF_STATIC_MAX_COMPONENTS);
+
+    const Result<std::unique_ptr<Build>> result = Build::create(sensors);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().code(), ErrorCode::CAPACITY_EXCEEDED);
+    EXPECT_EQ(result.error().message(), "Static capacity of components exceeded - 5 required, 4 available."s);
+    EXPECT_THROW(ErrorHandler::raise(result.error()), CapacityExceeded);
+}
+
+TEST(TestStaticMemory, StaticCapacity) {
+    const Topology sensors = topology(2u);
+    StaticCapacity staticCapacity;
+    EXPECT_TRUE(staticCapacity.check(sensors));
+
+    staticCapacity.dependencies = 1u;
+    EXPECT_EQ(staticCapacity.check(sensors).error().message(), "Static capacity of dependencies exceeded - 2 required, 1 available."s);
+
+    staticCapacity = StaticCapacity{};
+    staticCapacity.strings = 16u;
+    EXPECT_EQ(staticCapacity.check(sensors).error().argument(0u), "strings"s);
+
+    staticCapacity = StaticCapacity{};
+    staticCapacity.config = sizeof(int64_t) - 1u;
+    EXPECT_EQ(staticCapacity.check(sensors).error().message(), "Static capacity of config exceeded - 8 required, 7 available."s);
+}
+
+TEST(TestStaticMemory, Exhausted) {
+    EXPECT_EQ(StaticMemory::allocate(StaticMemory::capacity() + 1u), nullptr);
+    {
+        const StaticMemory::Scope scope;
+        EXPECT_EQ(new (std::nothrow) char[StaticMemory::capacity()], nullptr);
+    }
+    EXPECT_THROW(StaticMemory::acquire(StaticMemory::capacity()), std::bad_alloc);
+
+    const std::size_t before = StaticMemory::used();
+    void *const pMemory = StaticMemory::allocate(1u, 64u);
+    ASSERT_NE(pMemory, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(pMemory) % 64u, 0u);
+    EXPECT_LT(before, StaticMemory::used());
+    StaticMemory::deallocate(pMemory);
+    EXPECT_EQ(before, StaticMemory::used());
+}
+
+TEST(TestStaticMemory, Recycled) {
+    const std::size_t before = settled();
+    for (std::size_t i = 0u; i < 1000u; ++i) {   // Far more than the memory could take without reuse.
+        Topology sensors = topology(3u);
+        const Result<std::unique_ptr<Build>> result = Build::create(sensors);
+        ASSERT_TRUE(result);
+        EXPECT_EQ(result.value()->get<ISensor>("filter2"s).read(), 168);
+    }
+    EXPECT_EQ(before, StaticMemory::used());
+
+    void *const pFirst = StaticMemory::allocate(100u);
+    void *const pSecond = StaticMemory::allocate(100u);
+    StaticMemory::deallocate(pFirst);
+    void *const pThird = StaticMemory::allocate(50u);
+    EXPECT_LE(pThird, pFirst);   // First fit - freed block reused, unless there is a fitting one below.
+    StaticMemory::deallocate(pThird);
+    StaticMemory::deallocate(pSecond);
+    EXPECT_EQ(before, StaticMemory::used());
+}
+
+TEST(TestStaticMemory, Constructor) {
+    const std::size_t before = settled();
+    {
+        Topology sensors = topology(2u);
+        Build build{sensors};
+        EXPECT_LT(before, StaticMemory::used());
+        EXPECT_EQ(build.get<ISensor>("filter1"s).read(), 84);
+    }
+    EXPECT_EQ(before, StaticMemory::used());
+}
+
+#if defined(DIFF_STATIC_MEMORY_EXCLUSIVE)
+TEST(TestStaticMemory, Exclusive) {
+    const std::size_t before = StaticMemory::used();
+    {
+        const Topology sensors = topology(1u);
+        const std::unique_ptr<char[]> pMemory{new char[1024u]};
+        EXPECT_TRUE(StaticMemory::owns(pMemory.get()));
+        EXPECT_TRUE(StaticMemory::active());
+        EXPECT_LE(before + 1024u, StaticMemory::used());
+    }
+    EXPECT_EQ(before, StaticMemory::used());
+}
+#else
+TEST(TestStaticMemory, Scope) {
+    const std::size_t before = StaticMemory::used();
+    const std::unique_ptr<char[]> pHeap{new char[1024u]};
+    EXPECT_FALSE(StaticMemory::owns(pHeap.get()));
+    EXPECT_EQ(before, StaticMemory::used());
+
+    std::unique_ptr<char[]> pStatic;
+    {
+        const StaticMemory::Scope scope;
+        pStatic.reset(new char[1024u]);
+    }
+    EXPECT_TRUE(StaticMemory::owns(pStatic.get()));
+    EXPECT_LE(before + 1024u, StaticMemory::used());
+    pStatic.reset();
+    EXPECT_EQ(before, StaticMemory::used());
+}
+#endif
+
+TEST(TestStaticMemory, MemoryCapacity) {
+    Topology sensors = topology(3u);
+    StaticCapacity staticCapacity;
+    staticCapacity.memory = 64u;
+    const Result<> result = staticCapacity.check(sensors);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().argument(0u), "memory"s);
+    const std::size_t required = std::stoul(result.error().argument(2u));
+
+    const std::size_t before = settled();
+    {
+        const Result<std::unique_ptr<Build>> build = Build::create(sensors);
+        ASSERT_TRUE(build);
+        EXPECT_LE(StaticMemory::used() - before, required);   // Estimate covers what the build takes, without overstating it much.
+        EXPECT_LT(required, 3u * (StaticMemory::used() - before));
+    }
+}
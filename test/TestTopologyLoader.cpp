@@ -1,8 +1,19 @@
 #include <diff/TopologyLoader.h>
 #include <gtest/gtest.h>
+#include <fstream>
 
 using namespace diff;
 
+namespace {
+
+std::string writeFile(const std::string &name, const std::string &content) {
+    const std::string path = testing::TempDir() + name;
+    std::ofstream{path} << content;
+    return path;
+}
+
+}   // namespace
+
 TEST(TestTopologyLoader, NonExistentFile) {
     EXPECT_THROW(
         try { TopologyLoader{"fake_path"s}; } catch (const TopologyLoaderException &e) {
@@ -12,6 +23,51 @@ TEST(TestTopologyLoader, NonExistentFile) {
         TopologyLoaderException);
 }
 
+TEST(TestTopologyLoader, TryLoad) {
+    TopologyLoader topologyLoader{R"( [ { "type" : "type0", "id" : "id0", "dependencies" : [ 123 ] } ] )"_json};
+    Topology topology;
+
+    const Result<> result = topologyLoader.tryLoad(topology);
+
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(result.error().code(), ErrorCode::DEPENDENCY_NOT_A_STRING);
+    EXPECT_EQ(result.error().message(), "Component{#0, \"type0\" : \"id0\"} : Dependency{#0} - Dependency type shall be a string."s);
+}
+
+TEST(TestTopologyLoader, TryLoadStructuredError) {
+    TopologyLoader topologyLoader{R"(
+    [
+        { "type" : "type0", "id" : "id0" },
+        { "type" : "type1", "id" : "id1", "config" : { "key" : { "int8_t" : 128 } } }
+    ]
+    )"_json};
+    Topology topology;
+
+    const Result<> result = topologyLoader.tryLoad(topology);
+
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(result.error().code(), ErrorCode::CONFIG_ENTRY_OUT_OF_RANGE);
+    EXPECT_EQ(result.error().entryIndex(), 1u);
+    EXPECT_EQ(result.error().argument(0u), "type1"s);
+    EXPECT_EQ(result.error().argument(1u), "id1"s);
+    EXPECT_EQ(result.error().argument(2u), "key"s);
+    EXPECT_EQ(result.error().argument(3u), "int8_t"s);
+    EXPECT_EQ(result.error().argument(4u), "128"s);
+    EXPECT_EQ(result.error().message(),
+              "Component{#1, \"type1\" : \"id1\"} : Config{\"key\", int8_t{128}} - Config entry value shall be in range of its declared type."s);
+}
+
+TEST(TestTopologyLoader, TryLoadComponentIdDuplicated) {
+    TopologyLoader topologyLoader{R"( [ { "type" : "type0", "id" : "id0" }, { "type" : "type1", "id" : "id0" } ] )"_json};
+    Topology topology;
+
+    const Result<> result = topologyLoader.tryLoad(topology);
+
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(result.error().code(), ErrorCode::COMPONENT_ID_DUPLICATED);
+    EXPECT_THROW(topologyLoader.load(topology), ComponentIdDuplicated);
+}
+
 TEST(TestTopologyLoader, TopologyNotAnArray) {
     TopologyLoader topologyLoader{R"( { "object": 123 } )"_json};
     Topology topology;
@@ -331,4 +387,272 @@ TEST(TestTopologyLoader, NoException) {
     EXPECT_EQ(configCheckTypeAndGetValue<uint8_t>(topology[3].config, "key1"s), 255u);
     EXPECT_EQ(configCheckTypeAndGetValue<std::string>(topology[3].config, "key2"s), "stringValue"s);
     EXPECT_EQ(configCheckTypeAndGetValue<int64_t>(topology[3].config, "key3"s), -1);
-}
\ No newline at end of file
+}
+TEST(TestTopologyLoader, Template) {
+    TopologyLoader topologyLoader{R"(
+    [
+        { "type" : "type0", "id" : "id0" },
+        {
+            "template" : "card",
+            "parameters" : [ "card", "port" ],
+            "components" : [
+                { "type" : "type1", "id" : "${card}_phy", "dependencies" : [ "id0" ], "config" : { "port" : "${port}", "mode" : "fast" } },
+                { "type" : "type2", "id" : "${card}_link", "dependencies" : [ "${card}_phy" ], "config" : { "name" : "link_${card}:${port}" } }
+            ]
+        },
+        { "instantiate" : "card", "arguments" : { "card" : "card0", "port" : { "uint16_t" : 7 } } },
+        { "instantiate" : "card", "arguments" : { "card" : "card1", "port" : 8 } }
+    ]
+    )"_json};
+    Topology topology;
+
+    topologyLoader.load(topology);
+
+    ASSERT_EQ(topology.size(), 5u);
+    EXPECT_EQ(topology[1].type, "type1"s);
+    EXPECT_EQ(topology[1].id, "card0_phy"s);
+    EXPECT_EQ(topology[1].dependencyIds, (DependencyIds{"id0"s}));
+    EXPECT_EQ(configCheckTypeAndGetValue<uint16_t>(topology[1].config, "port"s), 7u);
+    EXPECT_EQ(configCheckTypeAndGetValue<std::string>(topology[1].config, "mode"s), "fast"s);
+    EXPECT_EQ(topology[2].id, "card0_link"s);
+    EXPECT_EQ(topology[2].dependencyIds, (DependencyIds{"card0_phy"s}));
+    EXPECT_EQ(configCheckTypeAndGetValue<std::string>(topology[2].config, "name"s), "link_card0:7"s);
+    EXPECT_EQ(topology[3].id, "card1_phy"s);
+    EXPECT_EQ(configCheckTypeAndGetValue<uint64_t>(topology[3].config, "port"s), 8u);
+    EXPECT_EQ(topology[4].dependencyIds, (DependencyIds{"card1_phy"s}));
+}
+
+TEST(TestTopologyLoader, TemplateParameterUnknown) {
+    TopologyLoader topologyLoader{R"(
+    [
+        { "template" : "card", "parameters" : [ "card" ], "components" : [ { "type" : "type0", "id" : "${slot}_phy" } ] }
+    ]
+    )"_json};
+    Topology topology;
+
+    EXPECT_THROW(
+        try { topologyLoader.load(topology); } catch (const TopologyLoaderException &e) {
+            EXPECT_STREQ("Component{#0} : Template{\"card\"} - Parameter \"slot\" shall be declared.", e.what());
+            throw;
+        },
+        TopologyLoaderException);
+}
+
+TEST(TestTopologyLoader, TemplateArgumentMissing) {
+    TopologyLoader topologyLoader{R"(
+    [
+        { "template" : "card", "parameters" : [ "card" ], "components" : [ { "type" : "type0", "id" : "${card}_phy" } ] },
+        { "instantiate" : "card", "arguments" : { } }
+    ]
+    )"_json};
+    Topology topology;
+
+    const Result<> result = topologyLoader.tryLoad(topology);
+
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(result.error().code(), ErrorCode::TEMPLATE_ARGUMENT_MISSING);
+    EXPECT_EQ(result.error().message(), "Component{#1} : Template{\"card\"} - Argument \"card\" shall be given."s);
+}
+
+TEST(TestTopologyLoader, TemplateNotFound) {
+    TopologyLoader topologyLoader{R"( [ { "instantiate" : "card" } ] )"_json};
+    Topology topology;
+
+    const Result<> result = topologyLoader.tryLoad(topology);
+
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(result.error().code(), ErrorCode::TEMPLATE_NOT_FOUND);
+}
+
+TEST(TestTopologyLoader, TemplateComponentIdDuplicated) {
+    TopologyLoader topologyLoader{R"(
+    [
+        { "template" : "card", "parameters" : [ "card" ], "components" : [ { "type" : "type0", "id" : "${card}_phy" } ] },
+        { "instantiate" : "card", "arguments" : { "card" : "card0" } },
+        { "instantiate" : "card", "arguments" : { "card" : "card0" } }
+    ]
+    )"_json};
+    Topology topology;
+
+    const Result<> result = topologyLoader.tryLoad(topology);
+
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(result.error().code(), ErrorCode::COMPONENT_ID_DUPLICATED);
+    EXPECT_EQ(result.error().entryIndex(), 2u);
+    EXPECT_EQ(result.error().argument(1u), "card0_phy"s);
+}
+
+TEST(TestTopologyLoader, Include) {
+    writeFile("TestTopologyLoader_board.json"s, R"(
+    [
+        { "type" : "type0", "id" : "id0" },
+        { "type" : "type1", "id" : "id1", "dependencies" : [ "id0" ], "config" : { "port" : 1, "mode" : "fast" } }
+    ]
+    )"s);
+    const std::string path = writeFile("TestTopologyLoader_system.json"s, R"(
+    [
+        { "include" : "TestTopologyLoader_board.json" },
+        { "type" : "type2", "id" : "id2", "dependencies" : [ "id1" ] },
+        { "overlay" : "id1", "dependencies" : [ ], "config" : { "port" : { "uint16_t" : 2 } } },
+        { "overlay" : "id2", "type" : "type3" }
+    ]
+    )"s);
+    TopologyLoader topologyLoader{path};
+    Topology topology;
+
+    topologyLoader.load(topology);
+
+    ASSERT_EQ(topology.size(), 3u);
+    EXPECT_EQ(topology[1].id, "id1"s);
+    EXPECT_EQ(topology[1].type, "type1"s);
+    EXPECT_TRUE(topology[1].dependencyIds.empty());
+    EXPECT_EQ(configCheckTypeAndGetValue<uint16_t>(topology[1].config, "port"s), 2u);
+    EXPECT_EQ(configCheckTypeAndGetValue<std::string>(topology[1].config, "mode"s), "fast"s);
+    EXPECT_EQ(topology[2].type, "type3"s);
+    EXPECT_EQ(topology[2].dependencyIds, (DependencyIds{"id1"s}));
+}
+
+TEST(TestTopologyLoader, IncludeMultipleFiles) {
+    const std::string base = writeFile("TestTopologyLoader_base.json"s, R"( [ { "type" : "type0", "id" : "id0", "config" : { "port" : 1 } } ] )"s);
+    const std::string overlay = writeFile("TestTopologyLoader_overlay.json"s, R"( [ { "overlay" : "id0", "config" : { "port" : 2 } } ] )"s);
+    TopologyLoader topologyLoader{std::vector<std::string>{base, overlay}};
+    Topology topology;
+
+    topologyLoader.load(topology);
+
+    ASSERT_EQ(topology.size(), 1u);
+    EXPECT_EQ(configCheckTypeAndGetValue<uint64_t>(topology[0].config, "port"s), 2u);
+}
+
+TEST(TestTopologyLoader, IncludeCycle) {
+    writeFile("TestTopologyLoader_cycle0.json"s, R"( [ { "type" : "type0", "id" : "id0" }, { "include" : "TestTopologyLoader_cycle1.json" } ] )"s);
+    const std::string path = writeFile("TestTopologyLoader_cycle1.json"s, R"( [ { "include" : "TestTopologyLoader_cycle0.json" } ] )"s);
+    TopologyLoader topologyLoader{path};
+    Topology topology;
+
+    const Result<> result = topologyLoader.tryLoad(topology);
+
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(result.error().code(), ErrorCode::INCLUDE_CYCLE);
+    EXPECT_EQ(result.error().entryIndex(), 1u);
+    EXPECT_EQ(result.error().argument(0u), path);
+}
+
+TEST(TestTopologyLoader, IncludeDiamond) {
+    writeFile("TestTopologyLoader_shared.json"s, R"( [ { "type" : "type0", "id" : "id0" } ] )"s);
+    writeFile("TestTopologyLoader_left.json"s, R"( [ { "include" : "TestTopologyLoader_shared.json" }, { "type" : "type1", "id" : "id1" } ] )"s);
+    writeFile("TestTopologyLoader_right.json"s, R"( [ { "include" : "TestTopologyLoader_shared.json" }, { "type" : "type2", "id" : "id2" } ] )"s);
+    const std::string path = writeFile("TestTopologyLoader_diamond.json"s, R"(
+    [
+        { "include" : "TestTopologyLoader_left.json" },
+        { "include" : "TestTopologyLoader_right.json" }
+    ]
+    )"s);
+    TopologyLoader topologyLoader{path};
+    Topology topology;
+
+    topologyLoader.load(topology);
+
+    ASSERT_EQ(topology.size(), 3u);
+    EXPECT_EQ(topology[0].id, "id0"s);
+    EXPECT_EQ(topology[1].id, "id1"s);
+    EXPECT_EQ(topology[2].id, "id2"s);
+    EXPECT_EQ(topologyLoader.files().size(), 4u);
+}
+
+TEST(TestTopologyLoader, IncludedFileError) {
+    const std::string included = writeFile("TestTopologyLoader_invalid.json"s, R"( [ { "type" : "type0", "id" : "id0" }, { "type" : "type1" } ] )"s);
+    const std::string path = writeFile("TestTopologyLoader_including.json"s, R"( [ { "include" : "TestTopologyLoader_invalid.json" } ] )"s);
+    TopologyLoader topologyLoader{path};
+    Topology topology;
+
+    const Result<> result = topologyLoader.tryLoad(topology);
+
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(result.error().code(), ErrorCode::COMPONENT_ID_MISSING);
+    EXPECT_EQ(result.error().entryIndex(), 1u);
+    EXPECT_EQ(result.error().path(), included);
+    EXPECT_EQ(result.error().message(), "File{\""s + included + "\"} : Component{#1} - Component id shall be specified."s);
+}
+
+TEST(TestTopologyLoader, IncludeNonExistentFile) {
+    TopologyLoader topologyLoader{R"( [ { "include" : "fake_path" } ] )"_json};
+    Topology topology;
+
+    EXPECT_THROW(
+        try { topologyLoader.load(topology); } catch (const TopologyLoaderException &e) {
+            EXPECT_STREQ("Topology file not accessible. Path: \"fake_path\".", e.what());
+            throw;
+        },
+        TopologyLoaderException);
+}
+
+TEST(TestTopologyLoader, OverlayTargetNotFound) {
+    TopologyLoader topologyLoader{R"( [ { "overlay" : "id0", "config" : { "port" : 2 } }, { "type" : "type0", "id" : "id0" } ] )"_json};
+    Topology topology;
+
+    EXPECT_THROW(
+        try { topologyLoader.load(topology); } catch (const TopologyLoaderException &e) {
+            EXPECT_STREQ("Component{#0} : Overlay{\"id0\"} - Component shall be defined before its overlay.", e.what());
+            throw;
+        },
+        TopologyLoaderException);
+}
+
+TEST(TestTopologyLoader, Hash) {
+    const std::string path = writeFile("TestTopologyLoader_hash.json"s, R"( [ { "type" : "type0", "id" : "id0" } ] )"s);
+    const Sha256::Digest hash = TopologyLoader{path}.hash();
+
+    EXPECT_EQ(TopologyLoader{path}.hash(), hash);
+    writeFile("TestTopologyLoader_hash.json"s, R"( [ { "type" : "type0", "id" : "id1" } ] )"s);
+    EXPECT_NE(TopologyLoader{path}.hash(), hash);
+}
+
+TEST(TestTopologyLoader, Variables) {
+    TopologyLoader topologyLoader{R"(
+    [
+        { "variables" : { "broker" : "tcp://10.0.0.1:1883", "bufferSize" : { "uint32_t" : 65536 } } },
+        { "type" : "type0", "id" : "id0", "config" : { "address" : { "variable" : "broker" }, "size" : { "variable" : "bufferSize" } } },
+        { "template" : "client", "parameters" : [ "id", "address" ], "components" : [
+            { "type" : "type1", "id" : "${id}", "config" : { "address" : "${address}", "size" : { "variable" : "bufferSize" } } } ] },
+        { "instantiate" : "client", "arguments" : { "id" : "id1", "address" : { "variable" : "broker" } } }
+    ]
+    )"_json};
+    Topology topology;
+
+    topologyLoader.load(topology);
+
+    ASSERT_EQ(topology.size(), 2u);
+    EXPECT_EQ(configCheckTypeAndGetValue<std::string>(topology[0].config, "address"s), "tcp://10.0.0.1:1883"s);
+    EXPECT_EQ(configCheckTypeAndGetValue<uint32_t>(topology[0].config, "size"s), 65536u);
+    EXPECT_EQ(configCheckTypeAndGetValue<std::string>(topology[1].config, "address"s), "tcp://10.0.0.1:1883"s);
+    EXPECT_EQ(configCheckTypeAndGetValue<uint32_t>(topology[1].config, "size"s), 65536u);
+
+    // Parsed once - all the entries refer to the very same value.
+    const auto value = [&topology](std::size_t index, const std::string &key) { return &(*topology[index].config.find(key))->value<std::string>(); };
+    EXPECT_EQ(value(0u, "address"s), value(1u, "address"s));
+}
+
+TEST(TestTopologyLoader, VariableNotFound) {
+    TopologyLoader topologyLoader{R"( [ { "type" : "type0", "id" : "id0", "config" : { "address" : { "variable" : "broker" } } } ] )"_json};
+    Topology topology;
+
+    EXPECT_THROW(
+        try { topologyLoader.load(topology); } catch (const TopologyLoaderException &e) {
+            EXPECT_STREQ("Component{#0, \"type0\" : \"id0\"} : Config{\"address\"} : Variable{\"broker\"} - Variable shall be defined before its use.",
+                         e.what());
+            throw;
+        },
+        TopologyLoaderException);
+}
+
+TEST(TestTopologyLoader, VariableDuplicated) {
+    TopologyLoader topologyLoader{R"( [ { "variables" : { "broker" : "a" } }, { "variables" : { "broker" : "b" } } ] )"_json};
+    Topology topology;
+
+    const Result<> result = topologyLoader.tryLoad(topology);
+
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(result.error().code(), ErrorCode::VARIABLE_DUPLICATED);
+    EXPECT_EQ(result.error().message(), "Component{#1} : Variable{\"broker\"} - Variable name shall be unique."s);
+}
@@ -0,0 +1,256 @@
+#include <diff/TopologyParser.h>
+#include <gtest/gtest.h>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+using namespace diff;
+
+namespace {
+
+template <typename T>
+const T &configCheckTypeAndGetValue(const Config &config, const std::string &key) {
+    const auto it = config.find(key);
+    EXPECT_NE(config.cend(), it);
+    EXPECT_EQ(Demangler::of<T>(), (*it)->type());
+    return (*it)->value<T>();
+}
+
+// The reference - Json value tree loaded with TopologyLoader.
+Result<> referenceLoad(const std::string &text, Topology &topology) {
+    nlohmann::json json;
+    try {
+        json = nlohmann::json::parse(text, nullptr, true, true);
+    } catch (const nlohmann::json::parse_error &e) {
+        return Error{ErrorCode::TOPOLOGY_SYNTAX_ERROR, e.what()};
+    }
+    return TopologyLoader{json}.tryLoad(topology);
+}
+
+void expectEqual(const Topology &topology, const Topology &expected, const std::string &text) {
+    ASSERT_EQ(topology.size(), expected.size()) << text;
+    for (std::size_t i = 0u; i < topology.size(); ++i) {
+        EXPECT_EQ(topology[i].type, expected[i].type) << text;
+        EXPECT_EQ(topology[i].id, expected[i].id) << text;
+        EXPECT_EQ(topology[i].dependencyIds, expected[i].dependencyIds) << text;
+        ASSERT_EQ(topology[i].config.size(), expected[i].config.size()) << text;
+        for (auto it = topology[i].config.cbegin(), expectedIt = expected[i].config.cbegin(); it != topology[i].config.cend(); ++it, ++expectedIt) {
+            EXPECT_EQ((*it)->key(), (*expectedIt)->key()) << text;
+            EXPECT_EQ((*it)->type(), (*expectedIt)->type()) << text;
+            EXPECT_EQ((*it)->toString(), (*expectedIt)->toString()) << text;
+        }
+    }
+}
+
+// Both accept the same topologies, loaded the same way, and report the same failures.
+void expectSameAsReference(const std::string &text) {
+    Topology expected;
+    const Result<> expectedResult = referenceLoad(text, expected);
+
+    Topology topology;
+    const Result<> result = TopologyParser::tryLoad(text, topology);
+    ASSERT_EQ(result.ok(), expectedResult.ok()) << text;
+    if (result.ok()) {
+        expectEqual(topology, expected, text);
+    } else {
+        EXPECT_EQ(result.error().code(), expectedResult.error().code()) << text;
+        EXPECT_EQ(result.error().message(), expectedResult.error().message()) << text;
+    }
+
+    Topology parsed;
+    if (TopologyParser::tryParse(text, parsed)) {
+        ASSERT_TRUE(expectedResult.ok()) << text;
+        expectEqual(parsed, expected, text);
+    }
+}
+
+// Json literals of the TestTopologyLoader cases (R"(...)"_json), in order of appearance.
+std::vector<std::string> topologyLoaderCases() {
+    std::ifstream file{DIFF_TEST_TOPOLOGY_LOADER_CASES};
+    const std::string source{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    const std::string open = "R\"("s;
+    const std::string close = ")\"_json"s;
+
+    std::vector<std::string> result;
+    for (std::size_t end = source.find(close); std::string::npos != end; end = source.find(close, end + close.size())) {
+        const std::size_t begin = source.rfind(open, end) + open.size();
+        result.emplace_back(source.substr(begin, end - begin));
+    }
+    return result;
+}
+
+class Generator final {
+public:
+    Generator(unsigned seed) : random_{seed} {}
+
+    std::string topology() {
+        std::string result = whitespace() + "[";
+        const std::size_t size = number(0u, 6u);
+        for (std::size_t i = 0u; i < size; ++i) {
+            result += ((0u < i) ? "," : "") + whitespace() + component(i) + whitespace();
+        }
+        return result + "]" + whitespace();
+    }
+
+    std::string mutate(std::string text) {
+        static const std::string characters = "\"{}[],:-019 \\tfue.\x01\xc3";
+        const std::size_t mutations = number(1u, 3u);
+        for (std::size_t i = 0u; (i < mutations) && !text.empty(); ++i) {
+            const std::size_t position = number(0u, text.size() - 1u);
+            const char c = characters[number(0u, characters.size() - 1u)];
+            switch (number(0u, 2u)) {
+                case 0u:
+                    text[position] = c;
+                    break;
+                case 1u:
+                    text.insert(position, 1u, c);
+                    break;
+                default:
+                    text.erase(position, 1u);
+                    break;
+            }
+        }
+        return text;
+    }
+
+private:
+    std::string component(std::size_t index) {
+        std::vector<std::string> members;
+        members.emplace_back("\"type\"" + whitespace() + ":" + whitespace() + string("type"));
+        members.emplace_back("\"id\"" + whitespace() + ":" + whitespace() + string("id" + std::to_string(chance(10u) ? 0u : index)));
+        if (chance(2u)) {
+            std::string dependencies = "[";
+            const std::size_t size = number(0u, 3u);
+            for (std::size_t i = 0u; i < size; ++i) {
+                dependencies += ((0u < i) ? "," : "") + whitespace() + string("id" + std::to_string(number(0u, 5u)));
+            }
+            members.emplace_back("\"dependencies\"" + whitespace() + ":" + whitespace() + dependencies + whitespace() + "]");
+        }
+        if (chance(2u)) {
+            std::string config = "{";
+            const std::size_t size = number(0u, 4u);
+            for (std::size_t i = 0u; i < size; ++i) {
+                config += ((0u < i) ? "," : "") + whitespace() + string("key" + std::to_string(number(0u, 5u))) + whitespace() + ":" + whitespace() + value();
+            }
+            members.emplace_back("\"config\"" + whitespace() + ":" + whitespace() + config + whitespace() + "}");
+        }
+        std::shuffle(members.begin(), members.end(), random_);
+
+        std::string result = "{";
+        for (std::size_t i = 0u; i < members.size(); ++i) {
+            result += ((0u < i) ? "," : "") + whitespace() + members[i] + whitespace();
+        }
+        return result + "}";
+    }
+
+    std::string value() {
+        static const std::vector<std::string> types = {"uint8_t", "uint16_t", "uint32_t", "uint64_t", "int8_t", "int16_t", "int32_t", "int64_t"};
+        static const std::vector<std::string> integers = {"0", "-0", "1", "-1", "127", "128", "-128", "-129", "255", "256", "65535", "-32769",
+                                                          "4294967295", "4294967296", "9223372036854775807", "-9223372036854775808",
+                                                          "9223372036854775808", "18446744073709551615", "18446744073709551616", "1.5", "1e3", "01"};
+        switch (number(0u, 4u)) {
+            case 0u:
+                return chance(2u) ? "true" : "false";
+            case 1u:
+                return string("value");
+            case 2u:
+                return integers[number(0u, integers.size() - 1u)];
+            default:
+                return "{" + whitespace() + "\"" + types[number(0u, types.size() - 1u)] + "\"" + whitespace() + ":" + whitespace() +
+                       integers[number(0u, integers.size() - 1u)] + whitespace() + "}";
+        }
+    }
+
+    // Long runs of plain characters and whitespace, spanning multiple scanned blocks.
+    std::string string(const std::string &prefix) {
+        static const std::vector<std::string> pieces = {"abcdefghijklmnopqrstuvwxyz0123456789", "\\\"", "\\\\", "\\/", "\\n", "\\t", "\\u0041", "\xc3\xa9", "_"};
+        std::string result = "\"" + prefix;
+        const std::size_t size = chance(3u) ? number(0u, 6u) : 0u;
+        for (std::size_t i = 0u; i < size; ++i) {
+            result += pieces[chance(4u) ? number(0u, pieces.size() - 1u) : 0u];
+        }
+        return result + "\"";
+    }
+
+    std::string whitespace() { return chance(2u) ? ""s : std::string(number(0u, 40u), " \t\n\r"[number(0u, 3u)]); }
+
+    bool chance(std::size_t n) { return 0u == number(0u, n - 1u); }
+
+    std::size_t number(std::size_t min, std::size_t max) { return std::uniform_int_distribution<std::size_t>{min, max}(random_); }
+
+    std::mt19937 random_;
+};
+
+}   // namespace
+
+TEST(TestTopologyParser, Parse) {
+    const std::string text = R"(
+    [
+        { "type" : "type0", "id" : "id0", "config" : { "b" : true, "u" : 7, "i" : -7, "s" : "a\"b\\c\/d\n", "t" : { "int16_t" : -32768 } } },
+        { "id" : "id1", "dependencies" : [ "id0", "id0_side" ], "type" : "type1" },
+        { "type" : "type2", "id" : "id2", "dependencies" : [ ], "config" : { } }
+    ]
+    )";
+    Topology topology;
+
+    ASSERT_TRUE(TopologyParser::tryParse(text, topology));
+
+    ASSERT_EQ(topology.size(), 3u);
+    EXPECT_EQ(configCheckTypeAndGetValue<bool>(topology[0].config, "b"s), true);
+    EXPECT_EQ(configCheckTypeAndGetValue<uint64_t>(topology[0].config, "u"s), 7u);
+    EXPECT_EQ(configCheckTypeAndGetValue<int64_t>(topology[0].config, "i"s), -7);
+    EXPECT_EQ(configCheckTypeAndGetValue<std::string>(topology[0].config, "s"s), "a\"b\\c/d\n"s);
+    EXPECT_EQ(configCheckTypeAndGetValue<int16_t>(topology[0].config, "t"s), -32768);
+    EXPECT_EQ(topology[1].type, "type1"s);
+    EXPECT_EQ(topology[1].dependencyIds, (DependencyIds{"id0"s, "id0_side"s}));
+    EXPECT_TRUE(topology[2].dependencyIds.empty());
+    expectSameAsReference(text);
+}
+
+TEST(TestTopologyParser, HandOver) {
+    const std::vector<std::string> texts = {
+        R"( [ { "template" : "card", "parameters" : [ "card" ], "components" : [ { "type" : "t", "id" : "${card}" } ] },
+              { "instantiate" : "card", "arguments" : { "card" : "card0" } } ] )",
+        R"( [ { "variables" : { "v" : 1 } }, { "type" : "t", "id" : "id0", "config" : { "k" : { "variable" : "v" } } } ] )",
+        R"( [ { "type" : "t", "id" : "id0", "comment" : "unknown keys are ignored" } ] )",
+        R"( [ /* comment */ { "type" : "t", "id" : "id0" } ] )",
+        R"( [ { "type" : "t", "id" : "\u0069d0" } ] )",
+        "[ { \"type\" : \"t\", \"id\" : \"\xc3\xa9\" } ]"};
+
+    for (const std::string &text : texts) {
+        Topology topology;
+        EXPECT_FALSE(TopologyParser::tryParse(text, topology)) << text;
+        expectSameAsReference(text);
+    }
+}
+
+TEST(TestTopologyParser, SameFailures) {
+    const std::vector<std::string> cases = topologyLoaderCases();
+    ASSERT_FALSE(cases.empty());
+    for (const std::string &text : cases) {
+        expectSameAsReference(nlohmann::json::parse(text).dump());
+    }
+
+    // Failures no Json value dumps to.
+    const std::vector<std::string> texts = {R"( [ { "type" : "type0", "id" : "id0" }, )",
+                                            R"( [ { "type" : "type0", "id" : "id0", "type" : "type1" } ] )"};
+    for (const std::string &text : texts) {
+        expectSameAsReference(text);
+    }
+}
+
+TEST(TestTopologyParser, Differential) {
+    Generator generator{20250407u};
+    std::size_t parsed = 0u;
+
+    for (std::size_t i = 0u; i < 5000u; ++i) {
+        const std::string valid = generator.topology();
+        const std::string text = (0u == i % 2u) ? valid : generator.mutate(valid);
+        expectSameAsReference(text);
+
+        Topology topology;
+        parsed += TopologyParser::tryParse(text, topology) ? 1u : 0u;
+    }
+
+    EXPECT_GT(parsed, 1000u);   // The fast path is not just handing everything over.
+}
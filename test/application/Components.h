@@ -0,0 +1,38 @@
+#pragma once
+
+#include <diff/Component.h>
+
+namespace application {
+
+class IGenerator {
+public:
+    virtual ~IGenerator() = default;
+    virtual int generate() = 0;
+};
+
+class Generator : public diff::Component<Generator, diff::as<IGenerator>> {
+public:
+    Generator() = default;
+
+    int generate() override { return ++value_; }
+
+private:
+    int value_ = 0;
+};
+
+class Doubler : public diff::Component<Doubler, diff::as<IGenerator>> {
+public:
+    Doubler(IGenerator &generator) : generator_{generator} {}
+
+    int generate() override { return 2 * generator_.generate(); }
+
+private:
+    IGenerator &generator_;
+};
+
+class Unused : public diff::Component<Unused> {
+public:
+    Unused() = default;
+};
+
+}   // namespace application